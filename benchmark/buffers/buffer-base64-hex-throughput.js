@@ -0,0 +1,35 @@
+'use strict';
+const common = require('../common.js');
+
+// Reports the throughput in GB/s of binary data, for encoding a buffer with
+// buf.toString() and for decoding the string with Buffer.from().
+const bench = common.createBenchmark(main, {
+  encoding: ['base64', 'base64-urlsafe', 'hex'],
+  op: ['encode', 'decode'],
+  len: [64, 1024, 64 * 1024, 16 * 1024 * 1024],
+  total: [1024 * 1024 * 1024]
+});
+
+function main(conf) {
+  const len = +conf.len;
+  const n = Math.max(1, Math.floor(conf.total / len));
+  const encoding = conf.encoding === 'hex' ? 'hex' : 'base64';
+  const buf = Buffer.alloc(len);
+  for (var i = 0; i < len; i++)
+    buf[i] = (i * 7) & 0xff;
+
+  let str = buf.toString(encoding);
+  if (conf.encoding === 'base64-urlsafe')
+    str = str.replace(/\+/g, '-').replace(/\//g, '_').replace(/=+$/, '');
+
+  if (conf.op === 'encode') {
+    bench.start();
+    for (i = 0; i < n; i++)
+      buf.toString(encoding);
+  } else {
+    bench.start();
+    for (i = 0; i < n; i++)
+      Buffer.from(str, encoding);
+  }
+  bench.end(n * len / (1024 * 1024 * 1024));
+}
@@ -0,0 +1,30 @@
+'use strict';
+
+const common = require('../common.js');
+const { isUtf8 } = require('buffer');
+
+const chars = {
+  ascii: 'a',
+  latin1: 'ä',
+  cjk: '中',
+  emoji: '\u{1F600}'
+};
+
+// Reports the throughput in GB/s.
+const bench = common.createBenchmark(main, {
+  content: Object.keys(chars),
+  len: [64, 1024, 1024 * 1024],
+  total: [1024 * 1024 * 1024]
+});
+
+function main(conf) {
+  const char = Buffer.from(chars[conf.content]);
+  const count = Math.max(1, Math.floor(conf.len / char.length));
+  const buf = Buffer.alloc(count * char.length, char);
+  const n = Math.max(1, Math.floor(conf.total / buf.length));
+
+  bench.start();
+  for (var i = 0; i < n; i++)
+    isUtf8(buf);
+  bench.end(n * buf.length / (1024 * 1024 * 1024));
+}
@@ -5,7 +5,7 @@ const common = require('../common.js');
 const bench = common.createBenchmark(main, {
   encoding: ['', 'utf8', 'ascii', 'latin1', 'binary', 'hex', 'UCS-2'],
   args: [0, 1, 2, 3],
-  len: [0, 1, 64, 1024],
+  len: [0, 1, 64, 1024, 64 * 1024, 1024 * 1024],
   n: [1e7]
 });
 
@@ -13,7 +13,8 @@ function main(conf) {
   var encoding = conf.encoding;
   const args = conf.args | 0;
   const len = conf.len | 0;
-  const n = conf.n | 0;
+  // Keep the amount of data the same for lengths above 1 KiB.
+  const n = Math.ceil((conf.n | 0) / Math.max(1, len / 1024));
   const buf = Buffer.alloc(len, 42);
 
   if (encoding.length === 0)
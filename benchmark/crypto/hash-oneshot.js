@@ -0,0 +1,65 @@
+// Digests of many small inputs: createHash() per input compared to the
+// one-shot crypto.hash() and to crypto.hashBatch(), synchronous and on the
+// threadpool.
+'use strict';
+const common = require('../common.js');
+const crypto = require('crypto');
+
+const bench = common.createBenchmark(main, {
+  algo: ['sha256', 'md5'],
+  type: ['str', 'buf'],
+  len: [16, 256],
+  method: ['createHash', 'hash', 'hashBatch', 'hashBatchAsync'],
+  batch: [1000],
+  n: [1000]
+});
+
+function main(conf) {
+  const algo = conf.algo;
+  const batch = +conf.batch;
+  const n = +conf.n;
+  const len = +conf.len;
+
+  const inputs = [];
+  for (var i = 0; i < batch; i++) {
+    const str = `${i}`.padStart(len, 'k');
+    inputs.push(conf.type === 'str' ? str : Buffer.from(str));
+  }
+
+  var j;
+  switch (conf.method) {
+    case 'createHash':
+      bench.start();
+      for (i = 0; i < n; i++) {
+        for (j = 0; j < batch; j++)
+          crypto.createHash(algo).update(inputs[j]).digest();
+      }
+      bench.end(n * batch);
+      break;
+    case 'hash':
+      bench.start();
+      for (i = 0; i < n; i++) {
+        for (j = 0; j < batch; j++)
+          crypto.hash(algo, inputs[j], 'buffer');
+      }
+      bench.end(n * batch);
+      break;
+    case 'hashBatch':
+      bench.start();
+      for (i = 0; i < n; i++)
+        crypto.hashBatch(algo, inputs);
+      bench.end(n * batch);
+      break;
+    case 'hashBatchAsync':
+      i = 0;
+      bench.start();
+      (function next() {
+        if (i++ === n)
+          return bench.end(n * batch);
+        crypto.hashBatch(algo, inputs, next);
+      })();
+      break;
+    default:
+      throw new Error(`unknown method: ${conf.method}`);
+  }
+}
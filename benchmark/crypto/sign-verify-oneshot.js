@@ -0,0 +1,106 @@
+// Signing and verifying many small messages with the same RSA key:
+// createSign()/createVerify() with a PEM encoded key compared to the one-shot
+// crypto.sign() and crypto.verify() with a KeyObject, synchronous and on the
+// threadpool, and to crypto.verifyBatch().
+'use strict';
+const common = require('../common.js');
+const crypto = require('crypto');
+const fs = require('fs');
+const path = require('path');
+const fixtures_keydir = path.resolve(__dirname, '../../test/fixtures/keys/');
+
+const bench = common.createBenchmark(main, {
+  mode: ['sign', 'verify'],
+  method: ['stream', 'oneshot', 'oneshotAsync', 'batch'],
+  algo: ['sha256'],
+  keylen: ['1024', '2048'],
+  batch: [100],
+  n: [10]
+});
+
+function main(conf) {
+  const algo = conf.algo;
+  const batch = +conf.batch;
+  const n = +conf.n;
+  const privatePem =
+    fs.readFileSync(`${fixtures_keydir}/rsa_private_${conf.keylen}.pem`);
+  const publicPem =
+    fs.readFileSync(`${fixtures_keydir}/rsa_public_${conf.keylen}.pem`);
+  const privateKey = crypto.createPrivateKey(privatePem);
+  const publicKey = crypto.createPublicKey(publicPem);
+
+  const messages = [];
+  const signatures = [];
+  for (var i = 0; i < batch; i++) {
+    messages.push(Buffer.from(`message ${i}`));
+    signatures.push(crypto.sign(algo, messages[i], privateKey));
+  }
+
+  const total = n * batch;
+  var done = 0;
+  function ondone(err) {
+    if (err) throw err;
+    if (++done === total)
+      bench.end(total);
+  }
+
+  var j;
+  bench.start();
+  if (conf.mode === 'sign') {
+    switch (conf.method) {
+      case 'stream':
+        for (i = 0; i < n; i++) {
+          for (j = 0; j < batch; j++)
+            crypto.createSign(algo).update(messages[j]).sign(privatePem);
+        }
+        return bench.end(total);
+      case 'oneshot':
+      case 'batch':
+        // There is no batch variant of sign().
+        for (i = 0; i < n; i++) {
+          for (j = 0; j < batch; j++)
+            crypto.sign(algo, messages[j], privateKey);
+        }
+        return bench.end(total);
+      case 'oneshotAsync':
+        for (i = 0; i < n; i++) {
+          for (j = 0; j < batch; j++)
+            crypto.sign(algo, messages[j], privateKey, ondone);
+        }
+        return;
+    }
+  } else {
+    switch (conf.method) {
+      case 'stream':
+        for (i = 0; i < n; i++) {
+          for (j = 0; j < batch; j++) {
+            crypto.createVerify(algo).update(messages[j])
+              .verify(publicPem, signatures[j]);
+          }
+        }
+        return bench.end(total);
+      case 'oneshot':
+        for (i = 0; i < n; i++) {
+          for (j = 0; j < batch; j++)
+            crypto.verify(algo, messages[j], publicKey, signatures[j]);
+        }
+        return bench.end(total);
+      case 'oneshotAsync':
+        for (i = 0; i < n; i++) {
+          for (j = 0; j < batch; j++)
+            crypto.verify(algo, messages[j], publicKey, signatures[j], ondone);
+        }
+        return;
+      case 'batch':
+        i = 0;
+        (function next(err) {
+          if (err) throw err;
+          if (i++ === n)
+            return bench.end(total);
+          crypto.verifyBatch(algo, publicKey, messages, signatures, next);
+        })();
+        return;
+    }
+  }
+  throw new Error(`unknown method: ${conf.method}`);
+}
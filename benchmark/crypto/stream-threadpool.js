@@ -0,0 +1,56 @@
+// Several AES-GCM or SHA-256 streams at the same time, with large chunks
+// processed on the threadpool or on the main thread (threshold=Infinity).
+// Reports the throughput in Gbits.
+'use strict';
+const common = require('../common.js');
+const crypto = require('crypto');
+
+const bench = common.createBenchmark(main, {
+  type: ['cipher', 'hash'],
+  threshold: [65536, Infinity],
+  streams: [1, 4],
+  len: [1024 * 1024],
+  writes: [100]
+});
+
+function main(conf) {
+  const len = +conf.len;
+  const writes = +conf.writes;
+  const streams = +conf.streams;
+  const options = { threadpoolThreshold: +conf.threshold };
+  const chunk = Buffer.alloc(len, 'b');
+  const key = Buffer.alloc(32, 'k');
+  const iv = Buffer.alloc(12, 'i');
+
+  function create() {
+    if (conf.type === 'cipher')
+      return crypto.createCipheriv('aes-256-gcm', key, iv, options);
+    return crypto.createHash('sha256', options);
+  }
+
+  var finished = 0;
+  function done() {
+    if (++finished === streams) {
+      const bits = streams * writes * len * 8;
+      bench.end(bits / (1024 * 1024 * 1024));
+    }
+  }
+
+  function run(stream) {
+    var written = 0;
+    stream.resume();
+    stream.on('end', done);
+    (function write() {
+      while (written < writes) {
+        written++;
+        if (!stream.write(chunk))
+          return stream.once('drain', write);
+      }
+      stream.end();
+    })();
+  }
+
+  bench.start();
+  for (var i = 0; i < streams; i++)
+    run(create());
+}
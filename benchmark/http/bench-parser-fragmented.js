@@ -0,0 +1,68 @@
+'use strict';
+
+// Feeds the headers to the parser in small pieces, the way slow clients
+// send them, so that header strings span execute() calls.
+const common = require('../common');
+const HTTPParser = process.binding('http_parser').HTTPParser;
+const REQUEST = HTTPParser.REQUEST;
+const kOnHeaders = HTTPParser.kOnHeaders | 0;
+const kOnHeadersComplete = HTTPParser.kOnHeadersComplete | 0;
+const kOnBody = HTTPParser.kOnBody | 0;
+const kOnMessageComplete = HTTPParser.kOnMessageComplete | 0;
+const CRLF = '\r\n';
+
+const bench = common.createBenchmark(main, {
+  len: [4, 16],
+  chunk: [1, 16, 256],
+  cookie: [0, 4096],
+  n: [1e4],
+});
+
+
+function main(conf) {
+  const len = conf.len >>> 0;
+  const chunk = conf.chunk >>> 0;
+  const n = conf.n >>> 0;
+  var header = `GET /hello HTTP/1.1${CRLF}Content-Type: text/plain${CRLF}`;
+
+  for (var i = 0; i < len; i++) {
+    header += `X-Filler${i}: ${Math.random().toString(36).substr(2)}${CRLF}`;
+  }
+  if (conf.cookie > 0)
+    header += `Cookie: ${'c'.repeat(conf.cookie)}${CRLF}`;
+  header += CRLF;
+
+  const buf = Buffer.from(header);
+  const chunks = [];
+  for (i = 0; i < buf.length; i += chunk)
+    chunks.push(buf.slice(i, i + chunk));
+
+  processHeader(chunks, n);
+}
+
+
+function processHeader(chunks, n) {
+  const parser = newParser(REQUEST);
+
+  bench.start();
+  for (var i = 0; i < n; i++) {
+    for (var j = 0; j < chunks.length; j++)
+      parser.execute(chunks[j], 0, chunks[j].length);
+    parser.reinitialize(REQUEST);
+  }
+  bench.end(n);
+}
+
+
+function newParser(type) {
+  const parser = new HTTPParser(type);
+
+  parser.headers = [];
+
+  parser[kOnHeaders] = function() { };
+  parser[kOnHeadersComplete] = function() { };
+  parser[kOnBody] = function() { };
+  parser[kOnMessageComplete] = function() { };
+
+  return parser;
+}
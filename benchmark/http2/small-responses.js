@@ -0,0 +1,65 @@
+'use strict';
+
+const common = require('../common.js');
+const PORT = common.PORT;
+
+// Many small responses at once. With measure=writes, reports the number of
+// writes (i.e. write syscalls) the server session needed per request instead
+// of the request rate.
+const bench = common.createBenchmark(main, {
+  n: [1e4],
+  streams: [1, 10, 100],
+  measure: ['rate', 'writes']
+}, { flags: ['--no-warnings', '--expose-http2'] });
+
+function main(conf) {
+  const n = +conf.n;
+  const streams = +conf.streams;
+  const http2 = require('http2');
+  const { PerformanceObserver } = require('perf_hooks');
+  const server = http2.createServer();
+
+  server.on('stream', (stream) => {
+    stream.respond({ 'content-type': 'text/plain' });
+    stream.end('Hi!');
+  });
+
+  if (conf.measure === 'writes') {
+    const obs = new PerformanceObserver((items) => {
+      for (const entry of items.getEntries()) {
+        if (entry.name === 'Http2Session' && entry.type === 'server') {
+          obs.disconnect();
+          bench.report(entry.writeCount / n, process.hrtime(bench._time));
+        }
+      }
+    });
+    obs.observe({ entryTypes: ['http2'] });
+  }
+
+  server.listen(PORT, () => {
+    const client = http2.connect(`http://localhost:${PORT}/`);
+    let started = 0;
+    let finished = 0;
+
+    function doRequest() {
+      started++;
+      const req = client.request({ ':path': '/' });
+      req.end();
+      req.resume();
+      req.on('end', () => {
+        if (++finished === n) {
+          if (conf.measure === 'rate')
+            bench.end(n);
+          client.close();
+          server.close();
+        } else if (started < n) {
+          doRequest();
+        }
+      });
+    }
+
+    bench.start();
+    for (var i = 0; i < streams && i < n; i++)
+      doRequest();
+  });
+}
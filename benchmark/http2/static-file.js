@@ -0,0 +1,85 @@
+// Serving a static file: HTTP/2 respondWithFD() compared to piping an
+// fs.ReadStream into an HTTP/1 response.
+'use strict';
+
+const path = require('path');
+const common = require('../common.js');
+const PORT = common.PORT;
+const filename = path.resolve(process.env.NODE_TMPDIR || __dirname,
+                              `.removeme-benchmark-garbage-${process.pid}`);
+const fs = require('fs');
+
+const bench = common.createBenchmark(main, {
+  type: ['http2', 'http'],
+  size: [16 * 1024, 256 * 1024, 4 * 1024 * 1024],
+  streams: [1, 10],
+  n: [200]
+}, { flags: ['--no-warnings', '--expose-http2'] });
+
+function main(conf) {
+  const n = +conf.n;
+  const streams = +conf.streams;
+  const size = +conf.size;
+
+  try { fs.unlinkSync(filename); } catch (e) {}
+  fs.writeFileSync(filename, Buffer.alloc(size, 'x'));
+  const fd = fs.openSync(filename, 'r');
+
+  let server;
+  let request;
+  if (conf.type === 'http2') {
+    const http2 = require('http2');
+    server = http2.createServer();
+    server.on('stream', (stream) => {
+      stream.respondWithFD(fd, { 'content-length': size });
+    });
+    let client;
+    request = (cb) => {
+      if (client === undefined)
+        client = http2.connect(`http://localhost:${PORT}/`);
+      const req = client.request({ ':path': '/' });
+      req.resume();
+      req.on('end', cb);
+      req.end();
+    };
+    request.close = () => client.close();
+  } else {
+    const http = require('http');
+    server = http.createServer((req, res) => {
+      res.writeHead(200, { 'content-length': size });
+      fs.createReadStream(filename).pipe(res);
+    });
+    const agent = new http.Agent({ keepAlive: true, maxSockets: streams });
+    request = (cb) => {
+      http.get({ port: PORT, path: '/', agent }, (res) => {
+        res.resume();
+        res.on('end', cb);
+      });
+    };
+    request.close = () => agent.destroy();
+  }
+
+  server.listen(PORT, () => {
+    let started = 0;
+    let finished = 0;
+
+    function next() {
+      started++;
+      request(() => {
+        if (++finished === n) {
+          bench.end(n);
+          request.close();
+          server.close();
+          fs.closeSync(fd);
+          fs.unlinkSync(filename);
+        } else if (started < n) {
+          next();
+        }
+      });
+    }
+
+    bench.start();
+    for (var i = 0; i < streams && i < n; i++)
+      next();
+  });
+}
@@ -0,0 +1,75 @@
+'use strict';
+// Measures TLS throughput per CPU second rather than per wall-clock second,
+// so that the cost of the record path (decrypting, copying and handing
+// plaintext to JS) shows up even when the machine has spare cores.
+const common = require('../common.js');
+const bench = common.createBenchmark(main, {
+  dur: [5],
+  size: [1024, 16 * 1024, 1024 * 1024],
+  connections: [1, 8]
+});
+
+const fs = require('fs');
+const path = require('path');
+const tls = require('tls');
+const cert_dir = path.resolve(__dirname, '../../test/fixtures');
+
+function main(conf) {
+  const dur = +conf.dur;
+  const size = +conf.size;
+  const connections = +conf.connections;
+  const chunk = Buffer.alloc(size, 'b');
+
+  const options = {
+    key: fs.readFileSync(`${cert_dir}/test_key.pem`),
+    cert: fs.readFileSync(`${cert_dir}/test_cert.pem`),
+    ca: [ fs.readFileSync(`${cert_dir}/test_ca.pem`) ],
+    ciphers: 'AES256-GCM-SHA384'
+  };
+
+  var received = 0;
+  const server = tls.createServer(options, (socket) => {
+    socket.on('data', (chunk) => {
+      received += chunk.length;
+    });
+  });
+
+  const clients = [];
+  server.listen(common.PORT, () => {
+    var ready = 0;
+    for (var i = 0; i < connections; i++) {
+      const conn = tls.connect({ port: common.PORT, rejectUnauthorized: false },
+                               () => {
+                                 conn.on('drain', write);
+                                 write();
+                                 if (++ready === connections)
+                                   start();
+                               });
+      clients.push(conn);
+
+      function write() {
+        while (conn.write(chunk) !== false);
+      }
+    }
+  });
+
+  function start() {
+    received = 0;
+    const cpuStart = process.cpuUsage();
+    const timeStart = process.hrtime();
+    bench.start();
+    setTimeout(() => {
+      const cpu = process.cpuUsage(cpuStart);
+      const cpuSeconds = (cpu.user + cpu.system) / 1e6;
+      const elapsed = process.hrtime(timeStart);
+      const seconds = elapsed[0] + elapsed[1] / 1e9;
+      const mbits = (received * 8) / (1024 * 1024);
+      // bench.end() divides by the elapsed wall-clock time, so scale the
+      // result to report megabits per CPU second instead.
+      bench.end(mbits * seconds / cpuSeconds);
+      for (const conn of clients)
+        conn.destroy();
+      server.close();
+    }, dur * 1000);
+  }
+}
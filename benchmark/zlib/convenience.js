@@ -0,0 +1,49 @@
+'use strict';
+const common = require('../common.js');
+const zlib = require('zlib');
+
+// Latency of the buffer-in/buffer-out convenience methods, which is
+// dominated by per-call overhead for small payloads.
+const bench = common.createBenchmark(main, {
+  method: [
+    'deflate', 'deflateSync', 'inflate', 'inflateSync',
+    'gzip', 'gzipSync', 'gunzip', 'gunzipSync'
+  ],
+  inputLen: [64, 1024, 16 * 1024],
+  n: [1e5]
+});
+
+const compressors = {
+  inflate: zlib.deflateSync,
+  gunzip: zlib.gzipSync
+};
+
+function main(conf) {
+  const n = +conf.n;
+  const method = conf.method;
+  const sync = method.endsWith('Sync');
+  const name = sync ? method.slice(0, -4) : method;
+  const fn = zlib[method];
+
+  var input = Buffer.alloc(+conf.inputLen, 'abcdefghij');
+  if (compressors[name] !== undefined)
+    input = compressors[name](input);
+
+  var i = 0;
+  if (sync) {
+    bench.start();
+    for (; i < n; ++i)
+      fn(input);
+    bench.end(n);
+    return;
+  }
+
+  bench.start();
+  (function next(err) {
+    if (err)
+      throw err;
+    if (i++ === n)
+      return bench.end(n);
+    fn(input, next);
+  })();
+}
@@ -21,7 +21,11 @@
 
 'use strict';
 
-const { methods, HTTPParser } = process.binding('http_parser');
+const {
+  methods,
+  HTTPParser,
+  knownHeaderIndices
+} = process.binding('http_parser');
 
 const FreeList = require('internal/freelist');
 const { ondrain } = require('internal/http');
@@ -39,6 +43,17 @@ const kOnHeadersComplete = HTTPParser.kOnHeadersComplete | 0;
 const kOnBody = HTTPParser.kOnBody | 0;
 const kOnMessageComplete = HTTPParser.kOnMessageComplete | 0;
 const kOnExecute = HTTPParser.kOnExecute | 0;
+const kOnMessages = HTTPParser.kOnMessages | 0;
+const kMaxBatchedMessages = HTTPParser.kMaxBatchedMessages | 0;
+
+// The known header indices of the messages passed to parserOnMessages(),
+// one view per message.
+const batchIndices = [];
+{
+  const size = knownHeaderIndices.length / kMaxBatchedMessages;
+  for (var i = 0; i < kMaxBatchedMessages; i++)
+    batchIndices.push(knownHeaderIndices.subarray(i * size, (i + 1) * size));
+}
 
 // Only called in the slow case where slow means
 // that the request headers were either fragmented
@@ -62,10 +77,13 @@ function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
                                  url, statusCode, statusMessage, upgrade,
                                  shouldKeepAlive) {
   var parser = this;
+  // Only valid for headers that are passed in by the parser directly.
+  var knownIndices = knownHeaderIndices;
 
   if (!headers) {
     headers = parser._headers;
     parser._headers = [];
+    knownIndices = undefined;
   }
 
   if (!url) {
@@ -73,6 +91,14 @@ function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
     parser._url = '';
   }
 
+  return headersComplete(parser, versionMajor, versionMinor, headers,
+                         knownIndices, method, url, statusCode,
+                         statusMessage, upgrade, shouldKeepAlive);
+}
+
+function headersComplete(parser, versionMajor, versionMinor, headers,
+                         knownIndices, method, url, statusCode, statusMessage,
+                         upgrade, shouldKeepAlive) {
   parser.incoming = new IncomingMessage(parser.socket);
   parser.incoming.httpVersionMajor = versionMajor;
   parser.incoming.httpVersionMinor = versionMinor;
@@ -85,7 +111,7 @@ function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
   if (parser.maxHeaderPairs > 0)
     n = Math.min(n, parser.maxHeaderPairs);
 
-  parser.incoming._addHeaderLines(headers, n);
+  parser.incoming._addHeaderLines(headers, n, knownIndices);
 
   if (typeof method === 'number') {
     // server only
@@ -143,7 +169,23 @@ function parserOnBody(b, start, len) {
 }
 
 function parserOnMessageComplete() {
-  var parser = this;
+  messageComplete(this);
+}
+
+// Called instead of parserOnHeadersComplete() and parserOnMessageComplete()
+// for requests without a body that the parser has collected from one chunk
+// of data.  Each message takes six entries of `messages`: headers, url,
+// method, versionMajor, versionMinor and shouldKeepAlive.
+function parserOnMessages(messages) {
+  for (var i = 0; i < messages.length; i += 6) {
+    headersComplete(this, messages[i + 3], messages[i + 4], messages[i],
+                    batchIndices[i / 6], messages[i + 2], messages[i + 1],
+                    undefined, undefined, false, messages[i + 5]);
+    messageComplete(this);
+  }
+}
+
+function messageComplete(parser) {
   var stream = parser.incoming;
 
   if (stream) {
@@ -186,6 +228,7 @@ var parsers = new FreeList('parsers', 1000, function() {
   parser[kOnBody] = parserOnBody;
   parser[kOnMessageComplete] = parserOnMessageComplete;
   parser[kOnExecute] = null;
+  parser[kOnMessages] = parserOnMessages;
 
   return parser;
 });
@@ -23,6 +23,7 @@
 
 const util = require('util');
 const Stream = require('stream');
+const { knownHeaders } = process.binding('http_parser');
 
 function readStart(socket) {
   if (socket && !socket._paused && socket.readable)
@@ -116,7 +117,9 @@ IncomingMessage.prototype.destroy = function destroy(error) {
 
 
 IncomingMessage.prototype._addHeaderLines = _addHeaderLines;
-function _addHeaderLines(headers, n) {
+// `knownIndices` optionally holds the parser's index of each header name,
+// which saves the matchKnownFields() call for known headers.
+function _addHeaderLines(headers, n, knownIndices) {
   if (headers && headers.length) {
     var dest;
     if (this.complete) {
@@ -128,7 +131,11 @@ function _addHeaderLines(headers, n) {
     }
 
     for (var i = 0; i < n; i += 2) {
-      this._addHeaderLine(headers[i], headers[i + 1], dest);
+      var index = knownIndices !== undefined ? knownIndices[i >> 1] : 0;
+      if (index !== 0)
+        addMatchedHeaderLine(knownFields[index], headers[i + 1], dest);
+      else
+        this._addHeaderLine(headers[i], headers[i + 1], dest);
     }
   }
 }
@@ -282,9 +289,20 @@ function matchKnownFields(field) {
 // cannot be joined in either of these ways, we declare the first instance the
 // winner and drop the second. Extended header fields (those beginning with
 // 'x-') are always joined.
+// The result of matchKnownFields() for each header name the HTTP parser
+// knows about, by the index the parser reports for it.  Index 0 stands for
+// a header that is not known.
+const knownFields = [undefined];
+for (var k = 0; k < knownHeaders.length; k++)
+  knownFields.push(matchKnownFields(knownHeaders[k]));
+
 IncomingMessage.prototype._addHeaderLine = _addHeaderLine;
 function _addHeaderLine(field, value, dest) {
-  field = matchKnownFields(field);
+  addMatchedHeaderLine(matchKnownFields(field), value, dest);
+}
+
+// `field` is the result of matchKnownFields().
+function addMatchedHeaderLine(field, value, dest) {
   var flag = field.charCodeAt(0);
   if (flag === 0 || flag === 2) {
     field = field.slice(1);
@@ -34,6 +34,7 @@ const { outHeadersKey } = require('internal/http');
 const { async_id_symbol } = process.binding('async_wrap');
 const { nextTick } = require('internal/process/next_tick');
 const errors = require('internal/errors');
+const { serializeHead } = process.binding('http_serializer');
 
 const { CRLF, debug } = common;
 const { utcDate } = internalHttp;
@@ -66,6 +67,129 @@ function isCookieField(s) {
 
 function noopPendingOutput(amount) {}
 
+const kHeaderBlock = Symbol('headerBlock');
+const kHeaderState = Symbol('headerState');
+const kHeaderFields = Symbol('headerFields');
+
+// A set of response headers that is validated and serialized only once, for
+// servers that send the same headers with many responses.  See
+// http.createHeaderTemplate().
+function HeaderTemplate(headers) {
+  if (headers === null || typeof headers !== 'object') {
+    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'headers',
+                               ['Object', 'Array']);
+  }
+
+  const state = newHeaderState('');
+  // Collects what the headers mean for the message they are sent with.
+  const self = { _last: false, shouldKeepAlive: false, chunkedEncoding: false };
+  storeHeaders(self, state, headers, false);
+
+  state.last = self._last;
+  state.keepAlive = self.shouldKeepAlive;
+  state.chunked = self.chunkedEncoding;
+  this[kHeaderBlock] = Buffer.from(state.header, 'latin1');
+  this[kHeaderState] = state;
+  this[kHeaderFields] = templateFields(headers);
+  Object.freeze(this);
+}
+
+// The template's headers as [field, value, lower-cased field] triples, in
+// case some of them are replaced with setHeader() and the head has to be put
+// together anew.
+function templateFields(headers) {
+  var fields = [];
+  var field;
+  var value;
+  var i;
+  if (headers instanceof Array) {
+    for (i = 0; i < headers.length; i++) {
+      field = headers[i][0];
+      value = headers[i][1];
+      if (value instanceof Array)
+        value = value.slice();
+      fields.push([field, value, field.toLowerCase()]);
+    }
+  } else {
+    var keys = Object.keys(headers);
+    for (i = 0; i < keys.length; i++) {
+      field = keys[i];
+      value = headers[field];
+      if (value instanceof Array) {
+        value = value.length < 2 || !isCookieField(field) ?
+          value.slice() : value.join('; ');
+      }
+      fields.push([field, value, field.toLowerCase()]);
+    }
+  }
+  return fields;
+}
+
+// Returns the headers to send when headers set with setHeader() replace
+// some of the template's, or null if they do not.
+function overrideTemplate(template, own) {
+  if (!own)
+    return null;
+  const fields = template[kHeaderFields];
+  var overridden = false;
+  for (var i = 0; i < fields.length && !overridden; i++)
+    overridden = own[fields[i][2]] !== undefined;
+  if (!overridden)
+    return null;
+
+  const headers = [];
+  for (i = 0; i < fields.length; i++) {
+    if (own[fields[i][2]] === undefined)
+      headers.push(fields[i]);
+  }
+  for (var key in own) {
+    var entry = own[key];
+    var value = entry[1];
+    if (value instanceof Array && value.length >= 2 &&
+        isCookieField(entry[0])) {
+      value = value.join('; ');
+    }
+    headers.push([entry[0], value]);
+  }
+  return headers;
+}
+
+function createHeaderTemplate(headers) {
+  return new HeaderTemplate(headers);
+}
+
+function newHeaderState(header) {
+  return {
+    connection: false,
+    connUpgrade: false,
+    contLen: false,
+    te: false,
+    date: false,
+    expect: false,
+    trailer: false,
+    upgrade: false,
+    header
+  };
+}
+
+function applyHeaderTemplate(self, state, template) {
+  const templateState = template[kHeaderState];
+  state.connection = templateState.connection;
+  state.connUpgrade = templateState.connUpgrade;
+  state.contLen = templateState.contLen;
+  state.te = templateState.te;
+  state.date = templateState.date;
+  state.expect = templateState.expect;
+  state.trailer = templateState.trailer;
+  state.upgrade = templateState.upgrade;
+  if (templateState.last)
+    self._last = true;
+  if (templateState.keepAlive)
+    self.shouldKeepAlive = true;
+  if (templateState.chunked)
+    self.chunkedEncoding = true;
+}
+
 function OutgoingMessage() {
   Stream.call(this);
 
@@ -216,7 +340,7 @@ OutgoingMessage.prototype._send = function _send(data, encoding, callback) {
   // the same packet. Future versions of Node are going to take care of
   // this at a lower level and in a more general way.
   if (!this._headerSent) {
-    if (typeof data === 'string' &&
+    if (typeof data === 'string' && typeof this._header === 'string' &&
         (encoding === 'utf8' || encoding === 'latin1' || !encoding)) {
       data = this._header + data;
     } else {
@@ -254,9 +378,15 @@ function _writeRaw(data, encoding, callback) {
   }
 
   if (conn && conn._httpMessage === this && conn.writable && !conn.destroyed) {
-    // There might be pending data in the this.output buffer.
+    // There might be pending data in the this.output buffer.  Write it
+    // together with `data`, so that e.g. the headers and the first chunk of
+    // the body go out in a single writev().
     if (this.output.length) {
+      conn.cork();
       this._flushOutput(conn);
+      const ret = conn.write(data, encoding, callback);
+      conn.uncork();
+      return ret;
     } else if (!data.length) {
       if (typeof callback === 'function') {
         let socketAsyncId = this.socket[async_id_symbol];
@@ -288,77 +418,41 @@ OutgoingMessage.prototype._storeHeader = _storeHeader;
 function _storeHeader(firstLine, headers) {
   // firstLine in the case of request is: 'GET /index.html HTTP/1.1\r\n'
   // in the case of response it is: 'HTTP/1.1 200 OK\r\n'
-  var state = {
-    connection: false,
-    connUpgrade: false,
-    contLen: false,
-    te: false,
-    date: false,
-    expect: false,
-    trailer: false,
-    upgrade: false,
-    header: firstLine
-  };
-
-  var field;
-  var key;
-  var value;
-  var i;
-  var j;
-  if (headers === this[outHeadersKey]) {
-    for (key in headers) {
-      var entry = headers[key];
-      field = entry[0];
-      value = entry[1];
-
-      if (value instanceof Array) {
-        if (value.length < 2 || !isCookieField(field)) {
-          for (j = 0; j < value.length; j++)
-            storeHeader(this, state, field, value[j], false);
-          continue;
-        }
-        value = value.join('; ');
-      }
-      storeHeader(this, state, field, value, false);
-    }
-  } else if (headers instanceof Array) {
-    for (i = 0; i < headers.length; i++) {
-      field = headers[i][0];
-      value = headers[i][1];
-
-      if (value instanceof Array) {
-        for (j = 0; j < value.length; j++) {
-          storeHeader(this, state, field, value[j], true);
-        }
-      } else {
-        storeHeader(this, state, field, value, true);
-      }
-    }
-  } else if (headers) {
-    var keys = Object.keys(headers);
-    for (i = 0; i < keys.length; i++) {
-      field = keys[i];
-      value = headers[field];
-
-      if (value instanceof Array) {
-        if (value.length < 2 || !isCookieField(field)) {
-          for (j = 0; j < value.length; j++)
-            storeHeader(this, state, field, value[j], true);
-          continue;
-        }
-        value = value.join('; ');
-      }
-      storeHeader(this, state, field, value, true);
+  var state;
+  var template;
+  if (headers instanceof HeaderTemplate) {
+    const merged = overrideTemplate(headers, this[outHeadersKey]);
+    if (merged !== null) {
+      // A header set with setHeader() takes the place of the template's,
+      // so the template's serialized lines cannot be used as they are.
+      headers = merged;
+      state = newHeaderState(firstLine);
+    } else {
+      // The template's header lines are serialized already, only the
+      // headers that were set with setHeader() and the ones added below end
+      // up in state.header.
+      template = headers;
+      headers = this[outHeadersKey];
+      state = newHeaderState('');
+      applyHeaderTemplate(this, state, template);
     }
+  } else {
+    state = newHeaderState(firstLine);
   }
 
+  storeHeaders(this, state, headers, headers === this[outHeadersKey]);
+
   // Are we upgrading the connection?
   if (state.connUpgrade && state.upgrade)
     this.upgrading = true;
 
   // Date header
+  var addDate = false;
   if (this.sendDate && !state.date) {
-    state.header += 'Date: ' + utcDate() + CRLF;
+    if (template !== undefined)
+      addDate = true;  // Written by serializeHead() from the native cache.
+    else
+      state.header += 'Date: ' + utcDate() + CRLF;
   }
 
   // Force the connection to close when the response is a 204 No Content or
@@ -424,7 +518,12 @@ function _storeHeader(firstLine, headers) {
     throw new errors.Error('ERR_HTTP_TRAILER_INVALID');
   }
 
-  this._header = state.header + CRLF;
+  if (template !== undefined) {
+    this._header = serializeHead(firstLine, template[kHeaderBlock],
+                                 state.header, addDate);
+  } else {
+    this._header = state.header + CRLF;
+  }
   this._headerSent = false;
 
   // wait until the first body chunk, or close(), is sent to flush,
@@ -432,6 +531,62 @@ function _storeHeader(firstLine, headers) {
   if (state.expect) this._send('');
 }
 
+// `own` is true if `headers` is the message's own headers map, whose
+// entries have been validated by setHeader() already.
+function storeHeaders(self, state, headers, own) {
+  var field;
+  var key;
+  var value;
+  var i;
+  var j;
+  if (own) {
+    for (key in headers) {
+      var entry = headers[key];
+      field = entry[0];
+      value = entry[1];
+
+      if (value instanceof Array) {
+        if (value.length < 2 || !isCookieField(field)) {
+          for (j = 0; j < value.length; j++)
+            storeHeader(self, state, field, value[j], false);
+          continue;
+        }
+        value = value.join('; ');
+      }
+      storeHeader(self, state, field, value, false);
+    }
+  } else if (headers instanceof Array) {
+    for (i = 0; i < headers.length; i++) {
+      field = headers[i][0];
+      value = headers[i][1];
+
+      if (value instanceof Array) {
+        for (j = 0; j < value.length; j++) {
+          storeHeader(self, state, field, value[j], true);
+        }
+      } else {
+        storeHeader(self, state, field, value, true);
+      }
+    }
+  } else if (headers) {
+    var keys = Object.keys(headers);
+    for (i = 0; i < keys.length; i++) {
+      field = keys[i];
+      value = headers[field];
+
+      if (value instanceof Array) {
+        if (value.length < 2 || !isCookieField(field)) {
+          for (j = 0; j < value.length; j++)
+            storeHeader(self, state, field, value[j], true);
+          continue;
+        }
+        value = value.join('; ');
+      }
+      storeHeader(self, state, field, value, true);
+    }
+  }
+}
+
 function storeHeader(self, state, key, value, validate) {
   if (validate) {
     validateHeader(key, value);
@@ -881,5 +1036,7 @@ OutgoingMessage.prototype.pipe = function pipe() {
 };
 
 module.exports = {
-  OutgoingMessage
+  HeaderTemplate,
+  OutgoingMessage,
+  createHeaderTemplate
 };
@@ -35,7 +35,7 @@ const {
   httpSocketSetup,
   _checkInvalidHeaderChar: checkInvalidHeaderChar
 } = require('_http_common');
-const { OutgoingMessage } = require('_http_outgoing');
+const { HeaderTemplate, OutgoingMessage } = require('_http_outgoing');
 const { outHeadersKey, ondrain } = require('internal/http');
 const errors = require('internal/errors');
 const Buffer = require('buffer').Buffer;
@@ -207,7 +207,10 @@ function writeHead(statusCode, reason, obj) {
   this.statusCode = statusCode;
 
   var headers;
-  if (this[outHeadersKey]) {
+  if (obj instanceof HeaderTemplate) {
+    // _storeHeader() adds the headers that were set with setHeader().
+    headers = obj;
+  } else if (this[outHeadersKey]) {
     // Slow-case: when progressive API and header fields are passed.
     var k;
     if (obj) {
@@ -31,6 +31,7 @@ const {
   indexOfBuffer,
   indexOfNumber,
   indexOfString,
+  isUtf8: _isUtf8,
   swap16: _swap16,
   swap32: _swap32,
   swap64: _swap64,
@@ -1623,6 +1624,17 @@ Buffer.prototype.swap64 = function swap64() {
 
 Buffer.prototype.toLocaleString = Buffer.prototype.toString;
 
+function isUtf8(input) {
+  if (isArrayBufferView(input) || isAnyArrayBuffer(input))
+    return _isUtf8(input);
+
+  throw new errors.TypeError(
+    'ERR_INVALID_ARG_TYPE', 'input',
+    ['Buffer', 'TypedArray', 'DataView', 'ArrayBuffer', 'SharedArrayBuffer'],
+    input
+  );
+}
+
 let transcode;
 if (process.binding('config').hasIntl) {
   const {
@@ -1657,6 +1669,7 @@ module.exports = exports = {
   Buffer,
   SlowBuffer,
   transcode,
+  isUtf8,
   INSPECT_MAX_BYTES: 50,
 
   // Legacy
@@ -66,11 +66,21 @@ const {
 } = require('internal/crypto/cipher');
 const {
   Sign,
-  Verify
+  Verify,
+  sign,
+  verify,
+  verifyBatch
 } = require('internal/crypto/sig');
+const {
+  KeyObject,
+  createPrivateKey,
+  createPublicKey
+} = require('internal/crypto/keys');
 const {
   Hash,
-  Hmac
+  Hmac,
+  hash,
+  hashBatch
 } = require('internal/crypto/hash');
 const {
   getCiphers,
@@ -142,12 +152,16 @@ module.exports = exports = {
   createECDH,
   createHash,
   createHmac,
+  createPrivateKey,
+  createPublicKey,
   createSign,
   createVerify,
   getCiphers,
   getCurves,
   getDiffieHellman: createDiffieHellmanGroup,
   getHashes,
+  hash,
+  hashBatch,
   pbkdf2,
   pbkdf2Sync,
   privateDecrypt,
@@ -161,7 +175,10 @@ module.exports = exports = {
   randomFillSync,
   rng: randomBytes,
   setEngine,
+  sign,
   timingSafeEqual,
+  verify,
+  verifyBatch,
 
   // Classes
   Certificate,
@@ -174,6 +191,7 @@ module.exports = exports = {
   ECDH,
   Hash,
   Hmac,
+  KeyObject,
   Sign,
   Verify
 };
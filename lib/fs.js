@@ -385,267 +385,74 @@ fs.readFile = function(path, options, callback) {
   if (!nullCheck(path, callback))
     return;
 
-  var context = new ReadFileContext(callback, options.encoding);
-  context.isUserFd = isFd(path); // file descriptor ownership
-  var req = new FSReqWrap();
-  req.context = context;
-  req.oncomplete = readFileAfterOpen;
-
-  if (context.isUserFd) {
-    process.nextTick(function() {
-      req.oncomplete(null, path);
-    });
-    return;
-  } else if (typeof path !== 'string' && !(path instanceof Buffer)) {
-    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'path',
-                               ['string', 'Buffer', 'URL']);
-  }
-
-  binding.open(pathModule.toNamespacedPath(path),
-               stringToFlags(options.flag || 'r'),
-               0o666,
-               req);
-};
-
-const kReadFileBufferLength = 8 * 1024;
-
-function ReadFileContext(callback, encoding) {
-  this.fd = undefined;
-  this.isUserFd = undefined;
-  this.size = undefined;
-  this.callback = callback;
-  this.buffers = null;
-  this.buffer = null;
-  this.pos = 0;
-  this.encoding = encoding;
-  this.err = null;
-}
-
-ReadFileContext.prototype.read = function() {
-  var buffer;
-  var offset;
-  var length;
-
-  if (this.size === 0) {
-    buffer = this.buffer = Buffer.allocUnsafeSlow(kReadFileBufferLength);
-    offset = 0;
-    length = kReadFileBufferLength;
+  if (isFd(path)) {
+    if (!isInt32(path))
+      throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'fd', 'integer');
   } else {
-    buffer = this.buffer;
-    offset = this.pos;
-    length = this.size - this.pos;
+    if (typeof path !== 'string' && !(path instanceof Buffer)) {
+      throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'path',
+                                 ['string', 'Buffer', 'URL']);
+    }
+    path = pathModule.toNamespacedPath(path);
   }
 
+  // The whole file is opened, sized, read and closed (and, for UTF-8,
+  // decoded) as a single request on the threadpool.  Large files are read
+  // in bounded steps so that they do not monopolize a threadpool thread.
   var req = new FSReqWrap();
+  req.context = { callback, encoding: options.encoding };
   req.oncomplete = readFileAfterRead;
-  req.context = this;
-
-  binding.read(this.fd, buffer, offset, length, -1, req);
-};
-
-ReadFileContext.prototype.close = function(err) {
-  var req = new FSReqWrap();
-  req.oncomplete = readFileAfterClose;
-  req.context = this;
-  this.err = err;
-
-  if (this.isUserFd) {
-    process.nextTick(function() {
-      req.oncomplete(null);
-    });
-    return;
-  }
-
-  binding.close(this.fd, req);
+  binding.readFile(path,
+                   stringToFlags(options.flag || 'r'),
+                   isUtf8Encoding(options.encoding),
+                   req);
 };
 
-function readFileAfterOpen(err, fd) {
-  var context = this.context;
-
-  if (err) {
-    context.callback(err);
-    return;
-  }
-
-  context.fd = fd;
-
-  var req = new FSReqWrap();
-  req.oncomplete = readFileAfterStat;
-  req.context = context;
-  binding.fstat(fd, req);
-}
-
-function readFileAfterStat(err) {
-  var context = this.context;
-
-  if (err)
-    return context.close(err);
-
-  // Use stats array directly to avoid creating an fs.Stats instance just for
-  // our internal use.
-  var size;
-  if ((statValues[1/*mode*/] & S_IFMT) === S_IFREG)
-    size = context.size = statValues[8/*size*/];
-  else
-    size = context.size = 0;
-
-  if (size === 0) {
-    context.buffers = [];
-    context.read();
-    return;
-  }
-
-  if (size > kMaxLength) {
-    err = new RangeError('File size is greater than possible Buffer: ' +
-                         `0x${kMaxLength.toString(16)} bytes`);
-    return context.close(err);
-  }
-
-  try {
-    context.buffer = Buffer.allocUnsafeSlow(size);
-  } catch (err) {
-    return context.close(err);
-  }
-  context.read();
-}
-
-function readFileAfterRead(err, bytesRead) {
-  var context = this.context;
-
-  if (err)
-    return context.close(err);
-
-  if (bytesRead === 0)
-    return context.close();
-
-  context.pos += bytesRead;
-
-  if (context.size !== 0) {
-    if (context.pos === context.size)
-      context.close();
-    else
-      context.read();
-  } else {
-    // unknown size, just read until we don't get bytes.
-    context.buffers.push(context.buffer.slice(0, bytesRead));
-    context.read();
-  }
+function isUtf8Encoding(encoding) {
+  return !!encoding && internalUtil.normalizeEncoding(encoding) === 'utf8';
 }
 
-function readFileAfterClose(err) {
+function readFileAfterRead(err, contents) {
   var context = this.context;
-  var buffer = null;
   var callback = context.callback;
 
-  if (context.err || err)
-    return callback(context.err || err);
-
-  try {
-    if (context.size === 0)
-      buffer = Buffer.concat(context.buffers, context.pos);
-    else if (context.pos < context.size)
-      buffer = context.buffer.slice(0, context.pos);
-    else
-      buffer = context.buffer;
-
-    if (context.encoding)
-      buffer = buffer.toString(context.encoding);
-  } catch (err) {
+  if (err)
     return callback(err);
-  }
-
-  callback(null, buffer);
-}
-
-function tryStatSync(fd, isUserFd) {
-  var threw = true;
-  try {
-    binding.fstat(fd);
-    threw = false;
-  } finally {
-    if (threw && !isUserFd) fs.closeSync(fd);
-  }
-}
 
-function tryCreateBuffer(size, fd, isUserFd) {
-  var threw = true;
-  var buffer;
-  try {
-    buffer = Buffer.allocUnsafe(size);
-    threw = false;
-  } finally {
-    if (threw && !isUserFd) fs.closeSync(fd);
+  if (typeof contents !== 'string' && context.encoding) {
+    try {
+      contents = contents.toString(context.encoding);
+    } catch (err) {
+      return callback(err);
+    }
   }
-  return buffer;
-}
 
-function tryReadSync(fd, isUserFd, buffer, pos, len) {
-  var threw = true;
-  var bytesRead;
-  try {
-    bytesRead = fs.readSync(fd, buffer, pos, len);
-    threw = false;
-  } finally {
-    if (threw && !isUserFd) fs.closeSync(fd);
-  }
-  return bytesRead;
+  callback(null, contents);
 }
 
 fs.readFileSync = function(path, options) {
   options = getOptions(options, { flag: 'r' });
-  var isUserFd = isFd(path); // file descriptor ownership
-  var fd = isUserFd ? path : fs.openSync(path, options.flag || 'r', 0o666);
-
-  tryStatSync(fd, isUserFd);
-  // Use stats array directly to avoid creating an fs.Stats instance just for
-  // our internal use.
-  var size;
-  if ((statValues[1/*mode*/] & S_IFMT) === S_IFREG)
-    size = statValues[8/*size*/];
-  else
-    size = 0;
-  var pos = 0;
-  var buffer; // single buffer with file data
-  var buffers; // list for when size is unknown
 
-  if (size === 0) {
-    buffers = [];
-  } else {
-    buffer = tryCreateBuffer(size, fd, isUserFd);
-  }
-
-  var bytesRead;
-
-  if (size !== 0) {
-    do {
-      bytesRead = tryReadSync(fd, isUserFd, buffer, pos, size - pos);
-      pos += bytesRead;
-    } while (bytesRead !== 0 && pos < size);
+  if (isFd(path)) {
+    if (!isInt32(path))
+      throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'fd', 'integer');
   } else {
-    do {
-      // the kernel lies about many files.
-      // Go ahead and try to read some bytes.
-      buffer = Buffer.allocUnsafe(8192);
-      bytesRead = tryReadSync(fd, isUserFd, buffer, 0, 8192);
-      if (bytesRead !== 0) {
-        buffers.push(buffer.slice(0, bytesRead));
-      }
-      pos += bytesRead;
-    } while (bytesRead !== 0);
+    handleError((path = getPathFromURL(path)));
+    nullCheck(path);
+    if (typeof path !== 'string' && !isUint8Array(path)) {
+      throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'path',
+                                 ['string', 'Buffer', 'URL']);
+    }
+    path = pathModule.toNamespacedPath(path);
   }
 
-  if (!isUserFd)
-    fs.closeSync(fd);
-
-  if (size === 0) {
-    // data was collected into the buffers list.
-    buffer = Buffer.concat(buffers, pos);
-  } else if (pos < size) {
-    buffer = buffer.slice(0, pos);
-  }
+  var contents = binding.readFile(path,
+                                  stringToFlags(options.flag || 'r'),
+                                  isUtf8Encoding(options.encoding));
 
-  if (options.encoding) buffer = buffer.toString(options.encoding);
-  return buffer;
+  if (typeof contents !== 'string' && options.encoding)
+    contents = contents.toString(options.encoding);
+  return contents;
 };
 
 fs.close = function(fd, callback) {
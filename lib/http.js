@@ -55,6 +55,7 @@ module.exports = {
   OutgoingMessage: outgoing.OutgoingMessage,
   Server,
   ServerResponse: server.ServerResponse,
+  createHeaderTemplate: outgoing.createHeaderTemplate,
   createServer,
   get,
   request
@@ -0,0 +1,197 @@
+'use strict';
+
+// Persistent code cache for CommonJS modules, enabled by pointing
+// NODE_COMPILE_CACHE at a directory.  Every module that is compiled from a
+// file gets a cache entry holding V8's code cache for its wrapper, which is
+// handed back to V8 as `cachedData` the next time the same file is loaded.
+//
+// An entry is only used when the V8 version and flags (as reported by
+// cachedDataVersionTag()), the file's mtime and the source length all
+// match; V8 additionally verifies the source hash and may still reject it.
+// The cache is strictly best-effort, errors reading or writing it are
+// ignored and the module is compiled from scratch.
+
+const { Buffer } = require('buffer');
+const fs = require('fs');
+const path = require('path');
+const { cachedDataVersionTag } = process.binding('v8');
+
+const kMagic = 0x4e434331;  // 'NCC1'
+const kHeaderLength = 28;
+
+const stats = {
+  hits: 0,      // Entries that were accepted by V8.
+  misses: 0,    // Modules that had no usable entry.
+  rejects: 0    // Entries that V8 refused, e.g. after a flag change.
+};
+
+var directory = null;
+var directoryCreated = false;
+var versionTag = 0;
+
+function init(dir) {
+  if (!dir) {
+    directory = null;
+    return;
+  }
+  directory = path.resolve(dir);
+  directoryCreated = false;
+  versionTag = cachedDataVersionTag();
+}
+
+function isEnabled() {
+  return directory !== null;
+}
+
+// 32-bit FNV-1a over the UTF-16 code units of the file name.  Collisions are
+// harmless because the full file name is stored in, and checked against, the
+// entry.
+function hashFilename(filename) {
+  var hash = 0x811c9dc5;
+  for (var i = 0; i < filename.length; i++) {
+    hash ^= filename.charCodeAt(i);
+    hash = Math.imul(hash, 0x01000193);
+  }
+  return (hash >>> 0).toString(16);
+}
+
+function entryPath(filename) {
+  return path.join(directory, `${hashFilename(filename)}.cache`);
+}
+
+function getMtime(filename) {
+  try {
+    return fs.statSync(filename).mtimeMs;
+  } catch (e) {
+    return -1;
+  }
+}
+
+// Returns the code cache stored for |filename|, or undefined.
+function lookup(filename, source, mtime) {
+  var data;
+  try {
+    data = fs.readFileSync(entryPath(filename));
+  } catch (e) {
+    return;
+  }
+  if (data.length < kHeaderLength ||
+      data.readUInt32LE(0) !== kMagic ||
+      data.readUInt32LE(4) !== versionTag ||
+      data.readDoubleLE(8) !== mtime ||
+      data.readDoubleLE(16) !== source.length) {
+    return;
+  }
+  const nameLength = data.readUInt32LE(24);
+  const nameEnd = kHeaderLength + nameLength;
+  if (nameEnd > data.length ||
+      data.toString('utf8', kHeaderLength, nameEnd) !== filename) {
+    return;
+  }
+  return data.slice(nameEnd);
+}
+
+// Creates |dir| and any of its parents that are missing.
+function mkdirp(dir) {
+  try {
+    fs.mkdirSync(dir);
+  } catch (e) {
+    if (e.code === 'EEXIST')
+      return;
+    const parent = path.dirname(dir);
+    if (e.code !== 'ENOENT' || parent === dir)
+      throw e;
+    mkdirp(parent);
+    try {
+      fs.mkdirSync(dir);
+    } catch (e) {
+      // Another process may have created it in the meantime.
+      if (e.code !== 'EEXIST')
+        throw e;
+    }
+  }
+}
+
+// Returns whether the cache directory exists.  If it cannot be created, the
+// cache is disabled for the rest of the process.
+function ensureDirectory() {
+  if (directoryCreated)
+    return true;
+  try {
+    mkdirp(directory);
+  } catch (e) {
+    process.emitWarning(
+      `Cannot create the compile cache directory ${directory}: ${e.message}`);
+    directory = null;
+    return false;
+  }
+  directoryCreated = true;
+  return true;
+}
+
+function store(filename, source, mtime, cachedData) {
+  if (!ensureDirectory())
+    return;
+
+  const name = Buffer.from(filename, 'utf8');
+  const header = Buffer.allocUnsafe(kHeaderLength);
+  header.writeUInt32LE(kMagic, 0);
+  header.writeUInt32LE(versionTag, 4);
+  header.writeDoubleLE(mtime, 8);
+  header.writeDoubleLE(source.length, 16);
+  header.writeUInt32LE(name.length, 24);
+
+  const target = entryPath(filename);
+  // Write to a private file first so that concurrent processes never see a
+  // partially written entry.
+  const temp = `${target}.${process.pid}.tmp`;
+  try {
+    fs.writeFileSync(temp, Buffer.concat([header, name, cachedData]));
+    fs.renameSync(temp, target);
+  } catch (e) {
+    try {
+      fs.unlinkSync(temp);
+    } catch (e) {}
+  }
+}
+
+function discard(filename) {
+  try {
+    fs.unlinkSync(entryPath(filename));
+  } catch (e) {}
+}
+
+// Compiles |wrapper|, the wrapped source of the module at |filename|, as a
+// vm.Script using and/or populating the cache.
+function compile(Script, wrapper, filename, options) {
+  const mtime = getMtime(filename);
+  if (mtime < 0)
+    return new Script(wrapper, options);
+
+  const cachedData = lookup(filename, wrapper, mtime);
+  if (cachedData !== undefined) {
+    const script = new Script(wrapper, Object.assign({ cachedData }, options));
+    if (script.cachedDataRejected === true) {
+      stats.rejects++;
+      discard(filename);
+    } else {
+      stats.hits++;
+    }
+    return script;
+  }
+
+  stats.misses++;
+  const script = new Script(wrapper,
+                            Object.assign({ produceCachedData: true },
+                                          options));
+  if (script.cachedDataProduced === true)
+    store(filename, wrapper, mtime, script.cachedData);
+  return script;
+}
+
+module.exports = {
+  init,
+  isEnabled,
+  compile,
+  stats
+};
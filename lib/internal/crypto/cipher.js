@@ -9,6 +9,7 @@ const errors = require('internal/errors');
 
 const {
   getDefaultEncoding,
+  getThreadpoolThreshold,
   toBuf
 } = require('internal/crypto/util');
 
@@ -29,6 +30,9 @@ const { StringDecoder } = require('string_decoder');
 const { inherits } = require('util');
 const { normalizeEncoding } = require('internal/util');
 
+const kPending = Symbol('pending');
+const kThreadpoolThreshold = Symbol('threadpoolThreshold');
+
 function rsaPublic(method, defaultPadding) {
   return function(options, buffer) {
     const key = options.key || options;
@@ -52,6 +56,13 @@ const publicDecrypt = rsaPublic(_publicDecrypt, RSA_PKCS1_PADDING);
 const privateEncrypt = rsaPrivate(_privateEncrypt, RSA_PKCS1_PADDING);
 const privateDecrypt = rsaPrivate(_privateDecrypt, RSA_PKCS1_OAEP_PADDING);
 
+// The cipher context must not be used while a chunk of the stream is being
+// processed on the threadpool.
+function assertNotPending(cipher, method) {
+  if (cipher[kPending])
+    throw new errors.Error('ERR_CRYPTO_INVALID_STATE', method);
+}
+
 function getDecoder(decoder, encoding) {
   encoding = normalizeEncoding(encoding);
   decoder = decoder || new StringDecoder(encoding);
@@ -76,6 +87,8 @@ function Cipher(cipher, password, options) {
 
   this._handle.init(cipher, password);
   this._decoder = null;
+  this[kPending] = false;
+  this[kThreadpoolThreshold] = getThreadpoolThreshold(options);
 
   LazyTransform.call(this, options);
 }
@@ -83,6 +96,18 @@ function Cipher(cipher, password, options) {
 inherits(Cipher, LazyTransform);
 
 Cipher.prototype._transform = function _transform(chunk, encoding, callback) {
+  if (isArrayBufferView(chunk) &&
+      chunk.byteLength >= this[kThreadpoolThreshold]) {
+    this[kPending] = true;
+    this._handle.updateAsync(chunk, (err, ret) => {
+      this[kPending] = false;
+      if (err)
+        return callback(err);
+      this.push(ret);
+      callback();
+    });
+    return;
+  }
   this.push(this._handle.update(chunk, encoding));
   callback();
 };
@@ -98,6 +123,7 @@ Cipher.prototype._flush = function _flush(callback) {
 };
 
 Cipher.prototype.update = function update(data, inputEncoding, outputEncoding) {
+  assertNotPending(this, 'update');
   const encoding = getDefaultEncoding();
   inputEncoding = inputEncoding || encoding;
   outputEncoding = outputEncoding || encoding;
@@ -119,6 +145,7 @@ Cipher.prototype.update = function update(data, inputEncoding, outputEncoding) {
 
 
 Cipher.prototype.final = function final(outputEncoding) {
+  assertNotPending(this, 'final');
   outputEncoding = outputEncoding || getDefaultEncoding();
   const ret = this._handle.final();
 
@@ -132,12 +159,14 @@ Cipher.prototype.final = function final(outputEncoding) {
 
 
 Cipher.prototype.setAutoPadding = function setAutoPadding(ap) {
+  assertNotPending(this, 'setAutoPadding');
   if (this._handle.setAutoPadding(ap) === false)
     throw new errors.Error('ERR_CRYPTO_INVALID_STATE', 'setAutoPadding');
   return this;
 };
 
 Cipher.prototype.getAuthTag = function getAuthTag() {
+  assertNotPending(this, 'getAuthTag');
   const ret = this._handle.getAuthTag();
   if (ret === undefined)
     throw new errors.Error('ERR_CRYPTO_INVALID_STATE', 'getAuthTag');
@@ -150,6 +179,7 @@ Cipher.prototype.setAuthTag = function setAuthTag(tagbuf) {
     throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'buffer',
                                ['Buffer', 'TypedArray', 'DataView']);
   }
+  assertNotPending(this, 'setAuthTag');
   // Do not do a normal falsy check because the method returns
   // undefined if it succeeds. Returns false specifically if it
   // errored
@@ -163,6 +193,7 @@ Cipher.prototype.setAAD = function setAAD(aadbuf) {
     throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'buffer',
                                ['Buffer', 'TypedArray', 'DataView']);
   }
+  assertNotPending(this, 'setAAD');
   if (this._handle.setAAD(aadbuf) === false)
     throw new errors.Error('ERR_CRYPTO_INVALID_STATE', 'setAAD');
   return this;
@@ -190,6 +221,8 @@ function Cipheriv(cipher, key, iv, options) {
   this._handle = new CipherBase(true);
   this._handle.initiv(cipher, key, iv);
   this._decoder = null;
+  this[kPending] = false;
+  this[kThreadpoolThreshold] = getThreadpoolThreshold(options);
 
   LazyTransform.call(this, options);
 }
@@ -222,6 +255,8 @@ function Decipher(cipher, password, options) {
   this._handle = new CipherBase(false);
   this._handle.init(cipher, password);
   this._decoder = null;
+  this[kPending] = false;
+  this[kThreadpoolThreshold] = getThreadpoolThreshold(options);
 
   LazyTransform.call(this, options);
 }
@@ -261,6 +296,8 @@ function Decipheriv(cipher, key, iv, options) {
   this._handle = new CipherBase(false);
   this._handle.initiv(cipher, key, iv);
   this._decoder = null;
+  this[kPending] = false;
+  this[kThreadpoolThreshold] = getThreadpoolThreshold(options);
 
   LazyTransform.call(this, options);
 }
@@ -2,11 +2,14 @@
 
 const {
   Hash: _Hash,
-  Hmac: _Hmac
+  Hmac: _Hmac,
+  hash: _hash,
+  hashBatch: _hashBatch
 } = process.binding('crypto');
 
 const {
   getDefaultEncoding,
+  getThreadpoolThreshold,
   toBuf
 } = require('internal/crypto/util');
 
@@ -19,15 +22,20 @@ const { isArrayBufferView } = require('internal/util/types');
 const LazyTransform = require('internal/streams/lazy_transform');
 const kState = Symbol('state');
 const kFinalized = Symbol('finalized');
+const kPending = Symbol('pending');
+const kThreadpoolThreshold = Symbol('threadpoolThreshold');
 
 function Hash(algorithm, options) {
   if (!(this instanceof Hash))
     return new Hash(algorithm, options);
   if (typeof algorithm !== 'string')
     throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'algorithm', 'string');
+  const threshold = getThreadpoolThreshold(options);
   this._handle = new _Hash(algorithm);
   this[kState] = {
-    [kFinalized]: false
+    [kFinalized]: false,
+    [kPending]: false,
+    [kThreadpoolThreshold]: threshold
   };
   LazyTransform.call(this, options);
 }
@@ -35,6 +43,16 @@ function Hash(algorithm, options) {
 inherits(Hash, LazyTransform);
 
 Hash.prototype._transform = function _transform(chunk, encoding, callback) {
+  const state = this[kState];
+  if (isArrayBufferView(chunk) &&
+      chunk.byteLength >= state[kThreadpoolThreshold]) {
+    state[kPending] = true;
+    this._handle.updateAsync(chunk, (err) => {
+      state[kPending] = false;
+      callback(err);
+    });
+    return;
+  }
   this._handle.update(chunk, encoding);
   callback();
 };
@@ -48,6 +66,8 @@ Hash.prototype.update = function update(data, encoding) {
   const state = this[kState];
   if (state[kFinalized])
     throw new errors.Error('ERR_CRYPTO_HASH_FINALIZED');
+  if (state[kPending])
+    throw new errors.Error('ERR_CRYPTO_INVALID_STATE', 'update');
 
   if (typeof data !== 'string' && !isArrayBufferView(data)) {
     throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'data',
@@ -64,6 +84,8 @@ Hash.prototype.digest = function digest(outputEncoding) {
   const state = this[kState];
   if (state[kFinalized])
     throw new errors.Error('ERR_CRYPTO_HASH_FINALIZED');
+  if (state[kPending])
+    throw new errors.Error('ERR_CRYPTO_INVALID_STATE', 'digest');
   outputEncoding = outputEncoding || getDefaultEncoding();
   if (normalizeEncoding(outputEncoding) === 'utf16le')
     throw new errors.Error('ERR_CRYPTO_HASH_DIGEST_NO_UTF16');
@@ -114,9 +136,62 @@ Hmac.prototype.digest = function digest(outputEncoding) {
 };
 
 Hmac.prototype._flush = Hash.prototype._flush;
-Hmac.prototype._transform = Hash.prototype._transform;
+
+Hmac.prototype._transform = function _transform(chunk, encoding, callback) {
+  this._handle.update(chunk, encoding);
+  callback();
+};
+
+
+// One-shot variants of createHash(algorithm).update(data).digest() that do
+// not create a Hash object and reuse the native digest context.
+function hash(algorithm, data, outputEncoding) {
+  if (typeof algorithm !== 'string')
+    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'algorithm', 'string');
+  if (typeof data !== 'string' && !isArrayBufferView(data)) {
+    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'data',
+                               ['string', 'TypedArray', 'DataView']);
+  }
+  if (outputEncoding === undefined)
+    outputEncoding = 'hex';
+  else if (normalizeEncoding(outputEncoding) === 'utf16le')
+    throw new errors.Error('ERR_CRYPTO_HASH_DIGEST_NO_UTF16');
+
+  const ret = _hash(algorithm, data, `${outputEncoding}`);
+  if (ret === -1)
+    throw new errors.TypeError('ERR_CRYPTO_INVALID_DIGEST', algorithm);
+  return ret;
+}
+
+function hashBatch(algorithm, inputs, callback) {
+  if (typeof algorithm !== 'string')
+    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'algorithm', 'string');
+  if (!Array.isArray(inputs))
+    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'inputs', 'Array');
+  if (callback !== undefined && typeof callback !== 'function')
+    throw new errors.TypeError('ERR_INVALID_CALLBACK');
+
+  // Strings are encoded by the binding, all into a single allocation.  The
+  // copy keeps the views alive and unchanged until the hashes are done.
+  const values = new Array(inputs.length);
+  for (var i = 0; i < inputs.length; i++) {
+    const input = inputs[i];
+    if (typeof input !== 'string' && !isArrayBufferView(input)) {
+      throw new errors.TypeError('ERR_INVALID_ARG_TYPE', `inputs[${i}]`,
+                                 ['string', 'TypedArray', 'DataView']);
+    }
+    values[i] = input;
+  }
+
+  const ret = _hashBatch(algorithm, values, callback);
+  if (ret === -1)
+    throw new errors.TypeError('ERR_CRYPTO_INVALID_DIGEST', algorithm);
+  return ret;
+}
 
 module.exports = {
   Hash,
-  Hmac
+  Hmac,
+  hash,
+  hashBatch
 };
@@ -0,0 +1,77 @@
+'use strict';
+
+const {
+  KeyObject: _KeyObject
+} = process.binding('crypto');
+
+const { toBuf } = require('internal/crypto/util');
+
+const errors = require('internal/errors');
+const { isArrayBufferView } = require('internal/util/types');
+const kHandle = Symbol('handle');
+const kType = Symbol('type');
+
+// A key that is parsed once and can then be passed to sign(), verify() and
+// friends any number of times instead of its PEM encoding.
+class KeyObject {
+  constructor(type, handle) {
+    if (type !== 'private' && type !== 'public')
+      throw new errors.TypeError('ERR_INVALID_ARG_VALUE', 'type', type);
+    if (!(handle instanceof _KeyObject))
+      throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'handle', 'KeyObject');
+    this[kType] = type;
+    this[kHandle] = handle;
+  }
+
+  get type() {
+    return this[kType];
+  }
+}
+
+function parseKey(isPrivate, key, passphrase) {
+  key = toBuf(key);
+  if (!isArrayBufferView(key)) {
+    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'key',
+                               ['string', 'Buffer', 'TypedArray', 'DataView']);
+  }
+  if (passphrase != null && typeof passphrase !== 'string') {
+    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'passphrase',
+                               'string');
+  }
+  const handle = new _KeyObject();
+  handle.init(isPrivate, key, passphrase);
+  return handle;
+}
+
+function createPrivateKey(key) {
+  var passphrase;
+  if (key !== null && typeof key === 'object' && !isArrayBufferView(key)) {
+    passphrase = key.passphrase;
+    key = key.key;
+  }
+  return new KeyObject('private', parseKey(true, key, passphrase));
+}
+
+function createPublicKey(key) {
+  return new KeyObject('public', parseKey(false, key));
+}
+
+// Returns the native handle of |key|, which is either a KeyObject or a key
+// in PEM format that is parsed for this one use.
+function getKeyHandle(key, passphrase, isPrivate) {
+  if (key instanceof KeyObject) {
+    if (isPrivate && key.type !== 'private') {
+      throw new errors.TypeError('ERR_CRYPTO_INVALID_KEY_OBJECT_TYPE',
+                                 key.type, 'private');
+    }
+    return key[kHandle];
+  }
+  return parseKey(isPrivate, key, passphrase);
+}
+
+module.exports = {
+  KeyObject,
+  createPrivateKey,
+  createPublicKey,
+  getKeyHandle
+};
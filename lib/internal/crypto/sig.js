@@ -3,7 +3,9 @@
 const errors = require('internal/errors');
 const {
   Sign: _Sign,
-  Verify: _Verify
+  Verify: _Verify,
+  sign: _sign,
+  verify: _verify
 } = process.binding('crypto');
 const {
   RSA_PSS_SALTLEN_AUTO,
@@ -13,10 +15,32 @@ const {
   getDefaultEncoding,
   toBuf
 } = require('internal/crypto/util');
+const {
+  KeyObject,
+  getKeyHandle
+} = require('internal/crypto/keys');
 const { isArrayBufferView } = require('internal/util/types');
 const { Writable } = require('stream');
 const { inherits } = require('util');
 
+function getIntOption(name, defaultValue, options) {
+  if (options.hasOwnProperty(name)) {
+    const value = options[name];
+    if (value === value >> 0)
+      return value;
+    throw new errors.TypeError('ERR_INVALID_OPT_VALUE', name, value);
+  }
+  return defaultValue;
+}
+
+function getPadding(options) {
+  return getIntOption('padding', RSA_PKCS1_PADDING, options);
+}
+
+function getSaltLength(options) {
+  return getIntOption('saltLength', RSA_PSS_SALTLEN_AUTO, options);
+}
+
 function Sign(algorithm, options) {
   if (!(this instanceof Sign))
     return new Sign(algorithm, options);
@@ -54,34 +78,20 @@ Sign.prototype.sign = function sign(options, encoding) {
   var passphrase = options.passphrase || null;
 
   // Options specific to RSA
-  var rsaPadding = RSA_PKCS1_PADDING;
-  if (options.hasOwnProperty('padding')) {
-    if (options.padding === options.padding >> 0) {
-      rsaPadding = options.padding;
-    } else {
-      throw new errors.TypeError('ERR_INVALID_OPT_VALUE',
-                                 'padding',
-                                 options.padding);
-    }
-  }
-
-  var pssSaltLength = RSA_PSS_SALTLEN_AUTO;
-  if (options.hasOwnProperty('saltLength')) {
-    if (options.saltLength === options.saltLength >> 0) {
-      pssSaltLength = options.saltLength;
-    } else {
-      throw new errors.TypeError('ERR_INVALID_OPT_VALUE',
-                                 'saltLength',
-                                 options.saltLength);
+  var rsaPadding = getPadding(options);
+  var pssSaltLength = getSaltLength(options);
+
+  if (key instanceof KeyObject) {
+    key = getKeyHandle(key, null, true);
+  } else {
+    key = toBuf(key);
+    if (!isArrayBufferView(key)) {
+      throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'key',
+                                 ['string', 'Buffer', 'TypedArray',
+                                  'DataView']);
     }
   }
 
-  key = toBuf(key);
-  if (!isArrayBufferView(key)) {
-    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'key',
-                               ['string', 'Buffer', 'TypedArray', 'DataView']);
-  }
-
   var ret = this._handle.sign(key, passphrase, rsaPadding, pssSaltLength);
 
   encoding = encoding || getDefaultEncoding();
@@ -113,34 +123,20 @@ Verify.prototype.verify = function verify(options, signature, sigEncoding) {
   sigEncoding = sigEncoding || getDefaultEncoding();
 
   // Options specific to RSA
-  var rsaPadding = RSA_PKCS1_PADDING;
-  if (options.hasOwnProperty('padding')) {
-    if (options.padding === options.padding >> 0) {
-      rsaPadding = options.padding;
-    } else {
-      throw new errors.TypeError('ERR_INVALID_OPT_VALUE',
-                                 'padding',
-                                 options.padding);
-    }
-  }
-
-  var pssSaltLength = RSA_PSS_SALTLEN_AUTO;
-  if (options.hasOwnProperty('saltLength')) {
-    if (options.saltLength === options.saltLength >> 0) {
-      pssSaltLength = options.saltLength;
-    } else {
-      throw new errors.TypeError('ERR_INVALID_OPT_VALUE',
-                                 'saltLength',
-                                 options.saltLength);
+  var rsaPadding = getPadding(options);
+  var pssSaltLength = getSaltLength(options);
+
+  if (key instanceof KeyObject) {
+    key = getKeyHandle(key, null, false);
+  } else {
+    key = toBuf(key);
+    if (!isArrayBufferView(key)) {
+      throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'key',
+                                 ['string', 'Buffer', 'TypedArray',
+                                  'DataView']);
     }
   }
 
-  key = toBuf(key);
-  if (!isArrayBufferView(key)) {
-    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'key',
-                               ['string', 'Buffer', 'TypedArray', 'DataView']);
-  }
-
   signature = toBuf(signature, sigEncoding);
   if (!isArrayBufferView(signature)) {
     throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'signature',
@@ -150,7 +146,94 @@ Verify.prototype.verify = function verify(options, signature, sigEncoding) {
   return this._handle.verify(key, signature, rsaPadding, pssSaltLength);
 };
 
+// One-shot variants of createSign(algorithm).update(data).sign(key) and
+// createVerify(algorithm).update(data).verify(key, signature).  With a
+// callback, the work is done on the threadpool.  Passing a KeyObject instead
+// of a PEM encoded key saves parsing the key every time.
+function getData(data, name) {
+  data = toBuf(data);
+  if (!isArrayBufferView(data)) {
+    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', name,
+                               ['string', 'Buffer', 'TypedArray', 'DataView']);
+  }
+  return data;
+}
+
+function getSignature(signature, name) {
+  if (!isArrayBufferView(signature)) {
+    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', name,
+                               ['Buffer', 'TypedArray', 'DataView']);
+  }
+  return signature;
+}
+
+function checkArguments(algorithm, options, callback) {
+  if (typeof algorithm !== 'string')
+    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'algorithm', 'string');
+  if (!options)
+    throw new errors.Error('ERR_CRYPTO_SIGN_KEY_REQUIRED');
+  if (callback !== undefined && typeof callback !== 'function')
+    throw new errors.TypeError('ERR_INVALID_CALLBACK');
+}
+
+function sign(algorithm, data, options, callback) {
+  checkArguments(algorithm, options, callback);
+  data = getData(data, 'data');
+
+  const key = getKeyHandle(options.key || options,
+                           options.passphrase || null,
+                           true);
+  const ret = _sign(algorithm, data, key, getPadding(options),
+                    getSaltLength(options), callback);
+  if (ret === -1)
+    throw new errors.TypeError('ERR_CRYPTO_INVALID_DIGEST', algorithm);
+  return ret;
+}
+
+function verifyBatch(algorithm, options, data, signatures, callback) {
+  checkArguments(algorithm, options, callback);
+  if (!Array.isArray(data))
+    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'data', 'Array');
+  if (!Array.isArray(signatures)) {
+    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'signatures',
+                               'Array');
+  }
+  if (signatures.length !== data.length) {
+    throw new errors.TypeError('ERR_INVALID_ARRAY_LENGTH', 'signatures',
+                               data.length, signatures.length);
+  }
+
+  // The native side reads the buffers on the threadpool and keeps these
+  // arrays alive until it is done, so they must not be the caller's.
+  const buffers = new Array(data.length);
+  const sigs = new Array(data.length);
+  for (var i = 0; i < data.length; i++) {
+    buffers[i] = getData(data[i], `data[${i}]`);
+    sigs[i] = getSignature(signatures[i], `signatures[${i}]`);
+  }
+
+  const key = getKeyHandle(options.key || options, null, false);
+  const ret = _verify(algorithm, key, buffers, sigs,
+                      getPadding(options), getSaltLength(options), callback);
+  if (ret === -1)
+    throw new errors.TypeError('ERR_CRYPTO_INVALID_DIGEST', algorithm);
+  return ret;
+}
+
+function verify(algorithm, data, options, signature, callback) {
+  checkArguments(algorithm, options, callback);
+  data = [getData(data, 'data')];
+  const signatures = [getSignature(signature, 'signature')];
+  if (callback === undefined)
+    return verifyBatch(algorithm, options, data, signatures)[0];
+  verifyBatch(algorithm, options, data, signatures,
+              (err, results) => callback(err, results[0]));
+}
+
 module.exports = {
   Sign,
-  Verify
+  Verify,
+  sign,
+  verify,
+  verifyBatch
 };
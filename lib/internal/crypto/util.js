@@ -24,6 +24,12 @@ const {
 
 var defaultEncoding = 'buffer';
 
+// Buffers of at least this many bytes that are written to a cipher or hash
+// stream are processed on the threadpool instead of the main thread.  This
+// is opt-in, since it makes write() complete asynchronously, and code like
+// `hash.write(data); hash.digest()` relies on it being synchronous.
+const kDefaultThreadpoolThreshold = Infinity;
+
 function setDefaultEncoding(val) {
   defaultEncoding = val;
 }
@@ -79,11 +85,27 @@ function timingSafeEqual(a, b) {
   return _timingSafeEqual(a, b);
 }
 
+function getThreadpoolThreshold(options) {
+  if (options == null || options.threadpoolThreshold === undefined)
+    return kDefaultThreadpoolThreshold;
+  const threshold = options.threadpoolThreshold;
+  if (typeof threshold !== 'number') {
+    throw new errors.TypeError('ERR_INVALID_OPT_VALUE',
+                               'threadpoolThreshold', threshold);
+  }
+  if (!(threshold >= 0)) {
+    throw new errors.RangeError('ERR_INVALID_OPT_VALUE',
+                                'threadpoolThreshold', threshold);
+  }
+  return threshold;
+}
+
 module.exports = {
   getCiphers,
   getCurves,
   getDefaultEncoding,
   getHashes,
+  getThreadpoolThreshold,
   setDefaultEncoding,
   setEngine,
   timingSafeEqual,
@@ -1,21 +1,8 @@
 'use strict';
 
-const { setUnrefTimeout } = require('internal/timers');
-
-var dateCache;
-function utcDate() {
-  if (!dateCache) {
-    const d = new Date();
-    dateCache = d.toUTCString();
-
-    setUnrefTimeout(resetCache, 1000 - d.getMilliseconds());
-  }
-  return dateCache;
-}
-
-function resetCache() {
-  dateCache = undefined;
-}
+// Returns the value for the Date header.  It is formatted natively, once a
+// second, and shared by all HTTP and HTTP/2 responses.
+const { utcDate } = process.binding('http_serializer');
 
 function ondrain() {
   if (this._httpMessage) this._httpMessage.emit('drain');
@@ -31,6 +31,8 @@ const debug = util.debuglog('http2');
 const kMaxFrameSize = (2 ** 24) - 1;
 const kMaxInt = (2 ** 32) - 1;
 const kMaxStreams = (2 ** 31) - 1;
+const kMinWindowSize = 65535;
+const kMaxWindowSize = (2 ** 31) - 1;
 
 // eslint-disable-next-line no-control-regex
 const kQuotedString = /^[\x09\x20-\x5b\x5d-\x7e\x80-\xff]*$/;
@@ -166,7 +168,7 @@ function emit(self, ...args) {
 // create the associated Http2Stream instance and emit the 'stream'
 // event. If the stream is not new, emit the 'headers' event to pass
 // the block of headers on.
-function onSessionHeaders(handle, id, cat, flags, headers) {
+function onSessionHeaders(handle, id, cat, flags, headers, packed) {
   const session = this[kOwner];
   if (session.destroyed)
     return;
@@ -181,7 +183,7 @@ function onSessionHeaders(handle, id, cat, flags, headers) {
   let stream = streams.get(id);
 
   // Convert the array of header name value pairs into an object
-  const obj = toHeaderObject(headers);
+  const obj = toHeaderObject(headers, packed);
 
   if (stream === undefined) {
     if (session.closed) {
@@ -2466,6 +2468,8 @@ function initializeOptions(options) {
   assertIsObject(options, 'options');
   options = Object.assign({}, options);
   options.allowHalfOpen = true;
+  assertWithinRange('maxAdaptiveWindowSize', options.maxAdaptiveWindowSize,
+                    kMinWindowSize, kMaxWindowSize);
   assertIsObject(options.settings, 'options.settings');
   options.settings = Object.assign({}, options.settings);
   return options;
@@ -2559,6 +2563,8 @@ function connect(authority, options, listener) {
 
   assertIsObject(options, 'options');
   options = Object.assign({}, options);
+  assertWithinRange('maxAdaptiveWindowSize', options.maxAdaptiveWindowSize,
+                    kMinWindowSize, kMaxWindowSize);
 
   if (typeof authority === 'string')
     authority = new URL(authority);
@@ -160,6 +160,7 @@ const IDX_SESSION_STATE_REMOTE_WINDOW_SIZE = 5;
 const IDX_SESSION_STATE_OUTBOUND_QUEUE_SIZE = 6;
 const IDX_SESSION_STATE_HD_DEFLATE_DYNAMIC_TABLE_SIZE = 7;
 const IDX_SESSION_STATE_HD_INFLATE_DYNAMIC_TABLE_SIZE = 8;
+const IDX_SESSION_STATE_MEMORY_USAGE = 9;
 const IDX_STREAM_STATE = 0;
 const IDX_STREAM_STATE_WEIGHT = 1;
 const IDX_STREAM_STATE_SUM_DEPENDENCY_WEIGHT = 2;
@@ -176,7 +177,8 @@ const IDX_OPTIONS_MAX_HEADER_LIST_PAIRS = 5;
 const IDX_OPTIONS_MAX_OUTSTANDING_PINGS = 6;
 const IDX_OPTIONS_MAX_OUTSTANDING_SETTINGS = 7;
 const IDX_OPTIONS_MAX_SESSION_MEMORY = 8;
-const IDX_OPTIONS_FLAGS = 9;
+const IDX_OPTIONS_MAX_ADAPTIVE_WINDOW_SIZE = 9;
+const IDX_OPTIONS_FLAGS = 10;
 
 function updateOptionsBuffer(options) {
   var flags = 0;
@@ -225,6 +227,11 @@ function updateOptionsBuffer(options) {
     optionsBuffer[IDX_OPTIONS_MAX_SESSION_MEMORY] =
       Math.max(1, options.maxSessionMemory);
   }
+  if (typeof options.maxAdaptiveWindowSize === 'number') {
+    flags |= (1 << IDX_OPTIONS_MAX_ADAPTIVE_WINDOW_SIZE);
+    optionsBuffer[IDX_OPTIONS_MAX_ADAPTIVE_WINDOW_SIZE] =
+      options.maxAdaptiveWindowSize;
+  }
   optionsBuffer[IDX_OPTIONS_FLAGS] = flags;
 }
 
@@ -347,7 +354,9 @@ function getSessionState(session) {
     deflateDynamicTableSize:
       sessionState[IDX_SESSION_STATE_HD_DEFLATE_DYNAMIC_TABLE_SIZE],
     inflateDynamicTableSize:
-      sessionState[IDX_SESSION_STATE_HD_INFLATE_DYNAMIC_TABLE_SIZE]
+      sessionState[IDX_SESSION_STATE_HD_INFLATE_DYNAMIC_TABLE_SIZE],
+    memoryUsage:
+      sessionState[IDX_SESSION_STATE_MEMORY_USAGE]
   };
 }
 
@@ -495,11 +504,23 @@ function assertWithinRange(name, value, min = 0, max = Infinity) {
   }
 }
 
-function toHeaderObject(headers) {
+// `headers` is the flat [name, value, ...] array received from the native
+// layer. Values that are not in the HPACK static table are delivered as the
+// end offset of their bytes in `packed` instead, and are sliced out of it
+// here. The array is updated in place so that it can be handed out as the
+// raw headers afterwards.
+function toHeaderObject(headers, packed) {
   const obj = Object.create(null);
+  var start = 0;
   for (var n = 0; n < headers.length; n = n + 2) {
     var name = headers[n];
     var value = headers[n + 1];
+    if (typeof value === 'number') {
+      const end = value;
+      value = packed.slice(start, end);
+      headers[n + 1] = value;
+      start = end;
+    }
     if (name === HTTP2_HEADER_STATUS)
       value |= 0;
     var existing = obj[name];
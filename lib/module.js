@@ -25,6 +25,7 @@ const NativeModule = require('native_module');
 const util = require('util');
 const { decorateErrorStack } = require('internal/util');
 const internalModule = require('internal/module');
+const compileCache = require('internal/compile_cache');
 const { getURLFromFilePath } = require('internal/url');
 const vm = require('vm');
 const assert = require('assert').ok;
@@ -37,6 +38,10 @@ const {
 } = process.binding('fs');
 const preserveSymlinks = !!process.binding('config').preserveSymlinks;
 const experimentalModules = !!process.binding('config').experimentalModules;
+// In a frozen module tree, files are assumed not to appear, disappear or
+// change while the process runs, so resolution results are cached for good.
+const frozenModuleTree = process.env.NODE_FROZEN_MODULE_TREE === '1';
+const { UV_ENOENT } = process.binding('uv');
 
 const errors = require('internal/errors');
 
@@ -48,6 +53,9 @@ const ModuleJob = require('internal/loader/ModuleJob');
 const { createDynamicModule } = require('internal/loader/ModuleWrap');
 let ESMLoader;
 
+// Caches both hits and misses (negative errno values).  The cache only
+// exists for the duration of a top-level require() call unless the module
+// tree is frozen.
 function stat(filename) {
   filename = path.toNamespacedPath(filename);
   const cache = stat.cache;
@@ -59,7 +67,7 @@ function stat(filename) {
   if (cache !== null) cache.set(filename, result);
   return result;
 }
-stat.cache = null;
+stat.cache = frozenModuleTree ? new Map() : null;
 
 function updateChildren(parent, child, scan) {
   var children = parent && parent.children;
@@ -115,30 +123,42 @@ Module._debug = util.deprecate(debug, 'Module._debug is deprecated.',
 //   -> a/index.<ext>
 
 // check if the directory is a package.json dir
-const packageMainCache = Object.create(null);
+// Maps a directory to the "main" field of its package.json, or to false
+// when the package.json has none.
+const packageMainCache = new Map();
 
 function readPackage(requestPath) {
-  const entry = packageMainCache[requestPath];
-  if (entry)
+  const entry = packageMainCache.get(requestPath);
+  if (entry !== undefined)
     return entry;
 
   const jsonPath = path.resolve(requestPath, 'package.json');
-  const json = internalModuleReadJSON(path.toNamespacedPath(jsonPath));
+  const namespacedJsonPath = path.toNamespacedPath(jsonPath);
+  // A missing package.json is remembered like any other failed stat().
+  if (stat.cache !== null && stat.cache.get(namespacedJsonPath) < 0)
+    return false;
+
+  const json = internalModuleReadJSON(namespacedJsonPath);
 
   if (json === undefined) {
+    if (stat.cache !== null)
+      stat.cache.set(namespacedJsonPath, UV_ENOENT);
     return false;
   }
 
-  if (json === '')
-    return packageMainCache[requestPath] = undefined;
+  if (json === '') {
+    packageMainCache.set(requestPath, false);
+    return false;
+  }
 
   try {
-    var pkg = packageMainCache[requestPath] = JSON.parse(json).main;
+    var pkg = JSON.parse(json).main;
   } catch (e) {
     e.path = jsonPath;
     e.message = 'Error parsing ' + jsonPath + ': ' + e.message;
     throw e;
   }
+  packageMainCache.set(requestPath, pkg || false);
   return pkg;
 }
 
@@ -625,11 +645,17 @@ Module.prototype._compile = function(content, filename) {
   // create wrapper function
   var wrapper = Module.wrap(content);
 
-  var compiledWrapper = vm.runInThisContext(wrapper, {
+  var compileOptions = {
     filename: filename,
     lineOffset: 0,
     displayErrors: true
-  });
+  };
+  var script;
+  if (compileCache.isEnabled() && path.isAbsolute(filename))
+    script = compileCache.compile(vm.Script, wrapper, filename, compileOptions);
+  else
+    script = new vm.Script(wrapper, compileOptions);
+  var compiledWrapper = script.runInThisContext(compileOptions);
 
   var inspectorWrapper = null;
   if (process._breakFirstLine && process._eval == null) {
@@ -651,7 +677,7 @@ Module.prototype._compile = function(content, filename) {
   var dirname = path.dirname(filename);
   var require = internalModule.makeRequireFunction(this);
   var depth = internalModule.requireDepth;
-  if (depth === 0) stat.cache = new Map();
+  if (depth === 0 && !frozenModuleTree) stat.cache = new Map();
   var result;
   if (inspectorWrapper) {
     result = inspectorWrapper(compiledWrapper, this.exports, this.exports,
@@ -660,7 +686,7 @@ Module.prototype._compile = function(content, filename) {
     result = compiledWrapper.call(this.exports, this.exports, require, this,
                                   filename, dirname);
   }
-  if (depth === 0) stat.cache = null;
+  if (depth === 0 && !frozenModuleTree) stat.cache = null;
   return result;
 };
 
@@ -742,6 +768,41 @@ Module._initPaths = function() {
   Module.globalPaths = modulePaths.slice(0);
 };
 
+// Forgets cached resolution results for |filename| and everything below
+// it, or all of them when called without arguments.  Needed when files are
+// added or removed in a frozen module tree.
+Module.invalidateResolutionCache = function(filename) {
+  Module._pathCache = Object.create(null);
+  realpathCache.clear();
+
+  if (filename === undefined) {
+    packageMainCache.clear();
+    if (stat.cache !== null)
+      stat.cache.clear();
+    return;
+  }
+
+  if (typeof filename !== 'string') {
+    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'filename', 'string');
+  }
+
+  filename = path.resolve(filename);
+  const prefix = filename.endsWith(path.sep) ? filename : filename + path.sep;
+  for (const key of packageMainCache.keys()) {
+    const dir = path.resolve(key);
+    if (dir === filename || dir.startsWith(prefix))
+      packageMainCache.delete(key);
+  }
+  if (stat.cache !== null) {
+    const namespacedFilename = path.toNamespacedPath(filename);
+    const namespacedPrefix = path.toNamespacedPath(prefix);
+    for (const key of stat.cache.keys()) {
+      if (key === namespacedFilename || key.startsWith(namespacedPrefix))
+        stat.cache.delete(key);
+    }
+  }
+};
+
 Module._preloadModules = function(requests) {
   if (!Array.isArray(requests))
     return;
@@ -763,5 +824,7 @@ Module._preloadModules = function(requests) {
 
 Module._initPaths();
 
+compileCache.init(process.env.NODE_COMPILE_CACHE);
+
 // backwards compatibility
 Module.Module = Module;
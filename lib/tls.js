@@ -51,6 +51,11 @@ exports.getCiphers = internalUtil.cachedResult(
   () => internalUtil.filterDuplicateStrings(binding.getSSLCiphers(), true)
 );
 
+exports.getBufferMemoryUsage = function getBufferMemoryUsage() {
+  const [allocated, pooled] = binding.getBIOMemoryStats();
+  return { allocated, pooled };
+};
+
 // Convert protocols array into valid OpenSSL protocols list
 // ("\x06spdy/2\x08http/1.1\x08http/1.0")
 function convertProtocols(protocols) {
@@ -156,11 +156,9 @@ function flushCallback(level, strategy, callback) {
   }
 }
 
-// the Zlib class they all inherit from
-// This thing manages the queue of requests, and returns
-// true or false if there is anything in the queue when
-// you call the .write() method.
-function Zlib(opts, mode) {
+// Validates the options that are shared by the streams and the one-shot
+// convenience methods, and fills in the defaults.
+function zlibOptions(opts) {
   var chunkSize = Z_DEFAULT_CHUNK;
   var flush = Z_NO_FLUSH;
   var finishFlush = Z_FINISH;
@@ -170,11 +168,6 @@ function Zlib(opts, mode) {
   var strategy = Z_DEFAULT_STRATEGY;
   var dictionary;
 
-  if (typeof mode !== 'number')
-    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'mode', 'number');
-  if (mode < DEFLATE || mode > UNZIP)
-    throw new errors.RangeError('ERR_OUT_OF_RANGE', 'mode');
-
   if (opts) {
     chunkSize = opts.chunkSize;
     if (chunkSize !== undefined && chunkSize === chunkSize) {
@@ -261,13 +254,41 @@ function Zlib(opts, mode) {
                                    dictionary);
       }
     }
+  }
 
-    if (opts.encoding || opts.objectMode || opts.writableObjectMode) {
-      opts = _extend({}, opts);
-      opts.encoding = null;
-      opts.objectMode = false;
-      opts.writableObjectMode = false;
-    }
+  return {
+    chunkSize,
+    flush,
+    finishFlush,
+    windowBits,
+    level,
+    memLevel,
+    strategy,
+    dictionary
+  };
+}
+
+// the Zlib class they all inherit from
+// This thing manages the queue of requests, and returns
+// true or false if there is anything in the queue when
+// you call the .write() method.
+function Zlib(opts, mode) {
+  if (typeof mode !== 'number')
+    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'mode', 'number');
+  if (mode < DEFLATE || mode > UNZIP)
+    throw new errors.RangeError('ERR_OUT_OF_RANGE', 'mode');
+
+  const {
+    chunkSize, flush, finishFlush, windowBits, level, memLevel, strategy,
+    dictionary
+  } = zlibOptions(opts);
+
+  if (opts &&
+      (opts.encoding || opts.objectMode || opts.writableObjectMode)) {
+    opts = _extend({}, opts);
+    opts.encoding = null;
+    opts.objectMode = false;
+    opts.writableObjectMode = false;
   }
   Transform.call(this, opts);
   this.bytesRead = 0;
@@ -656,9 +677,270 @@ function Unzip(opts) {
 }
 inherits(Unzip, Zlib);
 
-function createConvenienceMethod(ctor, sync) {
+// Parallel (pigz-style) gzip, used by createGzip() when `parallel` is more
+// than 1.  The input is cut into blocks that are compressed independently on
+// the threadpool, up to `parallel` at a time, each primed with the last
+// 32 KiB of the block before it.  The resulting raw deflate streams are
+// emitted in order between a gzip header and a trailer whose CRC32 is
+// combined from the per-block ones.
+const kParallelBlockSize = 128 * 1024;
+const kParallelDictionarySize = 32 * 1024;
+// ID1, ID2, CM (deflate), FLG, MTIME (4), XFL, OS (Unix)
+const kGzipHeader = [0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 3];
+
+function ParallelGzip(opts) {
+  if (!(this instanceof ParallelGzip))
+    return new ParallelGzip(opts);
+
+  const parallel = opts.parallel;
+  if (!Number.isInteger(parallel) || parallel < 1) {
+    throw new errors.RangeError('ERR_INVALID_OPT_VALUE',
+                                'parallel', parallel);
+  }
+
+  const { level, memLevel, strategy } = zlibOptions(opts);
+
+  if (opts.encoding || opts.objectMode || opts.writableObjectMode) {
+    opts = _extend({}, opts);
+    opts.encoding = null;
+    opts.objectMode = false;
+    opts.writableObjectMode = false;
+  }
+
+  Transform.call(this, opts);
+  this.bytesRead = 0;
+  this._level = level;
+  this._memLevel = memLevel;
+  this._strategy = strategy;
+  this._parallel = parallel;
+  this._chunk = null;  // The chunk being written, if not yet fully copied.
+  this._chunkOffset = 0;
+  this._pending = null;  // The block being filled.
+  this._pendingLength = 0;
+  this._dictionary = undefined;
+  this._blocks = [];  // Blocks being compressed, in stream order.
+  this._crc = 0;
+  this._size = 0;
+  this._headerPushed = false;
+  this._transformCallback = null;
+  this._flushCallback = null;
+  this._hadError = false;
+  this._closed = false;
+  this.once('end', this.close);
+}
+inherits(ParallelGzip, Transform);
+
+ParallelGzip.prototype._transform = function(chunk, encoding, cb) {
+  this.bytesRead += chunk.length;
+  this._chunk = chunk;
+  this._chunkOffset = 0;
+  this._transformCallback = cb;
+  consumeChunk(this);
+};
+
+ParallelGzip.prototype._flush = function(cb) {
+  const input = this._pending === null ?
+    Buffer.alloc(0) : this._pending.slice(0, this._pendingLength);
+  this._pending = null;
+  this._pendingLength = 0;
+  this._flushCallback = cb;
+  submitBlock(this, input, true);
+};
+
+ParallelGzip.prototype.close = function(callback) {
+  if (callback)
+    process.nextTick(callback);
+
+  if (this._closed)
+    return;
+
+  this._closed = true;
+  process.nextTick(emitCloseNT, this);
+};
+
+// Copies the chunk being written into blocks of its own, because the blocks
+// are compressed after the write callback has been called and the caller is
+// free to reuse the chunk from then on.  Full blocks are submitted, but no
+// more than `parallel` of them at a time; the rest of the chunk waits for
+// one of them to finish.
+function consumeChunk(self) {
+  const chunk = self._chunk;
+  while (self._chunkOffset < chunk.length) {
+    if (self._pending === null) {
+      if (self._blocks.length >= self._parallel)
+        return;
+      self._pending = Buffer.allocUnsafe(kParallelBlockSize);
+      self._pendingLength = 0;
+    }
+    const copied = chunk.copy(self._pending, self._pendingLength,
+                              self._chunkOffset);
+    self._pendingLength += copied;
+    self._chunkOffset += copied;
+    if (self._pendingLength === kParallelBlockSize) {
+      submitBlock(self, self._pending, false);
+      self._pending = null;
+    }
+  }
+
+  self._chunk = null;
+  const cb = self._transformCallback;
+  self._transformCallback = null;
+  cb();
+}
+
+function submitBlock(self, input, last) {
+  const block = { input, output: null, crc: 0, done: false };
+  const req = new binding.DeflateBlockWrap();
+  req.oncomplete = afterDeflateBlock;
+  req.stream = self;
+  req.block = block;
+  // Keeps the dictionary alive until the block has been compressed.
+  req.dictionary = self._dictionary;
+  self._blocks.push(block);
+  binding.deflateBlock(input,
+                       self._dictionary,
+                       self._level,
+                       self._memLevel,
+                       self._strategy,
+                       last,
+                       req);
+  if (!last)
+    self._dictionary = input.slice(input.length - kParallelDictionarySize);
+}
+
+function afterDeflateBlock(errno, output, crc) {
+  const self = this.stream;
+  if (self._closed || self._hadError || self.destroyed)
+    return;
+
+  if (errno) {
+    self._hadError = true;
+    const error = new Error('zlib: failed to deflate block');
+    error.errno = errno;
+    error.code = codes[errno];
+    // Whoever is waiting for the stream reports the error.
+    const cb = self._transformCallback || self._flushCallback;
+    self._chunk = null;
+    self._transformCallback = null;
+    self._flushCallback = null;
+    if (cb !== null)
+      cb(error);
+    else
+      self.emit('error', error);
+    return;
+  }
+
+  const block = this.block;
+  block.output = output;
+  block.crc = crc;
+  block.done = true;
+
+  const blocks = self._blocks;
+  while (blocks.length > 0 && blocks[0].done) {
+    const next = blocks.shift();
+    if (!self._headerPushed) {
+      self._headerPushed = true;
+      self.push(Buffer.from(kGzipHeader));
+    }
+    self._crc = binding.crc32Combine(self._crc, next.crc, next.input.length);
+    self._size += next.input.length;
+    self.push(next.output);
+  }
+
+  if (self._chunk !== null && blocks.length < self._parallel)
+    consumeChunk(self);
+
+  if (self._flushCallback !== null && blocks.length === 0) {
+    const trailer = Buffer.allocUnsafe(8);
+    trailer.writeUInt32LE(self._crc, 0);
+    trailer.writeUInt32LE(self._size % 0x100000000, 4);
+    self.push(trailer);
+    const cb = self._flushCallback;
+    self._flushCallback = null;
+    cb();
+  }
+}
+
+function createGzip(options) {
+  if (options && options.parallel !== undefined && options.parallel !== 1)
+    return new ParallelGzip(options);
+  return new Gzip(options);
+}
+
+// Returns |buffer| as something the one-shot binding accepts, or undefined
+// if it is left to the stream to reject it.
+function oneShotInput(buffer) {
+  if (typeof buffer === 'string')
+    return Buffer.from(buffer);
+  if (isArrayBufferView(buffer))
+    return buffer;
+  if (isAnyArrayBuffer(buffer))
+    return Buffer.from(buffer);
+}
+
+function oneShotError(message, errno) {
+  const error = new Error(message);
+  error.errno = errno;
+  error.code = codes[errno];
+  return error;
+}
+
+function oneShotOnComplete(message, errno, result) {
+  const callback = this.callback;
+  if (message !== null)
+    callback(oneShotError(message, errno));
+  else if (result === undefined)
+    callback(new errors.RangeError('ERR_BUFFER_TOO_LARGE'));
+  else
+    callback(null, result);
+}
+
+// Compresses or decompresses all of |input| with a single native call that
+// writes into a single output buffer, instead of going through the stream
+// machinery.  The work is done on the threadpool unless |callback| is
+// undefined.
+function zlibOneShot(mode, input, opts, callback) {
+  const {
+    finishFlush, windowBits, level, memLevel, strategy, dictionary
+  } = zlibOptions(opts);
+
+  var req;
+  var ctx;
+  if (callback !== undefined) {
+    req = new binding.ZlibOneShotWrap();
+    req.oncomplete = oneShotOnComplete;
+    req.callback = callback;
+    // Keep the memory alive while the threadpool is working on it.
+    req.input = input;
+    req.dictionary = dictionary;
+  } else {
+    ctx = {};
+  }
+
+  const result = binding.oneShot(mode, input, windowBits, level, memLevel,
+                                 strategy, dictionary, finishFlush,
+                                 kMaxLength, req, ctx);
+  if (result === false)
+    throw new errors.Error('ERR_ZLIB_INITIALIZATION_FAILED');
+  if (ctx === undefined)
+    return;
+  if (ctx.message !== undefined) {
+    const error = oneShotError(ctx.message, ctx.errno);
+    throw error;
+  }
+  if (result === undefined)
+    throw new errors.RangeError('ERR_BUFFER_TOO_LARGE');
+  return result;
+}
+
+// The `info` option asks for the engine that did the work, which is only
+// available when going through a stream.
+function createConvenienceMethod(ctor, mode, sync) {
   if (sync) {
     return function(buffer, opts) {
+      const input = oneShotInput(buffer);
+      if (input !== undefined && !(opts && opts.info))
+        return zlibOneShot(mode, input, opts);
       return zlibBufferSync(new ctor(opts), buffer);
     };
   } else {
@@ -667,6 +949,11 @@ function createConvenienceMethod(ctor, sync) {
         callback = opts;
         opts = {};
       }
+      const input = oneShotInput(buffer);
+      if (input !== undefined && !(opts && opts.info) &&
+          typeof callback === 'function') {
+        return zlibOneShot(mode, input, opts, callback);
+      }
       return zlibBuffer(new ctor(opts), buffer, callback);
     };
   }
@@ -682,6 +969,20 @@ function createProperty(ctor) {
   };
 }
 
+// Sets how many idle zlib contexts are kept for reuse by later streams with
+// the same parameters, and returns the previous limit.
+function setContextPoolSize(size) {
+  if (typeof size !== 'number') {
+    throw new errors.TypeError('ERR_INVALID_ARG_TYPE', 'size', 'number',
+                               size);
+  }
+  if (!Number.isInteger(size) || size < 0 || size > 0xffffffff) {
+    throw new errors.RangeError('ERR_OUT_OF_RANGE', 'size',
+                                '>= 0 and <= 4294967295', size);
+  }
+  return binding.setContextPoolSize(size);
+}
+
 module.exports = {
   Deflate,
   Inflate,
@@ -693,20 +994,22 @@ module.exports = {
 
   // Convenience methods.
   // compress/decompress a string or buffer in one step.
-  deflate: createConvenienceMethod(Deflate, false),
-  deflateSync: createConvenienceMethod(Deflate, true),
-  gzip: createConvenienceMethod(Gzip, false),
-  gzipSync: createConvenienceMethod(Gzip, true),
-  deflateRaw: createConvenienceMethod(DeflateRaw, false),
-  deflateRawSync: createConvenienceMethod(DeflateRaw, true),
-  unzip: createConvenienceMethod(Unzip, false),
-  unzipSync: createConvenienceMethod(Unzip, true),
-  inflate: createConvenienceMethod(Inflate, false),
-  inflateSync: createConvenienceMethod(Inflate, true),
-  gunzip: createConvenienceMethod(Gunzip, false),
-  gunzipSync: createConvenienceMethod(Gunzip, true),
-  inflateRaw: createConvenienceMethod(InflateRaw, false),
-  inflateRawSync: createConvenienceMethod(InflateRaw, true)
+  deflate: createConvenienceMethod(Deflate, DEFLATE, false),
+  deflateSync: createConvenienceMethod(Deflate, DEFLATE, true),
+  gzip: createConvenienceMethod(Gzip, GZIP, false),
+  gzipSync: createConvenienceMethod(Gzip, GZIP, true),
+  deflateRaw: createConvenienceMethod(DeflateRaw, DEFLATERAW, false),
+  deflateRawSync: createConvenienceMethod(DeflateRaw, DEFLATERAW, true),
+  unzip: createConvenienceMethod(Unzip, UNZIP, false),
+  unzipSync: createConvenienceMethod(Unzip, UNZIP, true),
+  inflate: createConvenienceMethod(Inflate, INFLATE, false),
+  inflateSync: createConvenienceMethod(Inflate, INFLATE, true),
+  gunzip: createConvenienceMethod(Gunzip, GUNZIP, false),
+  gunzipSync: createConvenienceMethod(Gunzip, GUNZIP, true),
+  inflateRaw: createConvenienceMethod(InflateRaw, INFLATERAW, false),
+  inflateRawSync: createConvenienceMethod(InflateRaw, INFLATERAW, true),
+
+  setContextPoolSize
 };
 
 Object.defineProperties(module.exports, {
@@ -714,7 +1017,11 @@ Object.defineProperties(module.exports, {
   createInflate: createProperty(Inflate),
   createDeflateRaw: createProperty(DeflateRaw),
   createInflateRaw: createProperty(InflateRaw),
-  createGzip: createProperty(Gzip),
+  createGzip: {
+    configurable: true,
+    enumerable: true,
+    value: createGzip
+  },
   createGunzip: createProperty(Gunzip),
   createUnzip: createProperty(Unzip),
   constants: {
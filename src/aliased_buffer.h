@@ -137,6 +137,20 @@ class AliasedBuffer {
       return *this = static_cast<NativeT>(val);
     }
 
+    template <typename T>
+    inline Reference& operator+=(const T& val) {
+      const T current = static_cast<T>(*this);
+      aliased_buffer_->SetValue(index_, current + val);
+      return *this;
+    }
+
+    template <typename T>
+    inline Reference& operator-=(const T& val) {
+      const T current = static_cast<T>(*this);
+      aliased_buffer_->SetValue(index_, current - val);
+      return *this;
+    }
+
     operator NativeT() const {
       return aliased_buffer_->GetValue(index_);
     }
@@ -3,6 +3,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include "string_bytes_simd.h"
 #include "util.h"
 
 #include <stddef.h>
@@ -83,6 +84,15 @@ bool base64_decode_group_slow(char* const dst, const size_t dstlen,
 }
 
 
+// Only one-byte input has a vectorized decoder, see base64_decode_simd().
+template <typename TypeName>
+inline size_t base64_decode_simd(char* const dst, const size_t dlen,
+                                 const TypeName* const src,
+                                 const size_t slen) {
+  return 0;
+}
+
+
 template <typename TypeName>
 size_t base64_decode_fast(char* const dst, const size_t dstlen,
                           const TypeName* const src, const size_t srclen,
@@ -90,8 +100,8 @@ size_t base64_decode_fast(char* const dst, const size_t dstlen,
   const size_t available = dstlen < decoded_size ? dstlen : decoded_size;
   const size_t max_k = available / 3 * 3;
   size_t max_i = srclen / 4 * 4;
-  size_t i = 0;
-  size_t k = 0;
+  size_t i = base64_decode_simd(dst, max_k, src, srclen);
+  size_t k = i / 4 * 3;
   while (i < max_i && k < max_k) {
     const uint32_t v =
         unbase64(src[i + 0]) << 24 |
@@ -146,8 +156,8 @@ static size_t base64_encode(const char* src,
                               "abcdefghijklmnopqrstuvwxyz"
                               "0123456789+/";
 
-  i = 0;
-  k = 0;
+  i = base64_encode_simd(src, slen, dst);
+  k = i / 3 * 4;
   n = slen / 3 * 3;
 
   while (i < n) {
@@ -301,7 +301,9 @@ inline Environment::Environment(IsolateData* isolate_data,
       inspector_agent_(new inspector::Agent(this)),
 #endif
       handle_cleanup_waiting_(0),
-      http_parser_buffer_(nullptr),
+      http_date_cache_(this),
+      slab_allocator_stats_(isolate_, IDX_SLAB_STATS_COUNT),
+      zlib_context_pool_(this),
       fs_stats_field_array_(nullptr),
       context_(context->GetIsolate(), context) {
   // We'll be creating new objects so make sure we've entered the context.
@@ -356,7 +358,6 @@ inline Environment::~Environment() {
 
   delete[] heap_statistics_buffer_;
   delete[] heap_space_statistics_buffer_;
-  delete[] http_parser_buffer_;
   free(performance_state_);
 }
 
@@ -508,13 +509,15 @@ inline void Environment::set_heap_space_statistics_buffer(double* pointer) {
   heap_space_statistics_buffer_ = pointer;
 }
 
-inline char* Environment::http_parser_buffer() const {
-  return http_parser_buffer_;
+inline Environment::HttpHeaderIndexBuffer*
+Environment::http_parser_header_indices() const {
+  return http_parser_header_indices_.get();
 }
 
-inline void Environment::set_http_parser_buffer(char* buffer) {
-  CHECK_EQ(http_parser_buffer_, nullptr);  // Should be set only once.
-  http_parser_buffer_ = buffer;
+inline void Environment::set_http_parser_header_indices(
+    std::unique_ptr<HttpHeaderIndexBuffer> buffer) {
+  CHECK(!http_parser_header_indices_);  // Should be set only once.
+  http_parser_header_indices_ = std::move(buffer);
 }
 
 inline http2::http2_state* Environment::http2_state() const {
@@ -527,6 +530,19 @@ inline void Environment::set_http2_state(
   http2_state_ = std::move(buffer);
 }
 
+inline HttpDateCache* Environment::http_date_cache() {
+  return &http_date_cache_;
+}
+
+inline AliasedBuffer<double, v8::Float64Array>&
+Environment::slab_allocator_stats() {
+  return slab_allocator_stats_;
+}
+
+inline ZlibContextPool* Environment::zlib_context_pool() {
+  return &zlib_context_pool_;
+}
+
 inline double* Environment::fs_stats_field_array() const {
   return fs_stats_field_array_;
 }
@@ -36,6 +36,9 @@
 #include "v8.h"
 #include "node.h"
 #include "node_http2_state.h"
+#include "http_date_cache.h"
+#include "slab_allocator.h"
+#include "zlib_context_pool.h"
 
 #include <list>
 #include <map>
@@ -284,7 +287,10 @@ class ModuleWrap;
   V(binding_cache_object, v8::Object)                                         \
   V(internal_binding_cache_object, v8::Object)                                \
   V(buffer_prototype_object, v8::Object)                                      \
+  V(cipherupdate_constructor_template, v8::ObjectTemplate)                    \
   V(context, v8::Context)                                                     \
+  V(hashbatch_constructor_template, v8::ObjectTemplate)                       \
+  V(hashupdate_constructor_template, v8::ObjectTemplate)                      \
   V(host_import_module_dynamically_callback, v8::Function)                    \
   V(http2ping_constructor_template, v8::ObjectTemplate)                       \
   V(http2stream_constructor_template, v8::ObjectTemplate)                     \
@@ -304,6 +310,7 @@ class ModuleWrap;
   V(script_context_constructor_template, v8::FunctionTemplate)                \
   V(script_data_constructor_function, v8::Function)                           \
   V(secure_context_constructor_template, v8::FunctionTemplate)                \
+  V(signrequest_constructor_template, v8::ObjectTemplate)                     \
   V(tcp_constructor_template, v8::FunctionTemplate)                           \
   V(tick_callback_function, v8::Function)                                     \
   V(tls_wrap_constructor_function, v8::Function)                              \
@@ -311,6 +318,7 @@ class ModuleWrap;
   V(udp_constructor_function, v8::Function)                                   \
   V(vm_parsing_context_symbol, v8::Symbol)                                    \
   V(url_constructor_function, v8::Function)                                   \
+  V(verifyrequest_constructor_template, v8::ObjectTemplate)                   \
   V(write_wrap_constructor_function, v8::Function)                            \
 
 class Environment;
@@ -336,6 +344,9 @@ class IsolateData {
 #undef VP
 
   std::unordered_map<nghttp2_rcbuf*, v8::Eternal<v8::String>> http2_static_strs;
+  // Internalized names of the headers that the HTTP/1 parser knows about,
+  // created on first use.  See node_http_parser.cc.
+  std::vector<v8::Eternal<v8::String>> http_known_header_strs;
   inline v8::Isolate* isolate() const;
 
  private:
@@ -598,12 +609,18 @@ class Environment {
   inline double* heap_space_statistics_buffer() const;
   inline void set_heap_space_statistics_buffer(double* pointer);
 
-  inline char* http_parser_buffer() const;
-  inline void set_http_parser_buffer(char* buffer);
+  typedef AliasedBuffer<uint8_t, v8::Uint8Array> HttpHeaderIndexBuffer;
+  inline HttpHeaderIndexBuffer* http_parser_header_indices() const;
+  inline void set_http_parser_header_indices(
+      std::unique_ptr<HttpHeaderIndexBuffer> buffer);
 
   inline http2::http2_state* http2_state() const;
   inline void set_http2_state(std::unique_ptr<http2::http2_state> state);
 
+  inline HttpDateCache* http_date_cache();
+  inline AliasedBuffer<double, v8::Float64Array>& slab_allocator_stats();
+  inline ZlibContextPool* zlib_context_pool();
+
   inline double* fs_stats_field_array() const;
   inline void set_fs_stats_field_array(double* fields);
 
@@ -758,9 +775,13 @@ class Environment {
   double* heap_statistics_buffer_ = nullptr;
   double* heap_space_statistics_buffer_ = nullptr;
 
-  char* http_parser_buffer_;
+  std::unique_ptr<HttpHeaderIndexBuffer> http_parser_header_indices_;
   std::unique_ptr<http2::http2_state> http2_state_;
 
+  HttpDateCache http_date_cache_;
+  AliasedBuffer<double, v8::Float64Array> slab_allocator_stats_;
+  ZlibContextPool zlib_context_pool_;
+
   double* fs_stats_field_array_;
 
   struct AtExitCallback {
@@ -0,0 +1,130 @@
+#include "http_date_cache.h"
+#include "env-inl.h"
+#include "util-inl.h"
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <stdio.h>
+
+namespace node {
+
+using v8::HandleScope;
+using v8::Isolate;
+using v8::Local;
+using v8::String;
+
+// Owns the bytes of one date string.  V8 deletes it when the string that
+// was created from it has been collected.
+class HttpDateCache::Resource : public String::ExternalOneByteStringResource {
+ public:
+  explicit Resource(int64_t seconds);
+
+  const char* data() const override { return data_; }
+  size_t length() const override { return kLength; }
+
+ private:
+  char data_[kLength + 1];
+};
+
+
+HttpDateCache::Resource::Resource(int64_t seconds) {
+  static const char kWeekDays[][4] = {
+    "Thu", "Fri", "Sat", "Sun", "Mon", "Tue", "Wed"  // 1970-01-01 was a Thu.
+  };
+  static const char kMonths[][4] = {
+    "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+    "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+  };
+
+  const int64_t days = seconds / 86400;
+  const int64_t secs = seconds % 86400;
+
+  // Converts days since the epoch to a date in the proleptic Gregorian
+  // calendar, in eras of 400 years that start on March 1st.
+  const int64_t z = days + 719468;
+  const int64_t era = z / 146097;
+  const int64_t doe = z - era * 146097;
+  const int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const int64_t mp = (5 * doy + 2) / 153;
+  const int64_t day = doy - (153 * mp + 2) / 5 + 1;
+  const int64_t month = mp < 10 ? mp + 3 : mp - 9;
+  const int64_t year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+
+  snprintf(data_, sizeof(data_), "%s, %02d %s %04d %02d:%02d:%02d GMT",
+           kWeekDays[days % 7],
+           static_cast<int>(day),
+           kMonths[month - 1],
+           static_cast<int>(year),
+           static_cast<int>(secs / 3600),
+           static_cast<int>(secs / 60 % 60),
+           static_cast<int>(secs % 60));
+}
+
+
+HttpDateCache::HttpDateCache(Environment* env) : env_(env) {
+}
+
+
+const char* HttpDateCache::data() {
+  Refresh();
+  return current_->data();
+}
+
+
+Local<String> HttpDateCache::GetString() {
+  Refresh();
+  return string_.Get(env_->isolate());
+}
+
+
+void HttpDateCache::Refresh() {
+  used_ = true;
+  if (!timer_active_)
+    Update();
+}
+
+
+void HttpDateCache::Update() {
+  if (!timer_initialized_) {
+    CHECK_EQ(0, uv_timer_init(env_->event_loop(), &timer_));
+    uv_unref(reinterpret_cast<uv_handle_t*>(&timer_));
+    env_->RegisterHandleCleanup(
+        reinterpret_cast<uv_handle_t*>(&timer_),
+        [](Environment* env, uv_handle_t* handle, void* arg) {
+          handle->data = env;
+          uv_close(handle, [](uv_handle_t* handle) {
+            Environment* env = static_cast<Environment*>(handle->data);
+            env->FinishHandleCleanup(handle);
+          });
+        },
+        nullptr);
+    timer_initialized_ = true;
+  }
+
+  const int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+
+  Isolate* isolate = env_->isolate();
+  HandleScope handle_scope(isolate);
+  current_ = new Resource(now / 1000);
+  string_.Reset(isolate,
+                String::NewExternalOneByte(isolate, current_).ToLocalChecked());
+
+  // Wake up right after the next second boundary.
+  uv_timer_start(&timer_, OnTimer, 1000 - now % 1000 + 1, 0);
+  timer_active_ = true;
+}
+
+
+void HttpDateCache::OnTimer(uv_timer_t* timer) {
+  HttpDateCache* cache = ContainerOf(&HttpDateCache::timer_, timer);
+  if (!cache->used_) {
+    // Nobody needed the date for a second, let the next caller refresh it.
+    cache->timer_active_ = false;
+    return;
+  }
+  cache->used_ = false;
+  cache->Update();
+}
+
+}  // namespace node
@@ -0,0 +1,54 @@
+#ifndef SRC_HTTP_DATE_CACHE_H_
+#define SRC_HTTP_DATE_CACHE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "util.h"
+#include "uv.h"
+#include "v8.h"
+
+namespace node {
+
+class Environment;
+
+// The current time formatted for the HTTP Date header, e.g.
+// "Sun, 06 Nov 1994 08:49:37 GMT".  The HTTP and HTTP/2 response paths ask
+// for it for almost every response, so it is formatted only once a second,
+// by an unreferenced timer that fires at every second boundary.  The timer
+// stops when nobody has asked for the date during a whole second and is
+// restarted by the next request for it.
+//
+// To JS, the date is handed out as an external one-byte string, the same
+// string for as long as the second lasts.
+class HttpDateCache {
+ public:
+  static const size_t kLength = 29;
+
+  explicit HttpDateCache(Environment* env);
+
+  const char* data();
+  v8::Local<v8::String> GetString();
+
+ private:
+  class Resource;
+
+  void Refresh();
+  void Update();
+  static void OnTimer(uv_timer_t* timer);
+
+  Environment* const env_;
+  uv_timer_t timer_;
+  bool timer_initialized_ = false;
+  bool timer_active_ = false;
+  bool used_ = false;
+  Resource* current_ = nullptr;
+  v8::Global<v8::String> string_;
+
+  DISALLOW_COPY_AND_ASSIGN(HttpDateCache);
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_HTTP_DATE_CACHE_H_
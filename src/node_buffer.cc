@@ -79,6 +79,7 @@ using v8::Maybe;
 using v8::MaybeLocal;
 using v8::Object;
 using v8::Persistent;
+using v8::SharedArrayBuffer;
 using v8::String;
 using v8::Uint32Array;
 using v8::Uint8Array;
@@ -1160,6 +1161,28 @@ void Swap64(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Used in buffer.isUtf8(). Accepts an ArrayBufferView or an ArrayBuffer.
+static void IsUtf8(const FunctionCallbackInfo<Value>& args) {
+  const char* data;
+  size_t length;
+  if (args[0]->IsArrayBuffer()) {
+    ArrayBuffer::Contents contents = args[0].As<ArrayBuffer>()->GetContents();
+    data = static_cast<const char*>(contents.Data());
+    length = contents.ByteLength();
+  } else if (args[0]->IsSharedArrayBuffer()) {
+    SharedArrayBuffer::Contents contents =
+        args[0].As<SharedArrayBuffer>()->GetContents();
+    data = static_cast<const char*>(contents.Data());
+    length = contents.ByteLength();
+  } else {
+    SPREAD_BUFFER_ARG(args[0], input);
+    data = input_data;
+    length = input_length;
+  }
+  args.GetReturnValue().Set(StringBytes::IsValidUtf8(data, length));
+}
+
+
 // Encode a single string to a UTF-8 Uint8Array (not Buffer).
 // Used in TextEncoder.prototype.encode.
 static void EncodeUtf8String(const FunctionCallbackInfo<Value>& args) {
@@ -1243,6 +1266,7 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "swap64", Swap64);
 
   env->SetMethod(target, "encodeUtf8String", EncodeUtf8String);
+  env->SetMethod(target, "isUtf8", IsUtf8);
 
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "kMaxLength"),
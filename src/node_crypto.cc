@@ -98,6 +98,7 @@ using v8::Local;
 using v8::Maybe;
 using v8::MaybeLocal;
 using v8::Null;
+using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::Persistent;
@@ -3589,6 +3590,7 @@ void CipherBase::Initialize(Environment* env, Local<Object> target) {
   env->SetProtoMethod(t, "init", Init);
   env->SetProtoMethod(t, "initiv", InitIv);
   env->SetProtoMethod(t, "update", Update);
+  env->SetProtoMethod(t, "updateAsync", UpdateAsync);
   env->SetProtoMethod(t, "final", Final);
   env->SetProtoMethod(t, "setAutoPadding", SetAutoPadding);
   env->SetProtoMethod(t, "getAuthTag", GetAuthTag);
@@ -3889,6 +3891,119 @@ void CipherBase::Update(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Runs a CipherBase::Update() on the threadpool.  The request's object keeps
+// the cipher and the input alive until the update has completed.
+class CipherUpdateRequest : public AsyncWrap {
+ public:
+  CipherUpdateRequest(Environment* env,
+                      Local<Object> object,
+                      CipherBase* cipher,
+                      const char* data,
+                      int len)
+      : AsyncWrap(env, object, AsyncWrap::PROVIDER_CIPHERREQUEST),
+        cipher_(cipher),
+        data_(data),
+        len_(len),
+        out_(nullptr),
+        out_len_(0),
+        success_(false),
+        error_(0) {
+    Wrap(object, this);
+  }
+
+  ~CipherUpdateRequest() override {
+    free(out_);
+    out_ = nullptr;
+    ClearWrap(object());
+    persistent().Reset();
+  }
+
+  uv_work_t* work_req() {
+    return &work_req_;
+  }
+
+  size_t self_size() const override { return sizeof(*this); }
+
+  static void Work(uv_work_t* work_req);
+  static void After(uv_work_t* work_req, int status);
+
+ private:
+  uv_work_t work_req_;
+  CipherBase* const cipher_;
+  const char* const data_;
+  const int len_;
+  unsigned char* out_;
+  int out_len_;
+  bool success_;
+  unsigned long error_;  // NOLINT(runtime/int)
+};
+
+
+void CipherUpdateRequest::Work(uv_work_t* work_req) {
+  CipherUpdateRequest* req =
+      ContainerOf(&CipherUpdateRequest::work_req_, work_req);
+  req->success_ =
+      req->cipher_->Update(req->data_, req->len_, &req->out_, &req->out_len_);
+  if (!req->success_) {
+    // The error queue is per thread, take the error to the main thread.
+    req->error_ = ERR_get_error();
+    ERR_clear_error();
+  }
+}
+
+
+void CipherUpdateRequest::After(uv_work_t* work_req, int status) {
+  CHECK_EQ(status, 0);
+  std::unique_ptr<CipherUpdateRequest> req(
+      ContainerOf(&CipherUpdateRequest::work_req_, work_req));
+  Environment* env = req->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  Local<Value> argv[2];
+  if (req->success_) {
+    CHECK(req->out_ != nullptr || req->out_len_ == 0);
+    argv[0] = Undefined(env->isolate());
+    argv[1] = Buffer::New(env,
+                          reinterpret_cast<char*>(req->out_),
+                          req->out_len_).ToLocalChecked();
+    req->out_ = nullptr;
+  } else {
+    char errmsg[128] = "Trying to add data in unsupported state";
+    if (req->error_ != 0)
+      ERR_error_string_n(req->error_, errmsg, sizeof(errmsg));
+    argv[0] = Exception::Error(OneByteString(env->isolate(), errmsg));
+    argv[1] = Undefined(env->isolate());
+  }
+  req->MakeCallback(env->ondone_string(), arraysize(argv), argv);
+}
+
+
+void CipherBase::UpdateAsync(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CipherBase* cipher;
+  ASSIGN_OR_RETURN_UNWRAP(&cipher, args.Holder());
+
+  CHECK(args[0]->IsArrayBufferView());
+  CHECK(args[1]->IsFunction());
+
+  Local<Object> obj = env->cipherupdate_constructor_template()->
+      NewInstance(env->context()).ToLocalChecked();
+  obj->Set(env->context(), env->handle_string(), args.Holder()).FromJust();
+  obj->Set(env->context(), env->buffer_string(), args[0]).FromJust();
+  obj->Set(env->context(), env->ondone_string(), args[1]).FromJust();
+
+  CipherUpdateRequest* req =
+      new CipherUpdateRequest(env, obj, cipher, Buffer::Data(args[0]),
+                              Buffer::Length(args[0]));
+  uv_queue_work(env->event_loop(),
+                req->work_req(),
+                CipherUpdateRequest::Work,
+                CipherUpdateRequest::After);
+}
+
+
 bool CipherBase::SetAutoPadding(bool auto_padding) {
   if (ctx_ == nullptr)
     return false;
@@ -4101,6 +4216,7 @@ void Hash::Initialize(Environment* env, v8::Local<v8::Object> target) {
   t->InstanceTemplate()->SetInternalFieldCount(1);
 
   env->SetProtoMethod(t, "update", HashUpdate);
+  env->SetProtoMethod(t, "updateAsync", HashUpdateAsync);
   env->SetProtoMethod(t, "digest", HashDigest);
 
   target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "Hash"), t->GetFunction());
@@ -4169,6 +4285,101 @@ void Hash::HashUpdate(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Runs a Hash::HashUpdate() on the threadpool, like CipherUpdateRequest.
+class HashUpdateRequest : public AsyncWrap {
+ public:
+  HashUpdateRequest(Environment* env,
+                    Local<Object> object,
+                    Hash* hash,
+                    const char* data,
+                    int len)
+      : AsyncWrap(env, object, AsyncWrap::PROVIDER_HASHREQUEST),
+        hash_(hash),
+        data_(data),
+        len_(len),
+        success_(false),
+        error_(0) {
+    Wrap(object, this);
+  }
+
+  ~HashUpdateRequest() override {
+    ClearWrap(object());
+    persistent().Reset();
+  }
+
+  uv_work_t* work_req() {
+    return &work_req_;
+  }
+
+  size_t self_size() const override { return sizeof(*this); }
+
+  static void Work(uv_work_t* work_req);
+  static void After(uv_work_t* work_req, int status);
+
+ private:
+  uv_work_t work_req_;
+  Hash* const hash_;
+  const char* const data_;
+  const int len_;
+  bool success_;
+  unsigned long error_;  // NOLINT(runtime/int)
+};
+
+
+void HashUpdateRequest::Work(uv_work_t* work_req) {
+  HashUpdateRequest* req = ContainerOf(&HashUpdateRequest::work_req_, work_req);
+  req->success_ = req->hash_->HashUpdate(req->data_, req->len_);
+  if (!req->success_) {
+    // The error queue is per thread, take the error to the main thread.
+    req->error_ = ERR_get_error();
+    ERR_clear_error();
+  }
+}
+
+
+void HashUpdateRequest::After(uv_work_t* work_req, int status) {
+  CHECK_EQ(status, 0);
+  std::unique_ptr<HashUpdateRequest> req(
+      ContainerOf(&HashUpdateRequest::work_req_, work_req));
+  Environment* env = req->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+  Local<Value> arg = Undefined(env->isolate());
+  if (!req->success_) {
+    char errmsg[128] = "Hash update failed";
+    if (req->error_ != 0)
+      ERR_error_string_n(req->error_, errmsg, sizeof(errmsg));
+    arg = Exception::Error(OneByteString(env->isolate(), errmsg));
+  }
+  req->MakeCallback(env->ondone_string(), 1, &arg);
+}
+
+
+void Hash::HashUpdateAsync(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  Hash* hash;
+  ASSIGN_OR_RETURN_UNWRAP(&hash, args.Holder());
+
+  CHECK(args[0]->IsArrayBufferView());
+  CHECK(args[1]->IsFunction());
+
+  Local<Object> obj = env->hashupdate_constructor_template()->
+      NewInstance(env->context()).ToLocalChecked();
+  obj->Set(env->context(), env->handle_string(), args.Holder()).FromJust();
+  obj->Set(env->context(), env->buffer_string(), args[0]).FromJust();
+  obj->Set(env->context(), env->ondone_string(), args[1]).FromJust();
+
+  HashUpdateRequest* req =
+      new HashUpdateRequest(env, obj, hash, Buffer::Data(args[0]),
+                            Buffer::Length(args[0]));
+  uv_queue_work(env->event_loop(),
+                req->work_req(),
+                HashUpdateRequest::Work,
+                HashUpdateRequest::After);
+}
+
+
 void Hash::HashDigest(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
 
@@ -4201,14 +4412,313 @@ void Hash::HashDigest(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(rc.ToLocalChecked());
 }
 
+// Digests computed in a single call share one EVP_MD_CTX per thread instead
+// of allocating a context for every input.  The threadpool threads that run
+// batches each get their own.
+static EVP_MD_CTX* ThreadDigestContext() {
+  struct DigestContext {
+    DigestContext() : ctx(EVP_MD_CTX_new()) {}
+    ~DigestContext() { EVP_MD_CTX_free(ctx); }
+    EVP_MD_CTX* const ctx;
+  };
+  static thread_local DigestContext context;
+  return context.ctx;
+}
+
+
+static bool DigestOneShot(const EVP_MD* md,
+                          const char* data,
+                          size_t len,
+                          unsigned char* out) {
+  EVP_MD_CTX* ctx = ThreadDigestContext();
+  unsigned int out_len;
+  return ctx != nullptr &&
+         EVP_DigestInit_ex(ctx, md, nullptr) > 0 &&
+         EVP_DigestUpdate(ctx, data, len) > 0 &&
+         EVP_DigestFinal_ex(ctx, out, &out_len) > 0;
+}
+
+
+struct HashInput {
+  const char* data;
+  size_t length;
+};
+
+
+// Writes the digests of inputs[begin, end) back to back into |out|.
+static bool DigestInputs(const EVP_MD* md,
+                         const std::vector<HashInput>& inputs,
+                         size_t begin,
+                         size_t end,
+                         char* out) {
+  const size_t md_size = EVP_MD_size(md);
+  for (size_t i = begin; i < end; i++) {
+    unsigned char* dst = reinterpret_cast<unsigned char*>(out + i * md_size);
+    if (!DigestOneShot(md, inputs[i].data, inputs[i].length, dst))
+      return false;
+  }
+  return true;
+}
+
+
+void HashOneShot(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CHECK(args[0]->IsString());
+  const node::Utf8Value hash_type(env->isolate(), args[0]);
+  const EVP_MD* md = EVP_get_digestbyname(*hash_type);
+  if (md == nullptr)
+    return args.GetReturnValue().Set(-1);
+
+  enum encoding encoding = ParseEncoding(env->isolate(), args[2], BUFFER);
+
+  StringBytes::InlineDecoder decoder;
+  const char* data;
+  size_t len;
+  if (args[1]->IsString()) {
+    if (!decoder.Decode(env, args[1].As<String>(), Undefined(env->isolate()),
+                        UTF8)) {
+      return;
+    }
+    data = decoder.out();
+    len = decoder.size();
+  } else {
+    CHECK(args[1]->IsArrayBufferView());
+    data = Buffer::Data(args[1]);
+    len = Buffer::Length(args[1]);
+  }
+
+  unsigned char md_value[EVP_MAX_MD_SIZE];
+  if (!DigestOneShot(md, data, len, md_value))
+    return ThrowCryptoError(env, ERR_get_error(), "Digest failed");
+
+  Local<Value> error;
+  MaybeLocal<Value> rc =
+      StringBytes::Encode(env->isolate(),
+                          reinterpret_cast<const char*>(md_value),
+                          EVP_MD_size(md),
+                          encoding,
+                          &error);
+  if (rc.IsEmpty()) {
+    CHECK(!error.IsEmpty());
+    env->isolate()->ThrowException(error);
+    return;
+  }
+  args.GetReturnValue().Set(rc.ToLocalChecked());
+}
+
+
+class HashBatchRequest : public AsyncWrap {
+ public:
+  HashBatchRequest(Environment* env,
+                   Local<Object> object,
+                   const EVP_MD* md,
+                   std::vector<HashInput>&& inputs,
+                   char* strings)
+      : AsyncWrap(env, object, AsyncWrap::PROVIDER_HASHREQUEST),
+        md_(md),
+        inputs_(std::move(inputs)),
+        strings_(strings),
+        out_size_(inputs_.size() * EVP_MD_size(md)),
+        out_(node::Malloc(out_size_)),
+        pending_(0) {
+    Wrap(object, this);
+  }
+
+  ~HashBatchRequest() override {
+    free(out_);
+    out_ = nullptr;
+    free(strings_);
+    strings_ = nullptr;
+    ClearWrap(object());
+    persistent().Reset();
+  }
+
+  size_t self_size() const override { return sizeof(*this); }
+
+  // Splits the batch into jobs and queues them on the threadpool.  The
+  // request deletes itself once the last job has completed.
+  void Dispatch();
+
+ private:
+  struct Job {
+    uv_work_t work_req;
+    HashBatchRequest* req;
+    size_t begin;
+    size_t end;
+    bool success;
+  };
+
+  static void Work(uv_work_t* work_req);
+  static void After(uv_work_t* work_req, int status);
+  void After();
+
+  const EVP_MD* md_;
+  std::vector<HashInput> inputs_;
+  char* strings_;
+  std::vector<Job> jobs_;
+  size_t out_size_;
+  char* out_;
+  size_t pending_;
+};
+
+
+// Batches are cut into at most kBatchMaxJobs jobs, which by default is the
+// size of the threadpool.  Hash batches use jobs of at least
+// kHashBatchMinJobBytes each so that small batches do not pay for several
+// round trips.  Every input counts as at least a block, since that is what
+// hashing an empty one costs.
+static const size_t kBatchMaxJobs = 4;
+static const size_t kHashBatchMinJobBytes = 64 * 1024;
+static const size_t kHashBatchInputCost = 64;
+
+
+void HashBatchRequest::Dispatch() {
+  size_t total = 0;
+  for (const HashInput& input : inputs_)
+    total += input.length + kHashBatchInputCost;
+  const size_t per_job =
+      std::max((total + kBatchMaxJobs - 1) / kBatchMaxJobs,
+               kHashBatchMinJobBytes);
+
+  size_t begin = 0;
+  size_t bytes = 0;
+  for (size_t i = 0; i < inputs_.size(); i++) {
+    bytes += inputs_[i].length + kHashBatchInputCost;
+    if (bytes >= per_job || i + 1 == inputs_.size()) {
+      jobs_.push_back(Job { uv_work_t(), this, begin, i + 1, false });
+      begin = i + 1;
+      bytes = 0;
+    }
+  }
+  if (jobs_.empty())
+    jobs_.push_back(Job { uv_work_t(), this, 0, 0, false });
+
+  // |jobs_| is not resized from here on, the work requests stay in place.
+  pending_ = jobs_.size();
+  for (Job& job : jobs_) {
+    CHECK_EQ(0, uv_queue_work(env()->event_loop(),
+                              &job.work_req,
+                              HashBatchRequest::Work,
+                              HashBatchRequest::After));
+  }
+}
+
+
+void HashBatchRequest::Work(uv_work_t* work_req) {
+  Job* job = ContainerOf(&Job::work_req, work_req);
+  HashBatchRequest* req = job->req;
+  job->success =
+      DigestInputs(req->md_, req->inputs_, job->begin, job->end, req->out_);
+}
+
+
+void HashBatchRequest::After(uv_work_t* work_req, int status) {
+  CHECK_EQ(status, 0);
+  Job* job = ContainerOf(&Job::work_req, work_req);
+  HashBatchRequest* req = job->req;
+  if (--req->pending_ > 0)
+    return;
+  std::unique_ptr<HashBatchRequest> owner(req);
+  owner->After();
+}
+
+
+void HashBatchRequest::After() {
+  HandleScope handle_scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+
+  bool success = true;
+  for (const Job& job : jobs_)
+    success = success && job.success;
+
+  Local<Value> argv[2];
+  if (success) {
+    argv[0] = Undefined(env()->isolate());
+    argv[1] = Buffer::New(env(), out_, out_size_).ToLocalChecked();
+    out_ = nullptr;
+  } else {
+    argv[0] = Exception::Error(
+        FIXED_ONE_BYTE_STRING(env()->isolate(), "Digest failed"));
+    argv[1] = Undefined(env()->isolate());
+  }
+  MakeCallback(env()->ondone_string(), arraysize(argv), argv);
+}
+
+
+void HashBatch(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsArray());
+
+  const node::Utf8Value hash_type(env->isolate(), args[0]);
+  const EVP_MD* md = EVP_get_digestbyname(*hash_type);
+  if (md == nullptr)
+    return args.GetReturnValue().Set(-1);
+
+  // Strings are encoded as UTF-8 back to back into a single allocation,
+  // views are hashed in place.
+  Local<Array> array = args[1].As<Array>();
+  std::vector<HashInput> inputs(array->Length());
+  std::vector<Local<Value>> values(inputs.size());
+  size_t strings_length = 0;
+  for (size_t i = 0; i < inputs.size(); i++) {
+    values[i] = array->Get(env->context(), i).ToLocalChecked();
+    if (values[i]->IsString()) {
+      strings_length += StringBytes::Size(env->isolate(), values[i], UTF8);
+    } else {
+      CHECK(values[i]->IsArrayBufferView());
+      inputs[i].data = Buffer::Data(values[i]);
+      inputs[i].length = Buffer::Length(values[i]);
+    }
+  }
+
+  char* strings = node::Malloc(strings_length);
+  size_t offset = 0;
+  for (size_t i = 0; i < inputs.size(); i++) {
+    if (!values[i]->IsString())
+      continue;
+    inputs[i].data = strings + offset;
+    inputs[i].length = StringBytes::Write(env->isolate(),
+                                          strings + offset,
+                                          strings_length - offset,
+                                          values[i],
+                                          UTF8);
+    offset += inputs[i].length;
+  }
+
+  if (args[2]->IsFunction()) {
+    Local<Object> obj = env->hashbatch_constructor_template()->
+        NewInstance(env->context()).ToLocalChecked();
+    // The inputs are read from the threadpool, keep them alive until then.
+    obj->Set(env->context(), env->buffer_string(), array).FromJust();
+    obj->Set(env->context(), env->ondone_string(), args[2]).FromJust();
+    HashBatchRequest* req =
+        new HashBatchRequest(env, obj, md, std::move(inputs), strings);
+    req->Dispatch();
+    return;
+  }
+
+  const size_t out_size = inputs.size() * EVP_MD_size(md);
+  char* out = node::Malloc(out_size);
+  const bool success = DigestInputs(md, inputs, 0, inputs.size(), out);
+  free(strings);
+  if (!success) {
+    free(out);
+    return ThrowCryptoError(env, ERR_get_error(), "Digest failed");
+  }
+  args.GetReturnValue().Set(Buffer::New(env, out, out_size).ToLocalChecked());
+}
+
+
 
 SignBase::~SignBase() {
   EVP_MD_CTX_free(mdctx_);
 }
 
 
-SignBase::Error SignBase::Init(const char* sign_type) {
-  CHECK_EQ(mdctx_, nullptr);
+static const EVP_MD* GetSignatureDigest(const char* sign_type) {
 #if OPENSSL_VERSION_NUMBER >= 0x10100000L
   // Historically, "dss1" and "DSS1" were DSA aliases for SHA-1
   // exposed through the public API.
@@ -4217,7 +4727,13 @@ SignBase::Error SignBase::Init(const char* sign_type) {
     sign_type = "SHA1";
   }
 #endif
-  const EVP_MD* md = EVP_get_digestbyname(sign_type);
+  return EVP_get_digestbyname(sign_type);
+}
+
+
+SignBase::Error SignBase::Init(const char* sign_type) {
+  CHECK_EQ(mdctx_, nullptr);
+  const EVP_MD* md = GetSignatureDigest(sign_type);
   if (md == nullptr)
     return kSignUnknownDigest;
 
@@ -4336,37 +4852,211 @@ void Sign::SignUpdate(const FunctionCallbackInfo<Value>& args) {
   sign->CheckThrow(err);
 }
 
+// Signs the digest |m| of a message that was computed with |md|.  On input,
+// |*sig_len| is the size of |sig|, on output the length of the signature.
+static bool SignDigest(const EVP_MD* md,
+                       const unsigned char* m,
+                       unsigned int m_len,
+                       EVP_PKEY* pkey,
+                       int padding,
+                       int pss_salt_len,
+                       unsigned char* sig,
+                       size_t* sig_len) {
+  EVP_PKEY_CTX* pkctx = EVP_PKEY_CTX_new(pkey, nullptr);
+  const bool ok = pkctx != nullptr &&
+                  EVP_PKEY_sign_init(pkctx) > 0 &&
+                  ApplyRSAOptions(pkey, pkctx, padding, pss_salt_len) &&
+                  EVP_PKEY_CTX_set_signature_md(pkctx, md) > 0 &&
+                  EVP_PKEY_sign(pkctx, sig, sig_len, m, m_len) > 0;
+  EVP_PKEY_CTX_free(pkctx);
+  return ok;
+}
+
+
+// Verifies |sig| against the digest |m| of a message that was computed
+// with |md|.
+static bool VerifyDigest(const EVP_MD* md,
+                         const unsigned char* m,
+                         unsigned int m_len,
+                         EVP_PKEY* pkey,
+                         int padding,
+                         int pss_salt_len,
+                         const char* sig,
+                         size_t sig_len) {
+  EVP_PKEY_CTX* pkctx = EVP_PKEY_CTX_new(pkey, nullptr);
+  const bool ok = pkctx != nullptr &&
+                  EVP_PKEY_verify_init(pkctx) > 0 &&
+                  ApplyRSAOptions(pkey, pkctx, padding, pss_salt_len) &&
+                  EVP_PKEY_CTX_set_signature_md(pkctx, md) > 0 &&
+                  EVP_PKEY_verify(pkctx,
+                                  reinterpret_cast<const unsigned char*>(sig),
+                                  sig_len,
+                                  m,
+                                  m_len) == 1;
+  EVP_PKEY_CTX_free(pkctx);
+  return ok;
+}
+
+
 static int Node_SignFinal(EVP_MD_CTX* mdctx, unsigned char* md,
                           unsigned int* sig_len, EVP_PKEY* pkey, int padding,
                           int pss_salt_len) {
   unsigned char m[EVP_MAX_MD_SIZE];
   unsigned int m_len;
-  int rv = 0;
-  EVP_PKEY_CTX* pkctx = nullptr;
 
   *sig_len = 0;
   if (!EVP_DigestFinal_ex(mdctx, m, &m_len))
-    return rv;
+    return 0;
 
   size_t sltmp = static_cast<size_t>(EVP_PKEY_size(pkey));
-  pkctx = EVP_PKEY_CTX_new(pkey, nullptr);
-  if (pkctx == nullptr)
-    goto err;
-  if (EVP_PKEY_sign_init(pkctx) <= 0)
-    goto err;
-  if (!ApplyRSAOptions(pkey, pkctx, padding, pss_salt_len))
-    goto err;
-  if (EVP_PKEY_CTX_set_signature_md(pkctx, EVP_MD_CTX_md(mdctx)) <= 0)
-    goto err;
-  if (EVP_PKEY_sign(pkctx, md, &sltmp, m, m_len) <= 0)
-    goto err;
+  if (!SignDigest(EVP_MD_CTX_md(mdctx), m, m_len, pkey, padding, pss_salt_len,
+                  md, &sltmp)) {
+    return 0;
+  }
   *sig_len = sltmp;
-  rv = 1;
- err:
-  EVP_PKEY_CTX_free(pkctx);
-  return rv;
+  return 1;
+}
+
+
+// Reads a private key in PEM format.  Returns nullptr on failure, in which
+// case the reason is on OpenSSL's error stack.
+static EVP_PKEY* ParsePrivateKey(const char* key_pem,
+                                 int key_pem_len,
+                                 const char* passphrase) {
+  BIO* bp = BIO_new_mem_buf(const_cast<char*>(key_pem), key_pem_len);
+  if (bp == nullptr)
+    return nullptr;
+
+  EVP_PKEY* pkey = PEM_read_bio_PrivateKey(bp,
+                                           nullptr,
+                                           PasswordCallback,
+                                           const_cast<char*>(passphrase));
+  BIO_free_all(bp);
+
+  // Errors might be injected into OpenSSL's error stack
+  // without `pkey` being set to nullptr;
+  // cf. the test of `test_bad_rsa_privkey.pem` for an example.
+  if (pkey != nullptr && 0 != ERR_peek_error()) {
+    EVP_PKEY_free(pkey);
+    return nullptr;
+  }
+  return pkey;
+}
+
+
+// Reads a public key, an RSA public key or the public key of an X.509
+// certificate in PEM format.  Returns nullptr on failure.
+static EVP_PKEY* ParsePublicKey(const char* key_pem, int key_pem_len) {
+  BIO* bp = BIO_new_mem_buf(const_cast<char*>(key_pem), key_pem_len);
+  if (bp == nullptr)
+    return nullptr;
+
+  EVP_PKEY* pkey = nullptr;
+
+  // Check if this is a PKCS#8 or RSA public key before trying as X.509.
+  if (strncmp(key_pem, PUBLIC_KEY_PFX, PUBLIC_KEY_PFX_LEN) == 0) {
+    pkey = PEM_read_bio_PUBKEY(bp, nullptr, NoPasswordCallback, nullptr);
+  } else if (strncmp(key_pem, PUBRSA_KEY_PFX, PUBRSA_KEY_PFX_LEN) == 0) {
+    RSA* rsa =
+        PEM_read_bio_RSAPublicKey(bp, nullptr, PasswordCallback, nullptr);
+    if (rsa) {
+      pkey = EVP_PKEY_new();
+      if (pkey)
+        EVP_PKEY_set1_RSA(pkey, rsa);
+      RSA_free(rsa);
+    }
+  } else {
+    // X.509 fallback
+    X509* x509 = PEM_read_bio_X509(bp, nullptr, NoPasswordCallback, nullptr);
+    if (x509 != nullptr) {
+      pkey = X509_get_pubkey(x509);
+      X509_free(x509);
+    }
+  }
+
+  BIO_free_all(bp);
+  return pkey;
+}
+
+
+// Validates DSA2 parameters from FIPS 186-4 in FIPS mode.
+static bool ValidateDSAParameters(EVP_PKEY* pkey) {
+#ifdef NODE_FIPS_MODE
+  if (FIPS_mode() && EVP_PKEY_DSA == pkey->type) {
+    size_t L = BN_num_bits(pkey->pkey.dsa->p);
+    size_t N = BN_num_bits(pkey->pkey.dsa->q);
+
+    if (L == 1024 && N == 160)
+      return true;
+    if (L == 2048 && N == 224)
+      return true;
+    if (L == 2048 && N == 256)
+      return true;
+    if (L == 3072 && N == 256)
+      return true;
+    return false;
+  }
+#endif  // NODE_FIPS_MODE
+  return true;
+}
+
+
+KeyObject::~KeyObject() {
+  if (pkey_ != nullptr)
+    EVP_PKEY_free(pkey_);
+}
+
+
+void KeyObject::Initialize(Environment* env, Local<Object> target) {
+  Local<FunctionTemplate> t = env->NewFunctionTemplate(New);
+
+  t->InstanceTemplate()->SetInternalFieldCount(1);
+
+  env->SetProtoMethod(t, "init", Init);
+
+  target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "KeyObject"),
+              t->GetFunction());
+}
+
+
+void KeyObject::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  new KeyObject(env, args.This());
+}
+
+
+void KeyObject::Init(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  KeyObject* key;
+  ASSIGN_OR_RETURN_UNWRAP(&key, args.Holder());
+  CHECK_EQ(key->pkey_, nullptr);
+  CHECK(args[1]->IsArrayBufferView());
+
+  ClearErrorOnReturn clear_error_on_return;
+
+  const char* key_pem = Buffer::Data(args[1]);
+  size_t key_pem_len = Buffer::Length(args[1]);
+
+  if (args[0]->IsTrue()) {
+    node::Utf8Value passphrase(env->isolate(), args[2]);
+    key->pkey_ = ParsePrivateKey(key_pem,
+                                 key_pem_len,
+                                 args[2]->IsString() ? *passphrase : nullptr);
+    if (key->pkey_ == nullptr) {
+      return ThrowCryptoError(env, ERR_get_error(),
+                              "PEM_read_bio_PrivateKey failed");
+    }
+  } else {
+    key->pkey_ = ParsePublicKey(key_pem, key_pem_len);
+    if (key->pkey_ == nullptr) {
+      return ThrowCryptoError(env, ERR_get_error(),
+                              "PEM_read_bio_PUBKEY failed");
+    }
+  }
 }
 
+
 SignBase::Error Sign::SignFinal(const char* key_pem,
                                 int key_pem_len,
                                 const char* passphrase,
@@ -4377,56 +5067,25 @@ SignBase::Error Sign::SignFinal(const char* key_pem,
   if (!mdctx_)
     return kSignNotInitialised;
 
-  BIO* bp = nullptr;
-  EVP_PKEY* pkey = nullptr;
-  bool fatal = true;
-
-  bp = BIO_new_mem_buf(const_cast<char*>(key_pem), key_pem_len);
-  if (bp == nullptr)
-    goto exit;
-
-  pkey = PEM_read_bio_PrivateKey(bp,
-                                 nullptr,
-                                 PasswordCallback,
-                                 const_cast<char*>(passphrase));
-
-  // Errors might be injected into OpenSSL's error stack
-  // without `pkey` being set to nullptr;
-  // cf. the test of `test_bad_rsa_privkey.pem` for an example.
-  if (pkey == nullptr || 0 != ERR_peek_error())
-    goto exit;
-
-#ifdef NODE_FIPS_MODE
-  /* Validate DSA2 parameters from FIPS 186-4 */
-  if (FIPS_mode() && EVP_PKEY_DSA == pkey->type) {
-    size_t L = BN_num_bits(pkey->pkey.dsa->p);
-    size_t N = BN_num_bits(pkey->pkey.dsa->q);
-    bool result = false;
+  EVP_PKEY* pkey = ParsePrivateKey(key_pem, key_pem_len, passphrase);
+  Error err = SignFinal(pkey, sig, sig_len, padding, salt_len);
+  if (pkey != nullptr)
+    EVP_PKEY_free(pkey);
+  return err;
+}
 
-    if (L == 1024 && N == 160)
-      result = true;
-    else if (L == 2048 && N == 224)
-      result = true;
-    else if (L == 2048 && N == 256)
-      result = true;
-    else if (L == 3072 && N == 256)
-      result = true;
-
-    if (!result) {
-      fatal = true;
-      goto exit;
-    }
-  }
-#endif  // NODE_FIPS_MODE
 
-  if (Node_SignFinal(mdctx_, sig, sig_len, pkey, padding, salt_len))
-    fatal = false;
+SignBase::Error Sign::SignFinal(EVP_PKEY* pkey,
+                                unsigned char* sig,
+                                unsigned int* sig_len,
+                                int padding,
+                                int salt_len) {
+  if (!mdctx_)
+    return kSignNotInitialised;
 
- exit:
-  if (pkey != nullptr)
-    EVP_PKEY_free(pkey);
-  if (bp != nullptr)
-    BIO_free_all(bp);
+  bool fatal = pkey == nullptr ||
+               !ValidateDSAParameters(pkey) ||
+               !Node_SignFinal(mdctx_, sig, sig_len, pkey, padding, salt_len);
 
   EVP_MD_CTX_free(mdctx_);
   mdctx_ = nullptr;
@@ -4448,9 +5107,6 @@ void Sign::SignFinal(const FunctionCallbackInfo<Value>& args) {
 
   node::Utf8Value passphrase(env->isolate(), args[1]);
 
-  size_t buf_len = Buffer::Length(args[0]);
-  char* buf = Buffer::Data(args[0]);
-
   CHECK(args[2]->IsInt32());
   Maybe<int32_t> maybe_padding = args[2]->Int32Value(env->context());
   CHECK(maybe_padding.IsJust());
@@ -4465,14 +5121,21 @@ void Sign::SignFinal(const FunctionCallbackInfo<Value>& args) {
   unsigned char md_value[8192];
   unsigned int md_len = sizeof(md_value);
 
-  Error err = sign->SignFinal(
-      buf,
-      buf_len,
-      len >= 2 && !args[1]->IsNull() ? *passphrase : nullptr,
-      md_value,
-      &md_len,
-      padding,
-      salt_len);
+  Error err;
+  if (args[0]->IsArrayBufferView()) {
+    err = sign->SignFinal(
+        Buffer::Data(args[0]),
+        Buffer::Length(args[0]),
+        len >= 2 && !args[1]->IsNull() ? *passphrase : nullptr,
+        md_value,
+        &md_len,
+        padding,
+        salt_len);
+  } else {
+    KeyObject* key;
+    ASSIGN_OR_RETURN_UNWRAP(&key, args[0].As<Object>());
+    err = sign->SignFinal(key->pkey(), md_value, &md_len, padding, salt_len);
+  }
   if (err != kSignOk)
     return sign->CheckThrow(err);
 
@@ -4535,87 +5198,37 @@ SignBase::Error Verify::VerifyFinal(const char* key_pem,
   if (!mdctx_)
     return kSignNotInitialised;
 
-  EVP_PKEY* pkey = nullptr;
-  BIO* bp = nullptr;
-  X509* x509 = nullptr;
-  bool fatal = true;
-  unsigned char m[EVP_MAX_MD_SIZE];
-  unsigned int m_len;
-  int r = 0;
-  EVP_PKEY_CTX* pkctx = nullptr;
-
-  bp = BIO_new_mem_buf(const_cast<char*>(key_pem), key_pem_len);
-  if (bp == nullptr)
-    goto exit;
+  EVP_PKEY* pkey = ParsePublicKey(key_pem, key_pem_len);
+  Error err = VerifyFinal(pkey, sig, siglen, padding, saltlen, verify_result);
+  if (pkey != nullptr)
+    EVP_PKEY_free(pkey);
+  return err;
+}
 
-  // Check if this is a PKCS#8 or RSA public key before trying as X.509.
-  // Split this out into a separate function once we have more than one
-  // consumer of public keys.
-  if (strncmp(key_pem, PUBLIC_KEY_PFX, PUBLIC_KEY_PFX_LEN) == 0) {
-    pkey = PEM_read_bio_PUBKEY(bp, nullptr, NoPasswordCallback, nullptr);
-    if (pkey == nullptr)
-      goto exit;
-  } else if (strncmp(key_pem, PUBRSA_KEY_PFX, PUBRSA_KEY_PFX_LEN) == 0) {
-    RSA* rsa =
-        PEM_read_bio_RSAPublicKey(bp, nullptr, PasswordCallback, nullptr);
-    if (rsa) {
-      pkey = EVP_PKEY_new();
-      if (pkey)
-        EVP_PKEY_set1_RSA(pkey, rsa);
-      RSA_free(rsa);
-    }
-    if (pkey == nullptr)
-      goto exit;
-  } else {
-    // X.509 fallback
-    x509 = PEM_read_bio_X509(bp, nullptr, NoPasswordCallback, nullptr);
-    if (x509 == nullptr)
-      goto exit;
 
-    pkey = X509_get_pubkey(x509);
-    if (pkey == nullptr)
-      goto exit;
-  }
+SignBase::Error Verify::VerifyFinal(EVP_PKEY* pkey,
+                                    const char* sig,
+                                    int siglen,
+                                    int padding,
+                                    int saltlen,
+                                    bool* verify_result) {
+  if (!mdctx_)
+    return kSignNotInitialised;
 
-  if (!EVP_DigestFinal_ex(mdctx_, m, &m_len)) {
-    goto exit;
+  unsigned char m[EVP_MAX_MD_SIZE];
+  unsigned int m_len;
+  bool fatal = pkey == nullptr || !EVP_DigestFinal_ex(mdctx_, m, &m_len);
+  if (!fatal) {
+    *verify_result = VerifyDigest(EVP_MD_CTX_md(mdctx_), m, m_len, pkey,
+                                  padding, saltlen, sig, siglen);
   }
 
-  fatal = false;
-
-  pkctx = EVP_PKEY_CTX_new(pkey, nullptr);
-  if (pkctx == nullptr)
-    goto err;
-  if (EVP_PKEY_verify_init(pkctx) <= 0)
-    goto err;
-  if (!ApplyRSAOptions(pkey, pkctx, padding, saltlen))
-    goto err;
-  if (EVP_PKEY_CTX_set_signature_md(pkctx, EVP_MD_CTX_md(mdctx_)) <= 0)
-    goto err;
-  r = EVP_PKEY_verify(pkctx,
-                      reinterpret_cast<const unsigned char*>(sig),
-                      siglen,
-                      m,
-                      m_len);
-
- err:
-  EVP_PKEY_CTX_free(pkctx);
-
- exit:
-  if (pkey != nullptr)
-    EVP_PKEY_free(pkey);
-  if (bp != nullptr)
-    BIO_free_all(bp);
-  if (x509 != nullptr)
-    X509_free(x509);
-
   EVP_MD_CTX_free(mdctx_);
   mdctx_ = nullptr;
 
   if (fatal)
     return kSignPublicKey;
 
-  *verify_result = r == 1;
   return kSignOk;
 }
 
@@ -4628,9 +5241,6 @@ void Verify::VerifyFinal(const FunctionCallbackInfo<Value>& args) {
   Verify* verify;
   ASSIGN_OR_RETURN_UNWRAP(&verify, args.Holder());
 
-  char* kbuf = Buffer::Data(args[0]);
-  ssize_t klen = Buffer::Length(args[0]);
-
   char* hbuf = Buffer::Data(args[1]);
   ssize_t hlen = Buffer::Length(args[1]);
 
@@ -4645,14 +5255,393 @@ void Verify::VerifyFinal(const FunctionCallbackInfo<Value>& args) {
   int salt_len = maybe_salt_len.ToChecked();
 
   bool verify_result;
-  Error err = verify->VerifyFinal(kbuf, klen, hbuf, hlen, padding, salt_len,
-                                  &verify_result);
+  Error err;
+  if (args[0]->IsArrayBufferView()) {
+    err = verify->VerifyFinal(Buffer::Data(args[0]), Buffer::Length(args[0]),
+                              hbuf, hlen, padding, salt_len, &verify_result);
+  } else {
+    KeyObject* key;
+    ASSIGN_OR_RETURN_UNWRAP(&key, args[0].As<Object>());
+    err = verify->VerifyFinal(key->pkey(), hbuf, hlen, padding, salt_len,
+                              &verify_result);
+  }
   if (err != kSignOk)
     return verify->CheckThrow(err);
   args.GetReturnValue().Set(verify_result);
 }
 
 
+// Computes the signature of a whole message in one call, which is what a
+// Sign object does with update() and sign().
+static bool SignMessage(const EVP_MD* md,
+                        EVP_PKEY* pkey,
+                        int padding,
+                        int salt_len,
+                        const char* data,
+                        size_t len,
+                        unsigned char* sig,
+                        size_t* sig_len) {
+  unsigned char m[EVP_MAX_MD_SIZE];
+  return ValidateDSAParameters(pkey) &&
+         DigestOneShot(md, data, len, m) &&
+         SignDigest(md, m, EVP_MD_size(md), pkey, padding, salt_len,
+                    sig, sig_len);
+}
+
+
+struct VerifyInput {
+  const char* data;
+  size_t length;
+  const char* sig;
+  size_t sig_length;
+};
+
+
+// Verifies inputs[begin, end) and stores 1 for every valid signature and 0
+// for every other one in |results|.
+static void VerifyInputs(const EVP_MD* md,
+                         EVP_PKEY* pkey,
+                         int padding,
+                         int salt_len,
+                         const std::vector<VerifyInput>& inputs,
+                         size_t begin,
+                         size_t end,
+                         char* results) {
+  unsigned char m[EVP_MAX_MD_SIZE];
+  for (size_t i = begin; i < end; i++) {
+    const VerifyInput& input = inputs[i];
+    results[i] =
+        DigestOneShot(md, input.data, input.length, m) &&
+        VerifyDigest(md, m, EVP_MD_size(md), pkey, padding, salt_len,
+                     input.sig, input.sig_length);
+  }
+  // Invalid signatures leave errors behind that nobody is going to read.
+  ERR_clear_error();
+}
+
+
+class SignRequest : public AsyncWrap {
+ public:
+  SignRequest(Environment* env,
+              Local<Object> object,
+              const EVP_MD* md,
+              EVP_PKEY* pkey,
+              int padding,
+              int salt_len,
+              const char* data,
+              size_t len)
+      : AsyncWrap(env, object, AsyncWrap::PROVIDER_SIGNREQUEST),
+        md_(md),
+        pkey_(pkey),
+        padding_(padding),
+        salt_len_(salt_len),
+        data_(data),
+        len_(len),
+        sig_len_(EVP_PKEY_size(pkey)),
+        sig_(node::Malloc<unsigned char>(sig_len_)),
+        success_(false),
+        error_(0) {
+    Wrap(object, this);
+  }
+
+  ~SignRequest() override {
+    free(sig_);
+    sig_ = nullptr;
+    ClearWrap(object());
+    persistent().Reset();
+  }
+
+  uv_work_t* work_req() {
+    return &work_req_;
+  }
+
+  size_t self_size() const override { return sizeof(*this); }
+
+  static void Work(uv_work_t* work_req);
+  static void After(uv_work_t* work_req, int status);
+
+ private:
+  uv_work_t work_req_;
+  const EVP_MD* md_;
+  EVP_PKEY* pkey_;
+  int padding_;
+  int salt_len_;
+  const char* data_;
+  size_t len_;
+  size_t sig_len_;
+  unsigned char* sig_;
+  bool success_;
+  unsigned long error_;  // NOLINT(runtime/int)
+};
+
+
+void SignRequest::Work(uv_work_t* work_req) {
+  SignRequest* req = ContainerOf(&SignRequest::work_req_, work_req);
+  req->success_ = SignMessage(req->md_, req->pkey_, req->padding_,
+                              req->salt_len_, req->data_, req->len_,
+                              req->sig_, &req->sig_len_);
+  if (!req->success_)
+    req->error_ = ERR_get_error();
+  ERR_clear_error();
+}
+
+
+void SignRequest::After(uv_work_t* work_req, int status) {
+  CHECK_EQ(status, 0);
+  std::unique_ptr<SignRequest> req(
+      ContainerOf(&SignRequest::work_req_, work_req));
+  Environment* env = req->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  Local<Value> argv[2];
+  if (req->success_) {
+    argv[0] = Undefined(env->isolate());
+    argv[1] = Buffer::New(env,
+                          reinterpret_cast<char*>(req->sig_),
+                          req->sig_len_).ToLocalChecked();
+    req->sig_ = nullptr;
+  } else {
+    char errmsg[128] = "EVP_PKEY_sign failed";
+    if (req->error_ != 0)
+      ERR_error_string_n(req->error_, errmsg, sizeof(errmsg));
+    argv[0] = Exception::Error(OneByteString(env->isolate(), errmsg));
+    argv[1] = Undefined(env->isolate());
+  }
+  req->MakeCallback(env->ondone_string(), arraysize(argv), argv);
+}
+
+
+// Verifies any number of signatures made with the same key, split between
+// up to kBatchMaxJobs threads like a hash batch.
+class VerifyRequest : public AsyncWrap {
+ public:
+  VerifyRequest(Environment* env,
+                Local<Object> object,
+                const EVP_MD* md,
+                EVP_PKEY* pkey,
+                int padding,
+                int salt_len,
+                std::vector<VerifyInput>&& inputs)
+      : AsyncWrap(env, object, AsyncWrap::PROVIDER_VERIFYREQUEST),
+        md_(md),
+        pkey_(pkey),
+        padding_(padding),
+        salt_len_(salt_len),
+        inputs_(std::move(inputs)),
+        results_(inputs_.size()),
+        pending_(0) {
+    Wrap(object, this);
+  }
+
+  ~VerifyRequest() override {
+    ClearWrap(object());
+    persistent().Reset();
+  }
+
+  size_t self_size() const override { return sizeof(*this); }
+
+  // Queues the jobs on the threadpool.  The request deletes itself once the
+  // last job has completed.
+  void Dispatch();
+
+ private:
+  struct Job {
+    uv_work_t work_req;
+    VerifyRequest* req;
+    size_t begin;
+    size_t end;
+  };
+
+  static void Work(uv_work_t* work_req);
+  static void After(uv_work_t* work_req, int status);
+  void After();
+
+  const EVP_MD* md_;
+  EVP_PKEY* pkey_;
+  int padding_;
+  int salt_len_;
+  std::vector<VerifyInput> inputs_;
+  std::vector<char> results_;
+  std::vector<Job> jobs_;
+  size_t pending_;
+};
+
+
+void VerifyRequest::Dispatch() {
+  // Every signature is expensive to verify, so split by count.
+  const size_t count = inputs_.size();
+  const size_t njobs = std::max<size_t>(std::min(count, kBatchMaxJobs), 1);
+  for (size_t i = 0; i < njobs; i++) {
+    jobs_.push_back(Job { uv_work_t(), this, count * i / njobs,
+                          count * (i + 1) / njobs });
+  }
+
+  // |jobs_| is not resized from here on, the work requests stay in place.
+  pending_ = jobs_.size();
+  for (Job& job : jobs_) {
+    uv_queue_work(env()->event_loop(),
+                  &job.work_req,
+                  VerifyRequest::Work,
+                  VerifyRequest::After);
+  }
+}
+
+
+void VerifyRequest::Work(uv_work_t* work_req) {
+  Job* job = ContainerOf(&Job::work_req, work_req);
+  VerifyRequest* req = job->req;
+  VerifyInputs(req->md_, req->pkey_, req->padding_, req->salt_len_,
+               req->inputs_, job->begin, job->end, req->results_.data());
+}
+
+
+void VerifyRequest::After(uv_work_t* work_req, int status) {
+  CHECK_EQ(status, 0);
+  Job* job = ContainerOf(&Job::work_req, work_req);
+  VerifyRequest* req = job->req;
+  if (--req->pending_ > 0)
+    return;
+  std::unique_ptr<VerifyRequest> owner(req);
+  owner->After();
+}
+
+
+static Local<Array> VerifyResults(Environment* env,
+                                  const std::vector<char>& results) {
+  Local<Array> array = Array::New(env->isolate(), results.size());
+  for (size_t i = 0; i < results.size(); i++) {
+    array->Set(env->context(), i,
+               Boolean::New(env->isolate(), results[i] != 0)).FromJust();
+  }
+  return array;
+}
+
+
+void VerifyRequest::After() {
+  HandleScope handle_scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+  Local<Value> argv[2] = {
+    Undefined(env()->isolate()),
+    VerifyResults(env(), results_)
+  };
+  MakeCallback(env()->ondone_string(), arraysize(argv), argv);
+}
+
+
+// sign(algorithm, data, key, padding, saltLength[, callback])
+void SignOneShot(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsArrayBufferView());
+  CHECK(args[2]->IsObject());
+  CHECK(args[3]->IsInt32());
+  CHECK(args[4]->IsInt32());
+
+  const node::Utf8Value sign_type(env->isolate(), args[0]);
+  const EVP_MD* md = GetSignatureDigest(*sign_type);
+  if (md == nullptr)
+    return args.GetReturnValue().Set(-1);
+
+  KeyObject* key;
+  ASSIGN_OR_RETURN_UNWRAP(&key, args[2].As<Object>());
+  int padding = args[3]->Int32Value(env->context()).FromJust();
+  int salt_len = args[4]->Int32Value(env->context()).FromJust();
+
+  if (args[5]->IsFunction()) {
+    Local<Object> obj = env->signrequest_constructor_template()->
+        NewInstance(env->context()).ToLocalChecked();
+    // The key and the data are used on the threadpool, keep them alive.
+    obj->Set(env->context(), env->handle_string(), args[2]).FromJust();
+    obj->Set(env->context(), env->buffer_string(), args[1]).FromJust();
+    obj->Set(env->context(), env->ondone_string(), args[5]).FromJust();
+    SignRequest* req = new SignRequest(env, obj, md, key->pkey(), padding,
+                                       salt_len, Buffer::Data(args[1]),
+                                       Buffer::Length(args[1]));
+    uv_queue_work(env->event_loop(),
+                  req->work_req(),
+                  SignRequest::Work,
+                  SignRequest::After);
+    return;
+  }
+
+  ClearErrorOnReturn clear_error_on_return;
+  size_t sig_len = EVP_PKEY_size(key->pkey());
+  unsigned char* sig = node::Malloc<unsigned char>(sig_len);
+  if (!SignMessage(md, key->pkey(), padding, salt_len, Buffer::Data(args[1]),
+                   Buffer::Length(args[1]), sig, &sig_len)) {
+    free(sig);
+    return ThrowCryptoError(env, ERR_get_error(), "EVP_PKEY_sign failed");
+  }
+  args.GetReturnValue().Set(
+      Buffer::New(env, reinterpret_cast<char*>(sig), sig_len)
+      .ToLocalChecked());
+}
+
+
+// verify(algorithm, key, data, signatures, padding, saltLength[, callback])
+// where |data| and |signatures| are arrays of the same length.
+void VerifyOneShot(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CHECK(args[0]->IsString());
+  CHECK(args[1]->IsObject());
+  CHECK(args[2]->IsArray());
+  CHECK(args[3]->IsArray());
+  CHECK(args[4]->IsInt32());
+  CHECK(args[5]->IsInt32());
+
+  const node::Utf8Value verify_type(env->isolate(), args[0]);
+  const EVP_MD* md = GetSignatureDigest(*verify_type);
+  if (md == nullptr)
+    return args.GetReturnValue().Set(-1);
+
+  KeyObject* key;
+  ASSIGN_OR_RETURN_UNWRAP(&key, args[1].As<Object>());
+  int padding = args[4]->Int32Value(env->context()).FromJust();
+  int salt_len = args[5]->Int32Value(env->context()).FromJust();
+
+  Local<Array> data = args[2].As<Array>();
+  Local<Array> signatures = args[3].As<Array>();
+  CHECK_EQ(data->Length(), signatures->Length());
+
+  std::vector<VerifyInput> inputs(data->Length());
+  for (size_t i = 0; i < inputs.size(); i++) {
+    Local<Value> input = data->Get(env->context(), i).ToLocalChecked();
+    Local<Value> sig = signatures->Get(env->context(), i).ToLocalChecked();
+    CHECK(input->IsArrayBufferView());
+    CHECK(sig->IsArrayBufferView());
+    inputs[i].data = Buffer::Data(input);
+    inputs[i].length = Buffer::Length(input);
+    inputs[i].sig = Buffer::Data(sig);
+    inputs[i].sig_length = Buffer::Length(sig);
+  }
+
+  if (args[6]->IsFunction()) {
+    Local<Object> obj = env->verifyrequest_constructor_template()->
+        NewInstance(env->context()).ToLocalChecked();
+    // The key, the data and the signatures are used on the threadpool, keep
+    // them alive.
+    Local<Array> buffers = Array::New(env->isolate(), 2);
+    buffers->Set(env->context(), 0, data).FromJust();
+    buffers->Set(env->context(), 1, signatures).FromJust();
+    obj->Set(env->context(), env->handle_string(), args[1]).FromJust();
+    obj->Set(env->context(), env->buffer_string(), buffers).FromJust();
+    obj->Set(env->context(), env->ondone_string(), args[6]).FromJust();
+    VerifyRequest* req = new VerifyRequest(env, obj, md, key->pkey(), padding,
+                                           salt_len, std::move(inputs));
+    req->Dispatch();
+    return;
+  }
+
+  std::vector<char> results(inputs.size());
+  VerifyInputs(md, key->pkey(), padding, salt_len, inputs, 0, inputs.size(),
+               results.data());
+  args.GetReturnValue().Set(VerifyResults(env, results));
+}
+
+
 template <PublicKeyCipher::Operation operation,
           PublicKeyCipher::EVP_PKEY_cipher_init_t EVP_PKEY_cipher_init,
           PublicKeyCipher::EVP_PKEY_cipher_t EVP_PKEY_cipher>
@@ -5956,6 +6945,22 @@ void GetCurves(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Returns [allocated, pooled] for tls.getBufferMemoryUsage(), the number of
+// bytes held by the BIOs of all TLS connections in the process and by
+// buffers kept around for reuse.
+void GetBIOMemoryStats(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  size_t allocated;
+  size_t pooled;
+  NodeBIO::GetMemoryStats(&allocated, &pooled);
+
+  Local<Array> arr = Array::New(env->isolate(), 2);
+  arr->Set(0, Number::New(env->isolate(), static_cast<double>(allocated)));
+  arr->Set(1, Number::New(env->isolate(), static_cast<double>(pooled)));
+  args.GetReturnValue().Set(arr);
+}
+
+
 bool VerifySpkac(const char* data, unsigned int len) {
   bool i = 0;
   EVP_PKEY* pkey = nullptr;
@@ -6233,6 +7238,7 @@ void InitCrypto(Local<Object> target,
   ECDH::Initialize(env, target);
   Hmac::Initialize(env, target);
   Hash::Initialize(env, target);
+  KeyObject::Initialize(env, target);
   Sign::Initialize(env, target);
   Verify::Initialize(env, target);
 
@@ -6248,6 +7254,10 @@ void InitCrypto(Local<Object> target,
   env->SetMethod(target, "setFipsCrypto", SetFipsCrypto);
 #endif
 
+  env->SetMethod(target, "hash", HashOneShot);
+  env->SetMethod(target, "hashBatch", HashBatch);
+  env->SetMethod(target, "sign", SignOneShot);
+  env->SetMethod(target, "verify", VerifyOneShot);
   env->SetMethod(target, "PBKDF2", PBKDF2);
   env->SetMethod(target, "randomBytes", RandomBytes);
   env->SetMethod(target, "randomFill", RandomBytesBuffer);
@@ -6256,6 +7266,7 @@ void InitCrypto(Local<Object> target,
   env->SetMethod(target, "getCiphers", GetCiphers);
   env->SetMethod(target, "getHashes", GetHashes);
   env->SetMethod(target, "getCurves", GetCurves);
+  env->SetMethod(target, "getBIOMemoryStats", GetBIOMemoryStats);
   env->SetMethod(target, "publicEncrypt",
                  PublicKeyCipher::Cipher<PublicKeyCipher::kPublic,
                                          EVP_PKEY_encrypt_init,
@@ -6286,6 +7297,41 @@ void InitCrypto(Local<Object> target,
   Local<ObjectTemplate> rbt = rb->InstanceTemplate();
   rbt->SetInternalFieldCount(1);
   env->set_randombytes_constructor_template(rbt);
+
+  Local<FunctionTemplate> hb = FunctionTemplate::New(env->isolate());
+  hb->SetClassName(FIXED_ONE_BYTE_STRING(env->isolate(), "HashBatch"));
+  AsyncWrap::AddWrapMethods(env, hb);
+  Local<ObjectTemplate> hbt = hb->InstanceTemplate();
+  hbt->SetInternalFieldCount(1);
+  env->set_hashbatch_constructor_template(hbt);
+
+  Local<FunctionTemplate> hu = FunctionTemplate::New(env->isolate());
+  hu->SetClassName(FIXED_ONE_BYTE_STRING(env->isolate(), "HashUpdate"));
+  AsyncWrap::AddWrapMethods(env, hu);
+  Local<ObjectTemplate> hut = hu->InstanceTemplate();
+  hut->SetInternalFieldCount(1);
+  env->set_hashupdate_constructor_template(hut);
+
+  Local<FunctionTemplate> cu = FunctionTemplate::New(env->isolate());
+  cu->SetClassName(FIXED_ONE_BYTE_STRING(env->isolate(), "CipherUpdate"));
+  AsyncWrap::AddWrapMethods(env, cu);
+  Local<ObjectTemplate> cut = cu->InstanceTemplate();
+  cut->SetInternalFieldCount(1);
+  env->set_cipherupdate_constructor_template(cut);
+
+  Local<FunctionTemplate> sr = FunctionTemplate::New(env->isolate());
+  sr->SetClassName(FIXED_ONE_BYTE_STRING(env->isolate(), "SignRequest"));
+  AsyncWrap::AddWrapMethods(env, sr);
+  Local<ObjectTemplate> srt = sr->InstanceTemplate();
+  srt->SetInternalFieldCount(1);
+  env->set_signrequest_constructor_template(srt);
+
+  Local<FunctionTemplate> vr = FunctionTemplate::New(env->isolate());
+  vr->SetClassName(FIXED_ONE_BYTE_STRING(env->isolate(), "VerifyRequest"));
+  AsyncWrap::AddWrapMethods(env, vr);
+  Local<ObjectTemplate> vrt = vr->InstanceTemplate();
+  vrt->SetInternalFieldCount(1);
+  env->set_verifyrequest_constructor_template(vrt);
 }
 
 }  // namespace crypto
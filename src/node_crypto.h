@@ -445,6 +445,8 @@ class Connection : public AsyncWrap, public SSLWrap<Connection> {
   friend class SecureContext;
 };
 
+class CipherUpdateRequest;
+
 class CipherBase : public BaseObject {
  public:
   ~CipherBase() override {
@@ -476,6 +478,7 @@ class CipherBase : public BaseObject {
   static void Init(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void InitIv(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Update(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void UpdateAsync(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Final(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetAutoPadding(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -498,6 +501,8 @@ class CipherBase : public BaseObject {
   const CipherKind kind_;
   unsigned int auth_tag_len_;
   char auth_tag_[EVP_GCM_TLS_TAG_LEN];
+
+  friend class CipherUpdateRequest;
 };
 
 class Hmac : public BaseObject {
@@ -537,6 +542,8 @@ class Hash : public BaseObject {
  protected:
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void HashUpdate(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void HashUpdateAsync(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void HashDigest(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   Hash(Environment* env, v8::Local<v8::Object> wrap)
@@ -551,6 +558,30 @@ class Hash : public BaseObject {
   bool finalized_;
 };
 
+// A parsed public or private key that can be used for any number of sign
+// and verify operations, also on the threadpool.
+class KeyObject : public BaseObject {
+ public:
+  ~KeyObject() override;
+
+  static void Initialize(Environment* env, v8::Local<v8::Object> target);
+
+  EVP_PKEY* pkey() const { return pkey_; }
+
+ protected:
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Init(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  KeyObject(Environment* env, v8::Local<v8::Object> wrap)
+      : BaseObject(env, wrap),
+        pkey_(nullptr) {
+    MakeWeak<KeyObject>(this);
+  }
+
+ private:
+  EVP_PKEY* pkey_;
+};
+
 class SignBase : public BaseObject {
  public:
   typedef enum {
@@ -590,6 +621,11 @@ class Sign : public SignBase {
                   unsigned int *sig_len,
                   int padding,
                   int saltlen);
+  Error SignFinal(EVP_PKEY* pkey,
+                  unsigned char* sig,
+                  unsigned int *sig_len,
+                  int padding,
+                  int saltlen);
 
  protected:
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -613,6 +649,12 @@ class Verify : public SignBase {
                     int padding,
                     int saltlen,
                     bool* verify_result);
+  Error VerifyFinal(EVP_PKEY* pkey,
+                    const char* sig,
+                    int siglen,
+                    int padding,
+                    int saltlen,
+                    bool* verify_result);
 
  protected:
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
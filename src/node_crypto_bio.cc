@@ -21,13 +21,42 @@
 
 #include "node_crypto_bio.h"
 #include "openssl/bio.h"
+#include "node_mutex.h"
 #include "util-inl.h"
 #include <limits.h>
 #include <string.h>
+#include <atomic>
 
 namespace node {
 namespace crypto {
 
+// Up to 4 MiB worth of recycled buffers are shared by all threads.
+static const size_t kMaxPooledBuffers = 256;
+// Each thread keeps up to 256 KiB more to itself.  A connection gives its
+// buffers back after every read and takes them again for the next one, and
+// that should not take a lock each time.
+static const size_t kMaxThreadPooledBuffers = 16;
+
+static Mutex pool_mutex;
+static char* pooled_buffers[kMaxPooledBuffers];
+static size_t pooled_count;
+static std::atomic<size_t> allocated_bytes;
+static std::atomic<size_t> pooled_bytes;
+
+struct ThreadBufferCache {
+  ~ThreadBufferCache() {
+    for (size_t i = 0; i < count; i++)
+      delete[] buffers[i];
+    pooled_bytes -= bytes;
+  }
+
+  char* buffers[kMaxThreadPooledBuffers];
+  size_t count = 0;
+  size_t bytes = 0;
+};
+
+static thread_local ThreadBufferCache thread_buffers;
+
 #if OPENSSL_VERSION_NUMBER < 0x10100000L
 #define BIO_set_data(bio, data) bio->ptr = data
 #define BIO_get_data(bio) bio->ptr
@@ -269,6 +298,57 @@ const BIO_METHOD* NodeBIO::GetMethod() {
 }
 
 
+char* NodeBIO::AllocateData(size_t len) {
+  allocated_bytes += len;
+  if (len != kThroughputBufferLength)
+    return new char[len];
+
+  ThreadBufferCache* cache = &thread_buffers;
+  if (cache->count > 0) {
+    cache->bytes -= len;
+    pooled_bytes -= len;
+    return cache->buffers[--cache->count];
+  }
+
+  {
+    Mutex::ScopedLock lock(pool_mutex);
+    if (pooled_count > 0) {
+      pooled_bytes -= len;
+      return pooled_buffers[--pooled_count];
+    }
+  }
+  return new char[len];
+}
+
+
+void NodeBIO::FreeData(char* data, size_t len) {
+  allocated_bytes -= len;
+  if (len == kThroughputBufferLength) {
+    ThreadBufferCache* cache = &thread_buffers;
+    if (cache->count < kMaxThreadPooledBuffers) {
+      cache->buffers[cache->count++] = data;
+      cache->bytes += len;
+      pooled_bytes += len;
+      return;
+    }
+
+    Mutex::ScopedLock lock(pool_mutex);
+    if (pooled_count < kMaxPooledBuffers) {
+      pooled_buffers[pooled_count++] = data;
+      pooled_bytes += len;
+      return;
+    }
+  }
+  delete[] data;
+}
+
+
+void NodeBIO::GetMemoryStats(size_t* allocated, size_t* pooled) {
+  *allocated = allocated_bytes;
+  *pooled = pooled_bytes;
+}
+
+
 void NodeBIO::TryMoveReadHead() {
   // `read_pos_` and `write_pos_` means the position of the reader and writer
   // inside the buffer, respectively. When they're equal - its safe to reset
@@ -338,6 +418,7 @@ void NodeBIO::FreeEmpty() {
     CHECK_EQ(cur->write_pos_, cur->read_pos_);
 
     Buffer* next = cur->next_;
+    allocated_ -= cur->len_;
     delete cur;
     cur = next;
   }
@@ -470,6 +551,7 @@ void NodeBIO::TryAllocateForWrite(size_t hint) {
     if (len < hint)
       len = hint;
     Buffer* next = new Buffer(env_, len);
+    allocated_ += len;
 
     if (w == nullptr) {
       next->next_ = next;
@@ -501,7 +583,17 @@ void NodeBIO::Reset() {
 }
 
 
-NodeBIO::~NodeBIO() {
+void NodeBIO::TryShrink() {
+  if (read_head_ == nullptr || length_ != 0)
+    return;
+  FreeAll();
+  // The ClientHello is long gone by now, so start over with a buffer that
+  // can be recycled.
+  initial_ = kThroughputBufferLength;
+}
+
+
+void NodeBIO::FreeAll() {
   if (read_head_ == nullptr)
     return;
 
@@ -514,6 +606,12 @@ NodeBIO::~NodeBIO() {
 
   read_head_ = nullptr;
   write_head_ = nullptr;
+  allocated_ = 0;
+}
+
+
+NodeBIO::~NodeBIO() {
+  FreeAll();
 }
 
 
@@ -37,6 +37,7 @@ class NodeBIO {
   NodeBIO() : env_(nullptr),
               initial_(kInitialBufferLength),
               length_(0),
+              allocated_(0),
               eof_return_(-1),
               read_head_(nullptr),
               write_head_(nullptr) {
@@ -80,6 +81,11 @@ class NodeBIO {
   // Discard all available data
   void Reset();
 
+  // Give all buffers back if there is no data left, so that idle
+  // connections do not hold on to memory.  Must not be called while
+  // pointers returned by PeekWritable() are still in use.
+  void TryShrink();
+
   // Put `len` bytes from `data` into buffer
   void Write(const char* data, size_t size);
 
@@ -96,6 +102,11 @@ class NodeBIO {
     return length_;
   }
 
+  // Return the amount of memory held by the buffers in bytes
+  inline size_t Allocated() const {
+    return allocated_;
+  }
+
   inline void set_eof_return(int num) {
     eof_return_ = num;
   }
@@ -110,6 +121,10 @@ class NodeBIO {
 
   static NodeBIO* FromBIO(BIO* bio);
 
+  // Memory held by the buffers of all NodeBIOs in the process, and by the
+  // buffers that are kept around for reuse.
+  static void GetMemoryStats(size_t* allocated, size_t* pooled);
+
  private:
   static int New(BIO* bio);
   static int Free(BIO* bio);
@@ -126,6 +141,13 @@ class NodeBIO {
   static const size_t kInitialBufferLength = 1024;
   static const size_t kThroughputBufferLength = 16384;
 
+  // Buffers of kThroughputBufferLength bytes are recycled between all BIOs
+  // in the process instead of being freed.
+  static char* AllocateData(size_t len);
+  static void FreeData(char* data, size_t len);
+
+  void FreeAll();
+
   class Buffer {
    public:
     Buffer(Environment* env, size_t len) : env_(env),
@@ -133,13 +155,13 @@ class NodeBIO {
                                            write_pos_(0),
                                            len_(len),
                                            next_(nullptr) {
-      data_ = new char[len];
+      data_ = AllocateData(len);
       if (env_ != nullptr)
         env_->isolate()->AdjustAmountOfExternalAllocatedMemory(len);
     }
 
     ~Buffer() {
-      delete[] data_;
+      FreeData(data_, len_);
       if (env_ != nullptr) {
         const int64_t len = static_cast<int64_t>(len_);
         env_->isolate()->AdjustAmountOfExternalAllocatedMemory(-len);
@@ -157,6 +179,7 @@ class NodeBIO {
   Environment* env_;
   size_t initial_;
   size_t length_;
+  size_t allocated_;
   int eof_return_;
   Buffer* read_head_;
   Buffer* write_head_;
@@ -39,6 +39,7 @@
 # include <io.h>
 #endif
 
+#include <algorithm>
 #include <vector>
 
 namespace node {
@@ -1261,6 +1262,575 @@ static void Mkdtemp(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// Reads |fd| until EOF, or until at least |max_read| bytes have been read,
+// and appends the bytes to the malloc()ed buffer |*data|.  When the size of
+// the file is known from a preceding fstat(), the buffer is sized for it up
+// front; otherwise (or when the file grows underneath us, as /proc files
+// tend to) spare capacity is used first and the buffer is grown
+// geometrically.  Sets |*eof| when the end of the file was reached.
+// Returns the number of bytes read or a negative errno, in which case the
+// buffer is left at its original length.
+static int ReadToEnd(uv_loop_t* loop,
+                     uv_file fd,
+                     int64_t size_hint,
+                     size_t max_read,
+                     char** data,
+                     size_t* length,
+                     size_t* capacity,
+                     bool* eof) {
+  static const size_t kReadChunkSize = 64 * 1024;
+  const size_t start = *length;
+  const size_t max_length = Buffer::kMaxLength;
+  *eof = false;
+  if (size_hint > 0 && static_cast<uint64_t>(size_hint) > max_length - start)
+    return UV_EFBIG;
+  // One byte of slack lets the second read() detect EOF without growing.
+  size_t want;
+  if (size_hint > 0)
+    want = size_hint + 1;
+  else
+    want = *capacity > *length ? 0 : kReadChunkSize;
+
+  for (;;) {
+    if (*capacity - *length < want) {
+      const size_t new_capacity = std::min(*length + want, max_length);
+      if (new_capacity > *capacity) {
+        char* new_data = node::UncheckedRealloc(*data, new_capacity);
+        if (new_data == nullptr) {
+          *length = start;
+          return UV_ENOMEM;
+        }
+        *data = new_data;
+        *capacity = new_capacity;
+      } else if (*length == *capacity) {
+        // The buffer is as large as a Buffer can be, and full.  That is
+        // only fine if the file ends here.
+        char probe;
+        uv_buf_t buf = uv_buf_init(&probe, 1);
+        uv_fs_t req;
+        const int nread = uv_fs_read(loop, &req, fd, &buf, 1, -1, nullptr);
+        uv_fs_req_cleanup(&req);
+        if (nread == 0) {
+          *eof = true;
+          break;
+        }
+        *length = start;
+        return nread < 0 ? nread : UV_EFBIG;
+      }
+    }
+
+    const size_t budget = start + max_read - *length;
+    uv_buf_t buf = uv_buf_init(*data + *length,
+                               std::min(*capacity - *length, budget));
+    uv_fs_t req;
+    const int nread = uv_fs_read(loop, &req, fd, &buf, 1, -1, nullptr);
+    uv_fs_req_cleanup(&req);
+
+    if (nread < 0) {
+      *length = start;
+      return nread;
+    }
+    if (nread == 0) {
+      *eof = true;
+      break;
+    }
+
+    *length += nread;
+    if (*length - start >= max_read)
+      break;
+    if (*length == *capacity)
+      want = std::max(kReadChunkSize, *length - start);
+    else
+      want = 0;
+  }
+
+  return *length - start;
+}
+
+
+FSBatch::FSBatch(std::vector<int32_t>&& ops, std::vector<std::string>&& paths)
+    : ops_(std::move(ops)),
+      paths_(std::move(paths)),
+      op_count_(ops_.size() / kOpFields),
+      results_(node::Calloc<double>(op_count_ * kResultFields)) {
+}
+
+
+FSBatch::~FSBatch() {
+  free(results_);
+  free(data_);
+}
+
+
+void FSBatch::Run(uv_loop_t* loop) {
+  uv_file fd = -1;
+  int64_t size_hint = -1;
+
+  for (size_t i = 0; i < op_count_; i++) {
+    const int32_t* op = &ops_[i * kOpFields];
+    double* fields = &results_[i * kResultFields];
+    uv_fs_t req;
+    int err;
+
+    switch (op[0]) {
+      case FS_BATCH_OPEN:
+        CHECK_LT(fd, 0);  // Batch() makes sure the previous file was closed.
+        err = uv_fs_open(loop, &req, paths_[op[1]].c_str(), op[2], op[3],
+                         nullptr);
+        break;
+      case FS_BATCH_STAT:
+        err = uv_fs_stat(loop, &req, paths_[op[1]].c_str(), nullptr);
+        break;
+      case FS_BATCH_LSTAT:
+        err = uv_fs_lstat(loop, &req, paths_[op[1]].c_str(), nullptr);
+        break;
+      case FS_BATCH_FSTAT:
+        if (fd < 0) {
+          fields[0] = UV_EBADF;
+          continue;
+        }
+        err = uv_fs_fstat(loop, &req, fd, nullptr);
+        break;
+      case FS_BATCH_READ_ALL:
+        fields[0] = UV_EBADF;
+        if (fd >= 0) {
+          bool eof;
+          fields[1] = data_length_;
+          fields[0] = ReadToEnd(loop, fd, size_hint, Buffer::kMaxLength,
+                                &data_, &data_length_, &data_capacity_, &eof);
+        }
+        continue;
+      case FS_BATCH_CLOSE:
+        if (fd < 0) {
+          fields[0] = UV_EBADF;
+          continue;
+        }
+        err = uv_fs_close(loop, &req, fd, nullptr);
+        break;
+      default:
+        UNREACHABLE();
+    }
+
+    fields[0] = err;
+    if (op[0] == FS_BATCH_OPEN || op[0] == FS_BATCH_CLOSE) {
+      fd = op[0] == FS_BATCH_OPEN ? err : -1;
+      size_hint = -1;
+    } else if (err == 0) {
+      const uv_stat_t* s = static_cast<const uv_stat_t*>(req.ptr);
+      FillStatsArray(fields + 1, s);
+      if (op[0] == FS_BATCH_FSTAT && (s->st_mode & S_IFMT) == S_IFREG)
+        size_hint = s->st_size;
+    }
+    uv_fs_req_cleanup(&req);
+  }
+}
+
+
+Local<Value> FSBatch::TakeResults(Environment* env) {
+  const size_t length = op_count_ * kResultFields;
+  Local<ArrayBuffer> ab =
+      ArrayBuffer::New(env->isolate(),
+                       results_,
+                       length * sizeof(*results_),
+                       v8::ArrayBufferCreationMode::kInternalized);
+  results_ = nullptr;
+  return Float64Array::New(ab, 0, length);
+}
+
+
+Local<Value> FSBatch::TakeData(Environment* env) {
+  if (data_length_ == 0)
+    return Buffer::New(env, 0).ToLocalChecked();
+
+  char* data = node::Realloc(data_, data_length_);
+  const size_t length = data_length_;
+  data_ = nullptr;
+  data_length_ = data_capacity_ = 0;
+  return Buffer::New(env, data, length).ToLocalChecked();
+}
+
+
+FSBatchReqWrap::FSBatchReqWrap(Environment* env,
+                               Local<Object> req,
+                               std::unique_ptr<FSBatch> batch)
+    : ReqWrap(env, req, AsyncWrap::PROVIDER_FSREQWRAP),
+      batch_(std::move(batch)) {
+  Wrap(object(), this);
+}
+
+
+FSBatchReqWrap::~FSBatchReqWrap() {
+  ClearWrap(object());
+}
+
+
+void FSBatchReqWrap::Work(uv_work_t* req) {
+  FSBatchReqWrap* req_wrap = static_cast<FSBatchReqWrap*>(req->data);
+  req_wrap->batch_->Run(req->loop);
+}
+
+
+void FSBatchReqWrap::After(uv_work_t* req, int status) {
+  CHECK_EQ(status, 0);
+  std::unique_ptr<FSBatchReqWrap> req_wrap(
+      static_cast<FSBatchReqWrap*>(req->data));
+  Environment* env = req_wrap->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  Local<Value> argv[] = {
+    Null(env->isolate()),
+    req_wrap->batch_->TakeResults(env),
+    req_wrap->batch_->TakeData(env)
+  };
+  req_wrap->MakeCallback(env->oncomplete_string(), arraysize(argv), argv);
+}
+
+
+/*
+ * Runs a list of operations in one go, see FSBatch.
+ *
+ * 0 ops       Int32Array of FSBatch::kOpFields values per op
+ * 1 paths     array of strings or buffers that ops refer to by index
+ * 2 req       FSReqWrap, oncomplete(null, results, data) is called with
+ *             the results of all ops; if omitted, the ops are executed
+ *             synchronously and [results, data] is returned
+ */
+static void Batch(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CHECK(args[0]->IsInt32Array());
+  CHECK(args[1]->IsArray());
+
+  Local<v8::Int32Array> ops_array = args[0].As<v8::Int32Array>();
+  CHECK_EQ(ops_array->Length() % FSBatch::kOpFields, 0);
+  std::vector<int32_t> ops(ops_array->Length());
+  if (!ops.empty())
+    ops_array->CopyContents(ops.data(), ops.size() * sizeof(ops[0]));
+
+  Local<Array> paths_array = args[1].As<Array>();
+  std::vector<std::string> paths;
+  paths.reserve(paths_array->Length());
+  for (uint32_t i = 0; i < paths_array->Length(); i++) {
+    BufferValue path(env->isolate(),
+                     paths_array->Get(env->context(), i).ToLocalChecked());
+    CHECK_NE(*path, nullptr);
+    paths.emplace_back(*path, path.length());
+  }
+
+  // Only one file can be open at a time, opening another one would leak the
+  // descriptor of the first.  The ops come from lib/ only.
+  bool open = false;
+  for (size_t i = 0; i < ops.size(); i += FSBatch::kOpFields) {
+    CHECK_GE(ops[i], 0);
+    CHECK_LT(ops[i], FS_BATCH_OP_COUNT);
+    if (ops[i] == FS_BATCH_OPEN ||
+        ops[i] == FS_BATCH_STAT ||
+        ops[i] == FS_BATCH_LSTAT) {
+      CHECK_GE(ops[i + 1], 0);
+      CHECK_LT(static_cast<size_t>(ops[i + 1]), paths.size());
+    }
+    if (ops[i] == FS_BATCH_OPEN) {
+      CHECK(!open);
+      open = true;
+    } else if (ops[i] == FS_BATCH_CLOSE) {
+      open = false;
+    }
+  }
+
+  std::unique_ptr<FSBatch> batch(
+      new FSBatch(std::move(ops), std::move(paths)));
+
+  if (args[2]->IsObject()) {
+    FSBatchReqWrap* req_wrap =
+        new FSBatchReqWrap(env, args[2].As<Object>(), std::move(batch));
+    req_wrap->Dispatched();
+    CHECK_EQ(0, uv_queue_work(env->event_loop(),
+                              req_wrap->req(),
+                              FSBatchReqWrap::Work,
+                              FSBatchReqWrap::After));
+    args.GetReturnValue().Set(req_wrap->persistent());
+  } else {
+    env->PrintSyncTrace();
+    batch->Run(env->event_loop());
+    Local<Array> ret = Array::New(env->isolate(), 2);
+    ret->Set(env->context(), 0, batch->TakeResults(env)).FromJust();
+    ret->Set(env->context(), 1, batch->TakeData(env)).FromJust();
+    args.GetReturnValue().Set(ret);
+  }
+}
+
+FSReadFile::FSReadFile(std::string&& path, uv_file fd, int flags, bool utf8)
+    : path_(std::move(path)),
+      fd_(fd),
+      flags_(flags),
+      utf8_(utf8) {
+}
+
+
+FSReadFile::~FSReadFile() {
+  free(data_);
+  free(utf16_);
+}
+
+
+bool FSReadFile::Run(uv_loop_t* loop) {
+  uv_fs_t req;
+  int err;
+  int64_t size_hint = -1;
+
+  if (!started_) {
+    started_ = true;
+    file_ = fd_;
+    if (file_ < 0) {
+      file_ = uv_fs_open(loop, &req, path_.c_str(), flags_, 0666, nullptr);
+      uv_fs_req_cleanup(&req);
+      if (file_ < 0) {
+        err_ = file_;
+        syscall_ = "open";
+        return true;
+      }
+    }
+
+    err = uv_fs_fstat(loop, &req, file_, nullptr);
+    if (err == 0) {
+      const uv_stat_t* s = static_cast<const uv_stat_t*>(req.ptr);
+      if ((s->st_mode & S_IFMT) == S_IFREG)
+        size_hint = s->st_size;
+    }
+    uv_fs_req_cleanup(&req);
+    if (err < 0) {
+      err_ = err;
+      syscall_ = "fstat";
+    }
+  }
+
+  if (err_ == 0) {
+    bool eof;
+    err = ReadToEnd(loop, file_, size_hint, kReadFileStepSize,
+                    &data_, &length_, &capacity_, &eof);
+    if (err < 0) {
+      err_ = err;
+      syscall_ = "read";
+    } else if (!eof) {
+      return false;
+    }
+  }
+
+  if (fd_ < 0) {
+    err = uv_fs_close(loop, &req, file_, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (err < 0 && err_ == 0) {
+      err_ = err;
+      syscall_ = "close";
+    }
+  }
+
+  if (err_ == 0 && utf8_)
+    Decode();
+  return true;
+}
+
+
+void FSReadFile::Decode() {
+  // Pure ASCII can be used as a one-byte string as-is.  Anything else is
+  // decoded to UTF-16 here, except for malformed input, which is left to
+  // V8's decoder on the main thread so that replacement characters are
+  // inserted exactly as before.
+  if (StringBytes::IsAscii(data_, length_)) {
+    one_byte_ = true;
+    return;
+  }
+  utf16_ = node::UncheckedMalloc<uint16_t>(length_);
+  if (utf16_ == nullptr)
+    return;
+  if (!StringBytes::DecodeUtf8(data_, length_, utf16_, &utf16_length_)) {
+    free(utf16_);
+    utf16_ = nullptr;
+    return;
+  }
+
+  // Like V8, keep text that fits into Latin-1 at one byte per character.
+  // It is never longer than the UTF-8 it was decoded from.
+  bool latin1 = true;
+  for (size_t i = 0; i < utf16_length_ && latin1; i++)
+    latin1 = utf16_[i] <= 0xFF;
+  if (latin1) {
+    for (size_t i = 0; i < utf16_length_; i++)
+      data_[i] = static_cast<char>(utf16_[i]);
+    length_ = utf16_length_;
+    one_byte_ = true;
+    free(utf16_);
+    utf16_ = nullptr;
+    return;
+  }
+
+  utf16_ = node::Realloc(utf16_, utf16_length_);
+  free(data_);
+  data_ = nullptr;
+  length_ = capacity_ = 0;
+}
+
+
+MaybeLocal<Value> FSReadFile::Finish(Environment* env, Local<Value>* error) {
+  Isolate* isolate = env->isolate();
+
+  if (err_ == UV_EFBIG) {
+    char message[128];
+    snprintf(message, sizeof(message),
+             "File size is greater than possible Buffer: 0x%x bytes",
+             Buffer::kMaxLength);
+    *error = v8::Exception::RangeError(OneByteString(isolate, message));
+    return MaybeLocal<Value>();
+  }
+
+  if (err_ < 0) {
+    // Only open() errors carry the path, like the individual bindings.
+    const bool with_path = fd_ < 0 && strcmp(syscall_, "open") == 0;
+    *error = UVException(isolate,
+                         err_,
+                         syscall_,
+                         nullptr,
+                         with_path ? path_.c_str() : nullptr,
+                         nullptr);
+    return MaybeLocal<Value>();
+  }
+
+  if (utf16_ != nullptr) {
+    uint16_t* utf16 = utf16_;
+    utf16_ = nullptr;
+    return StringBytes::EncodeOwned(isolate, utf16, utf16_length_, error);
+  }
+
+  if (length_ == 0) {
+    if (utf8_)
+      return String::Empty(isolate);
+    return Buffer::New(env, 0).ToLocalChecked();
+  }
+
+  if (one_byte_) {
+    char* data = node::Realloc(data_, length_);
+    data_ = nullptr;
+    return StringBytes::EncodeOwned(isolate, data, length_, error);
+  }
+
+  if (utf8_)
+    return StringBytes::Encode(isolate, data_, length_, UTF8, error);
+
+  char* data = node::Realloc(data_, length_);
+  data_ = nullptr;
+  return Buffer::New(env, data, length_).ToLocalChecked();
+}
+
+
+FSReadFileReqWrap::FSReadFileReqWrap(Environment* env,
+                                     Local<Object> req,
+                                     std::unique_ptr<FSReadFile> read_file)
+    : ReqWrap(env, req, AsyncWrap::PROVIDER_FSREQWRAP),
+      read_file_(std::move(read_file)) {
+  Wrap(object(), this);
+}
+
+
+FSReadFileReqWrap::~FSReadFileReqWrap() {
+  ClearWrap(object());
+}
+
+
+void FSReadFileReqWrap::Work(uv_work_t* req) {
+  FSReadFileReqWrap* req_wrap = static_cast<FSReadFileReqWrap*>(req->data);
+  req_wrap->done_ = req_wrap->read_file_->Run(req->loop);
+}
+
+
+void FSReadFileReqWrap::After(uv_work_t* req, int status) {
+  CHECK_EQ(status, 0);
+  std::unique_ptr<FSReadFileReqWrap> req_wrap(
+      static_cast<FSReadFileReqWrap*>(req->data));
+  Environment* env = req_wrap->env();
+
+  // Give other work a turn before the next part of the file is read.
+  if (!req_wrap->done_) {
+    CHECK_EQ(0, uv_queue_work(env->event_loop(),
+                              req,
+                              FSReadFileReqWrap::Work,
+                              FSReadFileReqWrap::After));
+    req_wrap.release();
+    return;
+  }
+
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  Local<Value> error;
+  MaybeLocal<Value> contents = req_wrap->read_file_->Finish(env, &error);
+  if (contents.IsEmpty()) {
+    Local<Value> argv[] = { error };
+    req_wrap->MakeCallback(env->oncomplete_string(), arraysize(argv), argv);
+  } else {
+    Local<Value> argv[] = {
+      Null(env->isolate()),
+      contents.ToLocalChecked()
+    };
+    req_wrap->MakeCallback(env->oncomplete_string(), arraysize(argv), argv);
+  }
+}
+
+
+/*
+ * Reads a whole file, see FSReadFile.
+ *
+ * 0 path      string or buffer, or an integer fd which is not closed
+ * 1 flags     integer. flags to open the file with
+ * 2 utf8      boolean. decode the contents as UTF-8 instead of returning a
+ *             Buffer
+ * 3 req       FSReqWrap, oncomplete(err, contents); if omitted, the file is
+ *             read synchronously and the contents are returned
+ */
+static void ReadFile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CHECK_GE(args.Length(), 3);
+  CHECK(args[1]->IsInt32());
+
+  std::string path;
+  uv_file fd = -1;
+  if (args[0]->IsNumber()) {
+    CHECK(args[0]->IsInt32());
+    fd = args[0].As<Integer>()->Value();
+  } else {
+    BufferValue path_value(env->isolate(), args[0]);
+    CHECK_NE(*path_value, nullptr);
+    path.assign(*path_value, path_value.length());
+  }
+  const int flags = args[1].As<Integer>()->Value();
+  const bool utf8 = args[2]->IsTrue();
+
+  std::unique_ptr<FSReadFile> read_file(
+      new FSReadFile(std::move(path), fd, flags, utf8));
+
+  if (args[3]->IsObject()) {
+    FSReadFileReqWrap* req_wrap =
+        new FSReadFileReqWrap(env, args[3].As<Object>(), std::move(read_file));
+    req_wrap->Dispatched();
+    CHECK_EQ(0, uv_queue_work(env->event_loop(),
+                              req_wrap->req(),
+                              FSReadFileReqWrap::Work,
+                              FSReadFileReqWrap::After));
+    args.GetReturnValue().Set(req_wrap->persistent());
+  } else {
+    env->PrintSyncTrace();
+    while (!read_file->Run(env->event_loop())) {}
+    Local<Value> error;
+    MaybeLocal<Value> contents = read_file->Finish(env, &error);
+    if (contents.IsEmpty())
+      env->isolate()->ThrowException(error);
+    else
+      args.GetReturnValue().Set(contents.ToLocalChecked());
+  }
+}
+
+
 void GetStatValues(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   double* fields = env->fs_stats_field_array();
@@ -1322,6 +1892,16 @@ void InitFs(Local<Object> target,
 
   env->SetMethod(target, "mkdtemp", Mkdtemp);
 
+  env->SetMethod(target, "batch", Batch);
+  NODE_DEFINE_CONSTANT(target, FS_BATCH_OPEN);
+  NODE_DEFINE_CONSTANT(target, FS_BATCH_STAT);
+  NODE_DEFINE_CONSTANT(target, FS_BATCH_LSTAT);
+  NODE_DEFINE_CONSTANT(target, FS_BATCH_FSTAT);
+  NODE_DEFINE_CONSTANT(target, FS_BATCH_READ_ALL);
+  NODE_DEFINE_CONSTANT(target, FS_BATCH_CLOSE);
+
+  env->SetMethod(target, "readFile", ReadFile);
+
   env->SetMethod(target, "getStatValues", GetStatValues);
 
   StatWatcher::Initialize(env, target);
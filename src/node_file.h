@@ -6,11 +6,16 @@
 #include "node.h"
 #include "req_wrap-inl.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace node {
 
 using v8::Context;
 using v8::HandleScope;
 using v8::Local;
+using v8::MaybeLocal;
 using v8::Object;
 using v8::Undefined;
 using v8::Value;
@@ -91,6 +96,130 @@ class FSReqAfterScope {
   Context::Scope context_scope_;
 };
 
+enum FSBatchOp {
+  FS_BATCH_OPEN,      // Open paths[arg0] with flags arg1 and mode arg2,
+                      // after the file opened before, if any, was closed.
+  FS_BATCH_STAT,      // stat() paths[arg0].
+  FS_BATCH_LSTAT,     // lstat() paths[arg0].
+  FS_BATCH_FSTAT,     // fstat() the file that was opened last.
+  FS_BATCH_READ_ALL,  // Read the file that was opened last until EOF.
+  FS_BATCH_CLOSE,     // Close the file that was opened last.
+  FS_BATCH_OP_COUNT
+};
+
+// A list of fs operations that is executed in one go, either synchronously
+// or as a single threadpool work item, so that e.g. open + fstat + read +
+// close of a small file or stat() of many paths costs one round-trip and
+// one callback instead of one of each per syscall.
+class FSBatch {
+ public:
+  // Every op is encoded as four int32 values: op, arg0, arg1, arg2.
+  static const size_t kOpFields = 4;
+
+  // Every op produces kResultFields doubles: its result (an fd, a byte
+  // count, 0 or a negative errno) followed by the stat fields for the stat
+  // ops, or the offset of the bytes read into the data buffer for
+  // FS_BATCH_READ_ALL.
+  static const size_t kResultFields = 1 + 14;
+
+  FSBatch(std::vector<int32_t>&& ops, std::vector<std::string>&& paths);
+  ~FSBatch();
+
+  // Executes all ops.  Does not touch V8, so it's safe to call from the
+  // threadpool.
+  void Run(uv_loop_t* loop);
+
+  // Hand the output over to JS, as a Float64Array and a Buffer.
+  Local<Value> TakeResults(Environment* env);
+  Local<Value> TakeData(Environment* env);
+
+ private:
+  std::vector<int32_t> ops_;
+  std::vector<std::string> paths_;
+  size_t op_count_;
+  double* results_;
+  char* data_ = nullptr;
+  size_t data_length_ = 0;
+  size_t data_capacity_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(FSBatch);
+};
+
+class FSBatchReqWrap : public ReqWrap<uv_work_t> {
+ public:
+  FSBatchReqWrap(Environment* env,
+                 Local<Object> req,
+                 std::unique_ptr<FSBatch> batch);
+  ~FSBatchReqWrap() override;
+
+  static void Work(uv_work_t* req);
+  static void After(uv_work_t* req, int status);
+
+  size_t self_size() const override { return sizeof(*this); }
+
+ private:
+  std::unique_ptr<FSBatch> batch_;
+};
+
+// Reads a whole file: open (unless an fd is given), fstat, read until EOF
+// into a buffer that is sized from fstat() up front, close and, optionally,
+// decode as UTF-8.  Files of up to kReadFileStepSize bytes take a single
+// work item; larger ones are read in steps of that size that are queued one
+// after the other, so that they do not hold a threadpool thread throughout.
+class FSReadFile {
+ public:
+  static const size_t kReadFileStepSize = 512 * 1024;
+
+  FSReadFile(std::string&& path, uv_file fd, int flags, bool utf8);
+  ~FSReadFile();
+
+  // Does the next step and returns true once the file has been read
+  // completely, or an error has occurred.  Does not touch V8, so it's safe
+  // to call from the threadpool.
+  bool Run(uv_loop_t* loop);
+
+  // Returns the contents as a Buffer, or a string when decoding as UTF-8,
+  // or an empty handle with |*error| set.
+  MaybeLocal<Value> Finish(Environment* env, Local<Value>* error);
+
+ private:
+  void Decode();
+
+  const std::string path_;
+  const uv_file fd_;
+  const int flags_;
+  const bool utf8_;
+  bool started_ = false;
+  uv_file file_ = -1;
+  int err_ = 0;
+  const char* syscall_ = nullptr;
+  char* data_ = nullptr;
+  size_t length_ = 0;
+  size_t capacity_ = 0;
+  bool one_byte_ = false;
+  uint16_t* utf16_ = nullptr;
+  size_t utf16_length_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(FSReadFile);
+};
+
+class FSReadFileReqWrap : public ReqWrap<uv_work_t> {
+ public:
+  FSReadFileReqWrap(Environment* env,
+                    Local<Object> req,
+                    std::unique_ptr<FSReadFile> read_file);
+  ~FSReadFileReqWrap() override;
+
+  static void Work(uv_work_t* req);
+  static void After(uv_work_t* req, int status);
+
+  size_t self_size() const override { return sizeof(*this); }
+
+ private:
+  std::unique_ptr<FSReadFile> read_file_;
+  bool done_ = false;
+};
+
 }  // namespace fs
 
 }  // namespace node
@@ -28,6 +28,10 @@ namespace {
 
 const char zero_bytes_256[256] = {};
 
+// The payload of the PINGs that are used for estimating the bandwidth-delay
+// product, see Http2Session::OnDataReceivedForBdp().
+const uint8_t kBdpPingPayload[8] = { 'n', 'o', 'd', 'e', 'b', 'd', 'p', 0 };
+
 inline Http2Stream* GetStream(Http2Session* session,
                               int32_t id,
                               nghttp2_data_source* source) {
@@ -186,6 +190,14 @@ Http2Options::Http2Options(Environment* env) {
   if (flags & (1 << IDX_OPTIONS_MAX_SESSION_MEMORY)) {
     SetMaxSessionMemory(buffer[IDX_OPTIONS_MAX_SESSION_MEMORY] * 1e6);
   }
+
+  // When set, the receive windows of the session and its streams are sized
+  // dynamically, up to this many bytes. See Http2Session::UpdateBdp().
+  if (flags & (1 << IDX_OPTIONS_MAX_ADAPTIVE_WINDOW_SIZE)) {
+    SetMaxAdaptiveWindowSize(
+        std::min<uint32_t>(buffer[IDX_OPTIONS_MAX_ADAPTIVE_WINDOW_SIZE],
+                           NGHTTP2_MAX_WINDOW_SIZE));
+  }
 }
 
 void Http2Session::Http2Settings::Init() {
@@ -495,6 +507,7 @@ Http2Session::Http2Session(Environment* env,
   Http2Options opts(env);
 
   max_session_memory_ = opts.GetMaxSessionMemory();
+  max_adaptive_window_size_ = opts.GetMaxAdaptiveWindowSize();
 
   uint32_t maxHeaderPairs = opts.GetMaxHeaderPairs();
   max_header_pairs_ =
@@ -514,18 +527,23 @@ Http2Session::Http2Session(Environment* env,
       = callback_struct_saved[hasGetPaddingCallback ? 1 : 0].callbacks;
 
   auto fn = type == NGHTTP2_SESSION_SERVER ?
-      nghttp2_session_server_new2 :
-      nghttp2_session_client_new2;
+      nghttp2_session_server_new3 :
+      nghttp2_session_client_new3;
+
+  // nghttp2 keeps a copy of this.
+  nghttp2_mem mem = {
+    this, NgHttp2Malloc, NgHttp2Free, NgHttp2Calloc, NgHttp2Realloc
+  };
 
   // This should fail only if the system is out of memory, which
   // is going to cause lots of other problems anyway, or if any
   // of the options are out of acceptable range, which we should
   // be catching before it gets this far. Either way, crash if this
   // fails.
-  CHECK_EQ(fn(&session_, callbacks, this, *opts), 0);
+  CHECK_EQ(fn(&session_, callbacks, this, *opts, &mem), 0);
 
-  outgoing_storage_.reserve(4096);
   outgoing_buffers_.reserve(32);
+  outgoing_write_wraps_.reserve(32);
 }
 
 void Http2Session::Unconsume() {
@@ -548,6 +566,14 @@ Http2Session::~Http2Session() {
   Unconsume();
   DEBUG_HTTP2SESSION(this, "freeing nghttp2 session");
   nghttp2_session_del(session_);
+  for (const OutgoingBlock& block : outgoing_blocks_)
+    free(block.data);
+  for (char* data : free_outgoing_blocks_)
+    free(data);
+  for (char* chunk : outgoing_file_chunks_)
+    free(chunk);
+  for (char* chunk : free_file_chunks_)
+    free(chunk);
 }
 
 inline bool HasHttp2Observer(Environment* env) {
@@ -618,6 +644,11 @@ inline void Http2Session::EmitStatistics() {
           FIXED_ONE_BYTE_STRING(env->isolate(), "framesReceived"),
           Integer::NewFromUnsigned(env->isolate(), entry->frame_count()),
           attr).FromJust();
+      obj->DefineOwnProperty(
+          context,
+          FIXED_ONE_BYTE_STRING(env->isolate(), "writeCount"),
+          Integer::NewFromUnsigned(env->isolate(), entry->write_count()),
+          attr).FromJust();
       obj->DefineOwnProperty(
           context,
           FIXED_ONE_BYTE_STRING(env->isolate(), "streamCount"),
@@ -695,6 +726,12 @@ inline void Http2Session::AddStream(Http2Stream* stream) {
   CHECK_GE(++statistics_.stream_count, 0);
   streams_[stream->id()] = stream;
   IncrementCurrentSessionMemory(stream->self_size());
+  // Open the new stream's local window to the current adaptive size right
+  // away rather than waiting for the next adjustment.
+  if (adaptive_window_size_ != NGHTTP2_INITIAL_WINDOW_SIZE) {
+    nghttp2_session_set_local_window_size(session_, NGHTTP2_FLAG_NONE,
+                                          stream->id(), adaptive_window_size_);
+  }
 }
 
 
@@ -1035,6 +1072,7 @@ inline int Http2Session::OnDataChunkReceived(nghttp2_session* handle,
     // so that it can send a WINDOW_UPDATE frame. This is a critical part of
     // the flow control process in http2
     CHECK_EQ(nghttp2_session_consume_connection(handle, len), 0);
+    session->OnDataReceivedForBdp(len);
     Http2Stream* stream = session->FindStream(id);
     // If the stream has been destroyed, ignore this chunk
     if (stream->IsDestroyed())
@@ -1150,8 +1188,19 @@ inline void Http2Session::HandleHeadersFrame(const nghttp2_frame* frame) {
   nghttp2_header* headers = stream->headers();
   size_t count = stream->headers_count();
 
-  Local<String> name_str;
-  Local<String> value_str;
+  // Values that are not in the HPACK static table are copied into a single
+  // packed string, and only their end offsets are passed along with the
+  // names. JS slices the values out of the packed string, which is a lot
+  // cheaper than creating (and later finalizing) one external string per
+  // value.
+  size_t packed_length = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (!nghttp2_rcbuf_is_static(headers[i].value))
+      packed_length += nghttp2_rcbuf_get_buf(headers[i].value).len;
+  }
+  MaybeStackBuffer<uint8_t, 4096> packed;
+  packed.AllocateSufficientStorage(packed_length);
+  size_t packed_offset = 0;
 
   Local<Array> holder = Array::New(isolate);
   Local<Function> fn = env()->push_values_to_array_function();
@@ -1169,13 +1218,20 @@ inline void Http2Session::HandleHeadersFrame(const nghttp2_frame* frame) {
     size_t j = 0;
     while (count > 0 && j < arraysize(argv) / 2) {
       nghttp2_header item = headers[n++];
-      // The header name and value are passed as external one-byte strings
-      name_str =
+      // Names are cached or internalized strings for the static table and
+      // short names, which covers almost all of them.
+      argv[j * 2] =
           ExternalHeader::New<true>(env(), item.name).ToLocalChecked();
-      value_str =
-          ExternalHeader::New<false>(env(), item.value).ToLocalChecked();
-      argv[j * 2] = name_str;
-      argv[j * 2 + 1] = value_str;
+      if (nghttp2_rcbuf_is_static(item.value)) {
+        argv[j * 2 + 1] =
+            ExternalHeader::New<false>(env(), item.value).ToLocalChecked();
+      } else {
+        nghttp2_vec vec = nghttp2_rcbuf_get_buf(item.value);
+        memcpy(*packed + packed_offset, vec.base, vec.len);
+        packed_offset += vec.len;
+        nghttp2_rcbuf_decref(item.value);
+        argv[j * 2 + 1] = Integer::NewFromUnsigned(isolate, packed_offset);
+      }
       count--;
       j++;
     }
@@ -1187,12 +1243,21 @@ inline void Http2Session::HandleHeadersFrame(const nghttp2_frame* frame) {
     }
   }
 
-  Local<Value> args[5] = {
+  CHECK_EQ(packed_offset, packed_length);
+  // All names and values have been released above.
+  stream->current_headers_length_ = 0;
+  stream->current_headers_.clear();
+
+  Local<Value> args[6] = {
     stream->object(),
     Integer::New(isolate, id),
     Integer::New(isolate, stream->headers_category()),
     Integer::New(isolate, frame->hd.flags),
-    holder
+    holder,
+    String::NewFromOneByte(isolate,
+                           *packed,
+                           v8::NewStringType::kNormal,
+                           packed_length).ToLocalChecked()
   };
   MakeCallback(env()->onheaders_string(), arraysize(args), args);
 }
@@ -1303,6 +1368,11 @@ inline void Http2Session::HandleAltSvcFrame(const nghttp2_frame* frame) {
 // Called by OnFrameReceived when a complete PING frame has been received.
 inline void Http2Session::HandlePingFrame(const nghttp2_frame* frame) {
   bool ack = frame->hd.flags & NGHTTP2_FLAG_ACK;
+  if (ack && bdp_ping_outstanding_ &&
+      memcmp(frame->ping.opaque_data, kBdpPingPayload, 8) == 0) {
+    UpdateBdp();
+    return;
+  }
   if (ack) {
     Http2Ping* ping = PopPing();
     if (ping != nullptr) {
@@ -1408,37 +1478,111 @@ void Http2Session::ClearOutgoing(int status) {
   CHECK_NE(flags_ & SESSION_STATE_SENDING, 0);
   flags_ &= ~SESSION_STATE_SENDING;
 
-  for (const nghttp2_stream_write& wr : outgoing_buffers_) {
-    WriteWrap* wrap = wr.req_wrap;
-    if (wrap != nullptr)
-      wrap->Done(status);
-  }
+  for (WriteWrap* wrap : outgoing_write_wraps_)
+    wrap->Done(status);
 
   outgoing_buffers_.clear();
-  outgoing_storage_.clear();
+  outgoing_write_wraps_.clear();
+
+  // Keep a few of the standard-sized blocks for the next write.
+  for (const OutgoingBlock& block : outgoing_blocks_) {
+    if (block.size == kOutgoingBlockSize &&
+        free_outgoing_blocks_.size() < kMaxPooledOutgoingBlocks) {
+      free_outgoing_blocks_.push_back(block.data);
+    } else {
+      free(block.data);
+    }
+  }
+  outgoing_blocks_.clear();
+  outgoing_block_offset_ = 0;
+  outgoing_storage_size_ = 0;
+  outgoing_tail_is_copy_ = false;
+
+  for (char* chunk : outgoing_file_chunks_)
+    ReleaseFileChunk(chunk);
+  outgoing_file_chunks_.clear();
+}
+
+char* Http2Session::AllocateFileChunk() {
+  if (free_file_chunks_.empty())
+    return Malloc(kFileChunkSize);
+  char* chunk = free_file_chunks_.back();
+  free_file_chunks_.pop_back();
+  return chunk;
+}
+
+// File chunks may still be referenced by the write that is in progress, in
+// which case they are only taken back once it has finished.
+void Http2Session::ReleaseFileChunk(char* chunk) {
+  if (flags_ & SESSION_STATE_SENDING)
+    outgoing_file_chunks_.push_back(chunk);
+  else if (free_file_chunks_.size() < kMaxPooledFileChunks)
+    free_file_chunks_.push_back(chunk);
+  else
+    free(chunk);
+}
+
+// Returns room for `size` bytes of copied outgoing data. Consecutive calls
+// return adjacent memory for as long as the current block has space left.
+// Blocks are never moved, so the pointers stay valid until ClearOutgoing().
+char* Http2Session::AllocateOutgoing(size_t size) {
+  if (!outgoing_blocks_.empty() &&
+      outgoing_blocks_.back().size - outgoing_block_offset_ >= size) {
+    char* data = outgoing_blocks_.back().data + outgoing_block_offset_;
+    outgoing_block_offset_ += size;
+    return data;
+  }
+
+  OutgoingBlock block;
+  if (size > kOutgoingBlockSize) {
+    // Oversized chunks get a block of their own, which is not pooled.
+    block = { Malloc(size), size };
+  } else if (!free_outgoing_blocks_.empty()) {
+    block = { free_outgoing_blocks_.back(), kOutgoingBlockSize };
+    free_outgoing_blocks_.pop_back();
+  } else {
+    block = { Malloc(kOutgoingBlockSize), kOutgoingBlockSize };
+  }
+  outgoing_blocks_.push_back(block);
+  outgoing_block_offset_ = size;
+  outgoing_tail_is_copy_ = false;
+  return block.data;
 }
 
 // Queue a given block of data for sending. This always creates a copy,
 // so it is used for the cases in which nghttp2 requests sending of a
-// small chunk of data.
+// small chunk of data. Copies that end up next to each other are sent
+// as a single buffer, so a burst of small frames does not turn into a
+// burst of tiny iovecs.
 void Http2Session::CopyDataIntoOutgoing(const uint8_t* src, size_t src_length) {
-  size_t offset = outgoing_storage_.size();
-  outgoing_storage_.resize(offset + src_length);
-  memcpy(&outgoing_storage_[offset], src, src_length);
+  char* data = AllocateOutgoing(src_length);
+  memcpy(data, src, src_length);
+  outgoing_storage_size_ += src_length;
 
-  // Store with a base of `nullptr` initially, since future resizes
-  // of the outgoing_buffers_ vector may invalidate the pointer.
-  // The correct base pointers will be set later, before writing to the
-  // underlying socket.
-  outgoing_buffers_.emplace_back(nghttp2_stream_write {
-    uv_buf_init(nullptr, src_length)
-  });
+  if (outgoing_tail_is_copy_) {
+    outgoing_buffers_.back().len += src_length;
+  } else {
+    outgoing_buffers_.push_back(uv_buf_init(data, src_length));
+    outgoing_tail_is_copy_ = true;
+  }
+}
+
+// Queue data that stays alive until the write has finished. Small chunks
+// are still copied, since that is cheaper than an extra iovec, while large
+// ones are written from where they are.
+void Http2Session::AddDataToOutgoing(const uv_buf_t& buf) {
+  if (buf.len <= kOutgoingCopyThreshold) {
+    CopyDataIntoOutgoing(reinterpret_cast<const uint8_t*>(buf.base), buf.len);
+    return;
+  }
+  outgoing_buffers_.push_back(buf);
+  outgoing_tail_is_copy_ = false;
 }
 
 // Prompts nghttp2 to begin serializing it's pending data and pushes each
 // chunk out to the i/o socket to be sent. This is a particularly hot method
 // that will generally be called at least twice be event loop iteration.
-// This is a potential performance optimization target later.
+// Everything that is pending is handed to the i/o stream as one write.
 void Http2Session::SendPendingData() {
   DEBUG_HTTP2SESSION(this, "sending pending data");
   // Do not attempt to send data on the socket if the destroying flag has
@@ -1458,7 +1602,8 @@ void Http2Session::SendPendingData() {
   const uint8_t* src;
 
   CHECK_EQ(outgoing_buffers_.size(), 0);
-  CHECK_EQ(outgoing_storage_.size(), 0);
+  CHECK_EQ(outgoing_write_wraps_.size(), 0);
+  CHECK_EQ(outgoing_storage_size_, 0);
 
   // Part One: Gather data from nghttp2
 
@@ -1481,33 +1626,16 @@ void Http2Session::SendPendingData() {
 
   size_t count = outgoing_buffers_.size();
   if (count == 0) {
-    flags_ &= ~SESSION_STATE_SENDING;
+    ClearOutgoing(0);
     return;
   }
-  MaybeStackBuffer<uv_buf_t, 32> bufs;
-  bufs.AllocateSufficientStorage(count);
-
-  // Set the buffer base pointers for copied data that ended up in the
-  // sessions's own storage since it might have shifted around during gathering.
-  // (Those are marked by having .base == nullptr.)
-  size_t offset = 0;
-  size_t i = 0;
-  for (const nghttp2_stream_write& write : outgoing_buffers_) {
-    if (write.buf.base == nullptr) {
-      bufs[i++] = uv_buf_init(
-          reinterpret_cast<char*>(outgoing_storage_.data() + offset),
-          write.buf.len);
-      offset += write.buf.len;
-    } else {
-      bufs[i++] = write.buf;
-    }
-  }
 
   chunks_sent_since_last_write_++;
+  statistics_.write_count++;
 
   // DoTryWrite may modify both the buffer list start itself and the
   // base pointers/length of the individual buffers.
-  uv_buf_t* writebufs = *bufs;
+  uv_buf_t* writebufs = outgoing_buffers_.data();
   if (stream_->DoTryWrite(&writebufs, &count) != 0 || count == 0) {
     // All writes finished synchronously, nothing more to do here.
     ClearOutgoing(0);
@@ -1539,6 +1667,7 @@ int Http2Session::OnSendData(
   Http2Stream* stream = GetStream(session, frame->hd.stream_id, source);
 
   // Send the frame header + a byte that indicates padding length.
+  // The header usually lands right behind the previous frame.
   session->CopyDataIntoOutgoing(framehd, 9);
   if (frame->data.padlen > 0) {
     uint8_t padding_byte = frame->data.padlen - 1;
@@ -1556,15 +1685,17 @@ int Http2Session::OnSendData(
     if (write.buf.len <= length) {
       // This write does not suffice by itself, so we can consume it completely.
       length -= write.buf.len;
-      session->outgoing_buffers_.emplace_back(std::move(write));
+      session->AddDataToOutgoing(write.buf);
+      if (write.req_wrap != nullptr)
+        session->outgoing_write_wraps_.push_back(write.req_wrap);
+      if (write.file_chunk != nullptr)
+        session->outgoing_file_chunks_.push_back(write.file_chunk);
       stream->queue_.pop();
       continue;
     }
 
     // Slice off `length` bytes of the first write in the queue.
-    session->outgoing_buffers_.emplace_back(nghttp2_stream_write {
-      uv_buf_init(write.buf.base, length)
-    });
+    session->AddDataToOutgoing(uv_buf_init(write.buf.base, length));
     write.buf.base += length;
     write.buf.len -= length;
     break;
@@ -1572,9 +1703,9 @@ int Http2Session::OnSendData(
 
   if (frame->data.padlen > 0) {
     // Send padding if that was requested.
-    session->outgoing_buffers_.emplace_back(nghttp2_stream_write {
-      uv_buf_init(const_cast<char*>(zero_bytes_256), frame->data.padlen - 1)
-    });
+    session->CopyDataIntoOutgoing(
+        reinterpret_cast<const uint8_t*>(zero_bytes_256),
+        frame->data.padlen - 1);
   }
 
   return 0;
@@ -1639,7 +1770,7 @@ void Http2Session::OnStreamReadImpl(ssize_t nread,
                               session->prev_read_cb_.ctx);
     return;
   }
-  if (bufs->len > 0) {
+  if (nread > 0) {
     // Only pass data on if nread > 0
     uv_buf_t buf[] { uv_buf_init((*bufs).base, nread) };
     ssize_t ret = session->Write(buf, 1);
@@ -1728,7 +1859,23 @@ Http2Stream::Http2Stream(
 }
 
 
+// A read of one chunk of file data. It outlives the Http2Stream if the
+// stream is destroyed while the read is in progress.
+class Http2Stream::FileRead {
+ public:
+  FileRead(Http2Stream* stream, char* chunk, size_t size)
+      : stream(stream), chunk(chunk), size(size) {}
+
+  uv_fs_t req;
+  Http2Stream* stream;
+  char* chunk;
+  size_t size;
+};
+
 Http2Stream::~Http2Stream() {
+  if (fd_read_ != nullptr)
+    fd_read_->stream = nullptr;
+
   if (session_ != nullptr) {
     session_->RemoveStream(this);
     session_ = nullptr;
@@ -1744,9 +1891,17 @@ Http2Stream::~Http2Stream() {
 void Http2Stream::StartHeaders(nghttp2_headers_category category) {
   DEBUG_HTTP2STREAM2(this, "starting headers, category: %d", id_, category);
   CHECK(!this->IsDestroyed());
+  ClearHeaders();
+  current_headers_category_ = category;
+}
+
+void Http2Stream::ClearHeaders() {
+  for (const nghttp2_header& header : current_headers_) {
+    nghttp2_rcbuf_decref(header.name);
+    nghttp2_rcbuf_decref(header.value);
+  }
   current_headers_length_ = 0;
   current_headers_.clear();
-  current_headers_category_ = category;
 }
 
 
@@ -1838,6 +1993,14 @@ inline void Http2Stream::Destroy() {
 
   DEBUG_HTTP2STREAM(this, "destroying stream");
 
+  // A pending file read finishes on its own and drops its data.
+  if (fd_read_ != nullptr) {
+    fd_read_->stream = nullptr;
+    fd_read_ = nullptr;
+  }
+
+  ClearHeaders();
+
   // Free any remaining incoming data chunks.
   while (!data_chunks_.empty()) {
     uv_buf_t buf = data_chunks_.front();
@@ -1856,6 +2019,12 @@ inline void Http2Stream::Destroy() {
       nghttp2_stream_write& head = stream->queue_.front();
       if (head.req_wrap != nullptr)
         head.req_wrap->Done(UV_ECANCELED);
+      if (head.file_chunk != nullptr) {
+        if (stream->session_ != nullptr)
+          stream->session_->ReleaseFileChunk(head.file_chunk);
+        else
+          free(head.file_chunk);
+      }
       stream->queue_.pop();
     }
 
@@ -1936,12 +2105,15 @@ inline int Http2Stream::SubmitFile(int fd,
   if (options & STREAM_OPTION_GET_TRAILERS)
     flags_ |= NGHTTP2_STREAM_FLAG_TRAILERS;
 
+  fd_ = fd;
   if (offset > 0) fd_offset_ = offset;
   if (length > -1) fd_length_ = length;
 
   Http2Stream::Provider::FD prov(this, options, fd);
   int ret = nghttp2_submit_response(session_->session(), id_, nva, len, *prov);
   CHECK_NE(ret, NGHTTP2_ERR_NOMEM);
+  if (ret == 0)
+    ReadFileAhead();
   return ret;
 }
 
@@ -2132,6 +2304,9 @@ Http2Stream::Provider::FD::FD(int options, int fd)
   provider_.read_callback = Http2Stream::Provider::FD::OnRead;
 }
 
+// Data for the FD Provider is read ahead asynchronously, see ReadFileAhead(),
+// and sent straight from the chunks it was read into. Until a chunk is
+// ready, the stream is deferred.
 ssize_t Http2Stream::Provider::FD::OnRead(nghttp2_session* handle,
                                           int32_t id,
                                           uint8_t* buf,
@@ -2145,41 +2320,23 @@ ssize_t Http2Stream::Provider::FD::OnRead(nghttp2_session* handle,
   DEBUG_HTTP2SESSION2(session, "reading outbound file data for stream %d", id);
   CHECK_EQ(id, stream->id());
 
-  int fd = source->fd;
-  int64_t offset = stream->fd_offset_;
-  ssize_t numchars = 0;
-
-  if (stream->fd_length_ >= 0 &&
-      stream->fd_length_ < static_cast<int64_t>(length))
-    length = stream->fd_length_;
-
-  uv_buf_t data;
-  data.base = reinterpret_cast<char*>(buf);
-  data.len = length;
-
-  uv_fs_t read_req;
-
-  if (length > 0) {
-    // TODO(addaleax): Never use synchronous I/O on the main thread.
-    numchars = uv_fs_read(session->event_loop(),
-                          &read_req,
-                          fd, &data, 1,
-                          offset, nullptr);
-    uv_fs_req_cleanup(&read_req);
-  }
-
   // Close the stream with an error if reading fails
-  if (numchars < 0)
+  if (stream->flags_ & NGHTTP2_STREAM_FLAG_FILE_ERROR)
     return NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE;
 
-  // Update the read offset for the next read
-  stream->fd_offset_ += numchars;
-  stream->fd_length_ -= numchars;
+  size_t amount = std::min(stream->available_outbound_length_, length);
+  if (amount > 0) {
+    // Let Http2Session::OnSendData take the chunks out of the queue.
+    *flags |= NGHTTP2_DATA_FLAG_NO_COPY;
+    stream->DecrementAvailableOutboundLength(amount);
+  }
 
-  DEBUG_HTTP2SESSION2(session, "sending %d bytes", numchars);
+  // Sending data may have opened up room for reading more.
+  stream->ReadFileAhead();
 
-  // if numchars < length, assume that we are done.
-  if (static_cast<size_t>(numchars) < length || length <= 0) {
+  if (stream->available_outbound_length_ == 0 &&
+      stream->fd_read_ == nullptr &&
+      (stream->flags_ & NGHTTP2_STREAM_FLAG_FILE_EOF)) {
     DEBUG_HTTP2SESSION2(session, "no more data for stream %d", id);
     *flags |= NGHTTP2_DATA_FLAG_EOF;
     session->GetTrailers(stream, flags);
@@ -2189,9 +2346,104 @@ ssize_t Http2Stream::Provider::FD::OnRead(nghttp2_session* handle,
       return NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE;
     if (session->IsDestroyed())
       return NGHTTP2_ERR_CALLBACK_FAILURE;
+  } else if (amount == 0) {
+    DEBUG_HTTP2SESSION2(session, "waiting for file data for stream %d", id);
+    return NGHTTP2_ERR_DEFERRED;
+  }
+
+  DEBUG_HTTP2SESSION2(session, "sending %d bytes", amount);
+  return amount;
+}
+
+// Keeps file data for a respondWithFD() response buffered, one chunk read at
+// a time. How far ahead we read depends on how much data the peer currently
+// allows us to send, so that a slow reader does not make us hold on to more
+// of the file than it can take.
+void Http2Stream::ReadFileAhead() {
+  if (fd_read_ != nullptr || IsDestroyed() ||
+      (flags_ & (NGHTTP2_STREAM_FLAG_FILE_EOF |
+                 NGHTTP2_STREAM_FLAG_FILE_ERROR))) {
+    return;
+  }
+
+  int32_t window = std::min(
+      nghttp2_session_get_stream_remote_window_size(**session_, id_),
+      nghttp2_session_get_remote_window_size(**session_));
+  size_t target = kFileChunkSize;
+  if (window > static_cast<int32_t>(kFileChunkSize))
+    target = std::min(static_cast<size_t>(window),
+                      kMaxFileReadAhead * kFileChunkSize);
+  if (available_outbound_length_ >= target)
+    return;
+
+  size_t size = kFileChunkSize;
+  if (fd_length_ >= 0 && fd_length_ < static_cast<int64_t>(size))
+    size = fd_length_;
+  if (size == 0) {
+    flags_ |= NGHTTP2_STREAM_FLAG_FILE_EOF;
+    return;
+  }
+
+  FileRead* read = new FileRead(this, session_->AllocateFileChunk(), size);
+  uv_buf_t buf = uv_buf_init(read->chunk, size);
+  int err = uv_fs_read(env()->event_loop(), &read->req,
+                       fd_, &buf, 1, fd_offset_, OnFileRead);
+  if (err < 0) {
+    session_->ReleaseFileChunk(read->chunk);
+    delete read;
+    flags_ |= NGHTTP2_STREAM_FLAG_FILE_ERROR;
+    return;
+  }
+  fd_read_ = read;
+}
+
+void Http2Stream::OnFileRead(uv_fs_t* req) {
+  FileRead* read = ContainerOf(&FileRead::req, req);
+  const ssize_t result = req->result;
+  uv_fs_req_cleanup(req);
+
+  Http2Stream* stream = read->stream;
+  char* chunk = read->chunk;
+  const size_t requested = read->size;
+  delete read;
+  if (stream == nullptr) {
+    free(chunk);
+    return;
   }
+  stream->fd_read_ = nullptr;
 
-  return numchars;
+  Http2Session* session = stream->session();
+  if (session->IsDestroyed()) {
+    free(chunk);
+    return;
+  }
+  Environment* env = stream->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+  Http2Scope h2scope(stream);
+
+  if (result > 0) {
+    nghttp2_stream_write write(uv_buf_init(chunk, result));
+    write.file_chunk = chunk;
+    stream->queue_.push(write);
+    stream->IncrementAvailableOutboundLength(result);
+    stream->fd_offset_ += result;
+    if (stream->fd_length_ >= 0)
+      stream->fd_length_ -= result;
+  } else {
+    session->ReleaseFileChunk(chunk);
+  }
+
+  if (result < 0)
+    stream->flags_ |= NGHTTP2_STREAM_FLAG_FILE_ERROR;
+  else if (static_cast<size_t>(result) < requested || stream->fd_length_ == 0)
+    stream->flags_ |= NGHTTP2_STREAM_FLAG_FILE_EOF;
+
+  DEBUG_HTTP2SESSION2(session, "read %d bytes of file data for stream %d",
+                      result, stream->id());
+  stream->ReadFileAhead();
+  CHECK_NE(nghttp2_session_resume_data(**session, stream->id()),
+           NGHTTP2_ERR_NOMEM);
 }
 
 // The Stream Provider pulls data from a linked list of uv_buf_t structs
@@ -2353,6 +2605,8 @@ void Http2Session::RefreshState(const FunctionCallbackInfo<Value>& args) {
       nghttp2_session_get_hd_deflate_dynamic_table_size(s);
   buffer[IDX_SESSION_STATE_HD_INFLATE_DYNAMIC_TABLE_SIZE] =
       nghttp2_session_get_hd_inflate_dynamic_table_size(s);
+  buffer[IDX_SESSION_STATE_MEMORY_USAGE] =
+      session->GetCurrentSessionMemory();
 }
 
 
@@ -2749,6 +3003,102 @@ void Http2Session::Settings(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Every allocation is prefixed with its size, so that it can be subtracted
+// again when the memory is released.
+void* Http2Session::NgHttp2Malloc(size_t size, void* user_data) {
+  return NgHttp2Realloc(nullptr, size, user_data);
+}
+
+void* Http2Session::NgHttp2Calloc(size_t nmemb, size_t size, void* user_data) {
+  size_t total = nmemb * size;
+  if (size != 0 && total / size != nmemb)
+    return nullptr;
+  void* mem = NgHttp2Malloc(total, user_data);
+  if (mem != nullptr)
+    memset(mem, 0, total);
+  return mem;
+}
+
+void* Http2Session::NgHttp2Realloc(void* ptr, size_t size, void* user_data) {
+  Http2Session* session = static_cast<Http2Session*>(user_data);
+  char* original = nullptr;
+  size_t previous_size = 0;
+  if (ptr != nullptr) {
+    original = static_cast<char*>(ptr) - sizeof(size_t);
+    memcpy(&previous_size, original, sizeof(size_t));
+  }
+  if (size == 0) {
+    NgHttp2Free(ptr, user_data);
+    return nullptr;
+  }
+
+  char* mem = UncheckedRealloc(original, size + sizeof(size_t));
+  if (mem == nullptr)
+    return nullptr;
+  session->current_nghttp2_memory_ += size;
+  session->current_nghttp2_memory_ -= previous_size;
+  memcpy(mem, &size, sizeof(size_t));
+  return mem + sizeof(size_t);
+}
+
+void Http2Session::NgHttp2Free(void* ptr, void* user_data) {
+  if (ptr == nullptr)
+    return;
+  Http2Session* session = static_cast<Http2Session*>(user_data);
+  char* original = static_cast<char*>(ptr) - sizeof(size_t);
+  size_t size;
+  memcpy(&size, original, sizeof(size_t));
+  session->current_nghttp2_memory_ -= size;
+  free(original);
+}
+
+
+// Counts received DATA towards the current bandwidth-delay product sample,
+// starting a new sample if none is being taken.
+void Http2Session::OnDataReceivedForBdp(size_t length) {
+  if (max_adaptive_window_size_ == 0)
+    return;
+  bdp_bytes_ += length;
+  if (bdp_ping_outstanding_)
+    return;
+  if (nghttp2_submit_ping(session_, NGHTTP2_FLAG_NONE, kBdpPingPayload) == 0) {
+    bdp_ping_outstanding_ = true;
+    bdp_bytes_ = length;
+  }
+}
+
+// Called when the PING sent by OnDataReceivedForBdp() has been acknowledged.
+// If close to a full window of data arrived during that round trip, the
+// window is what limits the peer, so it is grown to twice the amount that
+// was received. Under memory pressure, the windows are halved instead, down
+// to the initial size.
+void Http2Session::UpdateBdp() {
+  bdp_ping_outstanding_ = false;
+  int32_t size = adaptive_window_size_;
+  if (GetCurrentSessionMemory() > max_session_memory_ / 2) {
+    size = std::max(size / 2, NGHTTP2_INITIAL_WINDOW_SIZE);
+  } else if (bdp_bytes_ >= static_cast<uint64_t>(size) / 3 * 2) {
+    size = static_cast<int32_t>(
+        std::min<uint64_t>(bdp_bytes_ * 2, max_adaptive_window_size_));
+    size = std::max(size, adaptive_window_size_);
+  }
+  DEBUG_HTTP2SESSION2(this, "bdp sample: %d bytes, window size: %d",
+                      static_cast<int>(bdp_bytes_), size);
+  bdp_bytes_ = 0;
+  if (size != adaptive_window_size_)
+    SetAdaptiveWindowSize(size);
+}
+
+void Http2Session::SetAdaptiveWindowSize(int32_t size) {
+  adaptive_window_size_ = size;
+  nghttp2_session_set_local_window_size(session_, NGHTTP2_FLAG_NONE, 0, size);
+  for (const auto& stream : streams_) {
+    nghttp2_session_set_local_window_size(session_, NGHTTP2_FLAG_NONE,
+                                          stream.first, size);
+  }
+}
+
+
 Http2Session::Http2Ping* Http2Session::PopPing() {
   Http2Ping* ping = nullptr;
   if (!outstanding_pings_.empty()) {
@@ -124,7 +124,11 @@ enum nghttp2_stream_flags {
   // Stream has trailers
   NGHTTP2_STREAM_FLAG_TRAILERS = 0x20,
   // Stream has received all the data it can
-  NGHTTP2_STREAM_FLAG_EOS = 0x40
+  NGHTTP2_STREAM_FLAG_EOS = 0x40,
+  // All of the file of a respondWithFD() response has been read
+  NGHTTP2_STREAM_FLAG_FILE_EOF = 0x80,
+  // Reading the file of a respondWithFD() response has failed
+  NGHTTP2_STREAM_FLAG_FILE_ERROR = 0x100
 };
 
 enum nghttp2_stream_options {
@@ -137,6 +141,8 @@ enum nghttp2_stream_options {
 struct nghttp2_stream_write {
   WriteWrap* req_wrap = nullptr;
   uv_buf_t buf;
+  // A chunk of file data that is returned to the session once written
+  char* file_chunk = nullptr;
 
   inline explicit nghttp2_stream_write(uv_buf_t buf_) : buf(buf_) {}
   inline nghttp2_stream_write(WriteWrap* req, uv_buf_t buf_) :
@@ -436,6 +442,23 @@ enum session_state_flags {
 // This allows for 4 default-sized frames with their frame headers
 static const size_t kAllocBufferSize = 4 * (16384 + 9);
 
+// Outgoing frames that nghttp2 serializes itself are copied into blocks of
+// this size, see Http2Session::CopyDataIntoOutgoing(). At most
+// kMaxPooledOutgoingBlocks of them are kept around between writes.
+static const size_t kOutgoingBlockSize = 16384;
+static const size_t kMaxPooledOutgoingBlocks = 4;
+
+// DATA payloads up to this size are copied next to their frame header instead
+// of being written from the buffer that was passed to the Http2Stream.
+static const size_t kOutgoingCopyThreshold = 1024;
+
+// respondWithFD() responses are read ahead into chunks that hold one default
+// sized DATA frame each. At most kMaxFileReadAhead chunks are buffered per
+// stream, fewer if the peer's flow control window is smaller than that.
+static const size_t kFileChunkSize = 16384;
+static const size_t kMaxFileReadAhead = 8;
+static const size_t kMaxPooledFileChunks = 16;
+
 typedef uint32_t(*get_setting)(nghttp2_session* session,
                                nghttp2_settings_id id);
 
@@ -512,9 +535,18 @@ class Http2Options {
     return max_session_memory_;
   }
 
+  void SetMaxAdaptiveWindowSize(int32_t max) {
+    max_adaptive_window_size_ = max;
+  }
+
+  int32_t GetMaxAdaptiveWindowSize() const {
+    return max_adaptive_window_size_;
+  }
+
  private:
   nghttp2_option* options_;
   uint64_t max_session_memory_ = DEFAULT_MAX_SESSION_MEMORY;
+  int32_t max_adaptive_window_size_ = 0;
   uint32_t max_header_pairs_ = DEFAULT_MAX_HEADER_LIST_PAIRS;
   padding_strategy_type padding_strategy_ = PADDING_STRATEGY_NONE;
   size_t max_outstanding_pings_ = DEFAULT_MAX_PINGS;
@@ -662,6 +694,10 @@ class Http2Stream : public AsyncWrap,
 
   void StartHeaders(nghttp2_headers_category category);
 
+  // Releases the names and values of the current block of HEADERS, if they
+  // have not been passed to JS land.
+  void ClearHeaders();
+
   // Required for StreamBase
   bool IsAlive() override {
     return true;
@@ -744,8 +780,17 @@ class Http2Stream : public AsyncWrap,
   // waiting to be written out to the socket.
   std::queue<nghttp2_stream_write> queue_;
   size_t available_outbound_length_ = 0;
+
+  // Outbound file data... For respondWithFD(), the file is read
+  // asynchronously into chunks that are queued like regular writes.
+  class FileRead;
+  void ReadFileAhead();
+  static void OnFileRead(uv_fs_t* req);
+
+  int fd_ = -1;
   int64_t fd_offset_ = 0;
   int64_t fd_length_ = -1;
+  FileRead* fd_read_ = nullptr;
 
   friend class Http2Session;
 };
@@ -870,6 +915,10 @@ class Http2Session : public AsyncWrap {
 
   inline void SetChunksSinceLastWrite(size_t n = 0);
 
+  // Hand out and take back kFileChunkSize buffers for respondWithFD() data.
+  char* AllocateFileChunk();
+  void ReleaseFileChunk(char* chunk);
+
   size_t self_size() const override { return sizeof(*this); }
 
   char* stream_alloc() {
@@ -929,14 +978,13 @@ class Http2Session : public AsyncWrap {
     current_session_memory_ -= amount;
   }
 
-  // Returns the current session memory including the current size of both
-  // the inflate and deflate hpack headers, the current outbound storage
-  // queue, and pending writes.
+  // Returns the current session memory including everything nghttp2 has
+  // allocated for the session (e.g. the hpack tables and buffered frames),
+  // the current outbound storage queue, and pending writes.
   uint64_t GetCurrentSessionMemory() {
     uint64_t total = current_session_memory_ + sizeof(Http2Session);
-    total += nghttp2_session_get_hd_deflate_dynamic_table_size(session_);
-    total += nghttp2_session_get_hd_inflate_dynamic_table_size(session_);
-    total += outgoing_storage_.size();
+    total += current_nghttp2_memory_;
+    total += outgoing_storage_size_;
     return total;
   }
 
@@ -950,6 +998,7 @@ class Http2Session : public AsyncWrap {
     uint64_t end_time;
     uint64_t ping_rtt;
     uint32_t frame_count;
+    uint32_t write_count;
     int32_t stream_count;
     double stream_average_duration;
   };
@@ -972,6 +1021,18 @@ class Http2Session : public AsyncWrap {
   inline void HandlePriorityFrame(const nghttp2_frame* frame);
   inline void HandleSettingsFrame(const nghttp2_frame* frame);
   inline void HandlePingFrame(const nghttp2_frame* frame);
+
+  // Adaptive flow control
+  void OnDataReceivedForBdp(size_t length);
+  void UpdateBdp();
+  void SetAdaptiveWindowSize(int32_t size);
+
+  // nghttp2 allocates through these, so that its memory can be accounted
+  // for as part of the session's memory.
+  static void* NgHttp2Malloc(size_t size, void* user_data);
+  static void* NgHttp2Calloc(size_t nmemb, size_t size, void* user_data);
+  static void* NgHttp2Realloc(void* ptr, size_t size, void* user_data);
+  static void NgHttp2Free(void* ptr, void* user_data);
   inline void HandleAltSvcFrame(const nghttp2_frame* frame);
 
   // nghttp2 callbacks
@@ -1077,6 +1138,16 @@ class Http2Session : public AsyncWrap {
   // The maximum amount of memory allocated for this session
   uint64_t max_session_memory_ = DEFAULT_MAX_SESSION_MEMORY;
   uint64_t current_session_memory_ = 0;
+  uint64_t current_nghttp2_memory_ = 0;
+
+  // Adaptive flow control: The receive windows of the session and all of its
+  // streams are adjusted to the bandwidth-delay product, which is estimated
+  // by counting the bytes received during the round trip of a PING. 0 for
+  // max_adaptive_window_size_ means that the windows are left alone.
+  int32_t max_adaptive_window_size_ = 0;
+  int32_t adaptive_window_size_ = NGHTTP2_INITIAL_WINDOW_SIZE;
+  bool bdp_ping_outstanding_ = false;
+  uint64_t bdp_bytes_ = 0;
 
   // The collection of active Http2Streams associated with this session
   std::unordered_map<int32_t, Http2Stream*> streams_;
@@ -1101,10 +1172,33 @@ class Http2Session : public AsyncWrap {
   size_t max_outstanding_settings_ = DEFAULT_MAX_SETTINGS;
   std::queue<Http2Settings*> outstanding_settings_;
 
-  std::vector<nghttp2_stream_write> outgoing_buffers_;
-  std::vector<uint8_t> outgoing_storage_;
+  struct OutgoingBlock {
+    char* data;
+    size_t size;
+  };
 
+  // The buffers that make up the next write to the i/o stream, and the
+  // WriteWraps that are finished once that write has completed.
+  std::vector<uv_buf_t> outgoing_buffers_;
+  std::vector<WriteWrap*> outgoing_write_wraps_;
+  // Blocks that hold copied data for the current write, and the blocks that
+  // are kept for the next one.
+  std::vector<OutgoingBlock> outgoing_blocks_;
+  std::vector<char*> free_outgoing_blocks_;
+  size_t outgoing_block_offset_ = 0;
+  size_t outgoing_storage_size_ = 0;
+  // Whether the last entry of outgoing_buffers_ ends where the next copy
+  // will be placed, so that the copy can extend it.
+  bool outgoing_tail_is_copy_ = false;
+
+  // Chunks for respondWithFD() file data that are not in use, and the ones
+  // that are part of the current write.
+  std::vector<char*> free_file_chunks_;
+  std::vector<char*> outgoing_file_chunks_;
+
+  char* AllocateOutgoing(size_t size);
   void CopyDataIntoOutgoing(const uint8_t* src, size_t src_length);
+  void AddDataToOutgoing(const uv_buf_t& buf);
   void ClearOutgoing(int status);
 
   friend class Http2Scope;
@@ -1121,12 +1215,14 @@ class Http2SessionPerformanceEntry : public PerformanceEntry {
                            stats.end_time),
           ping_rtt_(stats.ping_rtt),
           frame_count_(stats.frame_count),
+          write_count_(stats.write_count),
           stream_count_(stats.stream_count),
           stream_average_duration_(stats.stream_average_duration),
           kind_(kind) { }
 
   uint64_t ping_rtt() const { return ping_rtt_; }
   uint32_t frame_count() const { return frame_count_; }
+  uint32_t write_count() const { return write_count_; }
   int32_t stream_count() const { return stream_count_; }
   double stream_average_duration() const { return stream_average_duration_; }
   const char* typeName() const { return kind_; }
@@ -1138,6 +1234,7 @@ class Http2SessionPerformanceEntry : public PerformanceEntry {
  private:
   uint64_t ping_rtt_;
   uint32_t frame_count_;
+  uint32_t write_count_;
   int32_t stream_count_;
   double stream_average_duration_;
   const char* kind_;
@@ -1222,26 +1319,11 @@ class Http2Session::Http2Settings : public AsyncWrap {
   MaybeStackBuffer<nghttp2_settings_entry, IDX_SETTINGS_COUNT> entries_;
 };
 
-class ExternalHeader :
-    public String::ExternalOneByteStringResource {
+// Creates JS strings for received header names and values. Nothing keeps a
+// reference to an nghttp2_rcbuf past this point, because rcbufs are backed
+// by the session's allocator and must not outlive the session.
+class ExternalHeader {
  public:
-  explicit ExternalHeader(nghttp2_rcbuf* buf)
-     : buf_(buf), vec_(nghttp2_rcbuf_get_buf(buf)) {
-  }
-
-  ~ExternalHeader() override {
-    nghttp2_rcbuf_decref(buf_);
-    buf_ = nullptr;
-  }
-
-  const char* data() const override {
-    return const_cast<const char*>(reinterpret_cast<char*>(vec_.base));
-  }
-
-  size_t length() const override {
-    return vec_.len;
-  }
-
   static inline
   MaybeLocal<String> GetInternalizedString(Environment* env,
                                            const nghttp2_vec& vec) {
@@ -1274,21 +1356,19 @@ class ExternalHeader :
 
     if (may_internalize && vec.len < 64) {
       // This is a short header name, so there is a good chance V8 already has
-      // it internalized.
-      return GetInternalizedString(env, vec);
+      // it internalized. The string is a copy, so the buffer can go.
+      MaybeLocal<String> str = GetInternalizedString(env, vec);
+      nghttp2_rcbuf_decref(buf);
+      return str;
     }
 
-    ExternalHeader* h_str = new ExternalHeader(buf);
-    MaybeLocal<String> str = String::NewExternalOneByte(env->isolate(), h_str);
-    if (str.IsEmpty())
-      delete h_str;
-
+    MaybeLocal<String> str = String::NewFromOneByte(env->isolate(),
+                                                    vec.base,
+                                                    v8::NewStringType::kNormal,
+                                                    vec.len);
+    nghttp2_rcbuf_decref(buf);
     return str;
   }
-
- private:
-  nghttp2_rcbuf* buf_;
-  nghttp2_vec vec_;
 };
 
 class Headers {
@@ -25,10 +25,14 @@
 #include "async_wrap-inl.h"
 #include "env-inl.h"
 #include "http_parser.h"
+#include "slab_allocator.h"
 #include "stream_base-inl.h"
 #include "util-inl.h"
 #include "v8.h"
 
+#include <algorithm>
+#include <vector>
+#include <limits.h>  // ULLONG_MAX
 #include <stdlib.h>  // free()
 #include <string.h>  // strdup()
 
@@ -50,12 +54,14 @@ namespace {
 using v8::Array;
 using v8::Boolean;
 using v8::Context;
+using v8::Eternal;
 using v8::EscapableHandleScope;
 using v8::Exception;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
+using v8::Isolate;
 using v8::Integer;
 using v8::Local;
 using v8::MaybeLocal;
@@ -70,6 +76,17 @@ const uint32_t kOnHeadersComplete = 1;
 const uint32_t kOnBody = 2;
 const uint32_t kOnMessageComplete = 3;
 const uint32_t kOnExecute = 4;
+const uint32_t kOnMessages = 5;
+
+// Number of header fields that are buffered before they are flushed to JS.
+const size_t kMaxHeaderFieldsCount = 32;
+
+// Number of complete requests that are handed to kOnMessages at once.
+const size_t kMaxBatchedMessages = 16;
+
+// Values per message in the kOnMessages array: headers, url, method,
+// versionMajor, versionMinor, shouldKeepAlive.
+const size_t kBatchFieldCount = 6;
 
 
 #define HTTP_CB(name)                                                         \
@@ -88,59 +105,155 @@ const uint32_t kOnExecute = 4;
   int name##_(const char* at, size_t length)
 
 
-// helper class for the Parser
-struct StringPtr {
-  StringPtr() {
-    on_heap_ = false;
-    Reset();
+// Storage for the strings of the message that is currently being parsed
+// which have to outlive the buffer they were parsed from, i.e. strings that
+// span several packets or that are incomplete at the end of an execute()
+// call.  The memory is handed out from blocks that are kept around when the
+// parser moves on to the next message, so a parser that is fed fragmented
+// requests does not allocate at all once it has warmed up.  Blocks never
+// move, pointers into them stay valid until Reset().
+class StringArena {
+ public:
+  StringArena() = default;
+
+  ~StringArena() {
+    for (const Block& block : blocks_)
+      delete[] block.data;
+  }
+
+  // Returns storage that holds |a| followed by |b|.  If |a| is the most
+  // recent allocation and there is room behind it, |b| is appended in place.
+  // Otherwise a string that keeps growing moves to a block with twice the
+  // room it needs, and the space it leaves behind is given back, so that a
+  // string that arrives a byte at a time costs linear time and memory.
+  const char* Concat(const char* a, size_t a_len,
+                     const char* b, size_t b_len) {
+    const size_t size = a_len + b_len;
+    size_t capacity = size;
+    size_t superseded = blocks_.size();
+
+    if (a_len > 0 && current_ < blocks_.size()) {
+      Block& block = blocks_[current_];
+      if (a + a_len == block.data + block.used) {
+        if (block.size - block.used >= b_len) {
+          memcpy(block.data + block.used, b, b_len);
+          block.used += b_len;
+          return a;
+        }
+        block.used -= a_len;
+        capacity = 2 * size;
+        superseded = current_;
+      }
+    }
+
+    char* s = Allocate(size, capacity);
+    if (a_len > 0)
+      memcpy(s, a, a_len);
+    memcpy(s + a_len, b, b_len);
+
+    // A large block that held nothing but the string that just moved out
+    // would otherwise stay allocated until Reset().
+    if (superseded < blocks_.size()) {
+      Block& block = blocks_[superseded];
+      if (block.used == 0 && block.size > kBlockSize) {
+        delete[] block.data;
+        block.data = nullptr;
+        block.size = 0;
+      }
+    }
+    return s;
   }
 
+  // Invalidates all strings.  Keeps up to kMaxRetainedSize bytes of blocks
+  // for the next message.
+  void Reset() {
+    size_t retained = 0;
+    size_t kept = 0;
+    for (Block& block : blocks_) {
+      if (block.data == nullptr)
+        continue;
+      if (retained + block.size > kMaxRetainedSize) {
+        delete[] block.data;
+        continue;
+      }
+      retained += block.size;
+      block.used = 0;
+      blocks_[kept++] = block;
+    }
+    blocks_.resize(kept);
+    current_ = 0;
+  }
+
+ private:
+  static const size_t kBlockSize = 4096;
+  static const size_t kMaxRetainedSize = 16 * 1024;
+
+  struct Block {
+    char* data;
+    size_t size;
+    size_t used;
+  };
+
+  // Returns |size| bytes of storage.  If a new block is needed, it has room
+  // for at least |capacity| bytes.
+  char* Allocate(size_t size, size_t capacity) {
+    for (; current_ < blocks_.size(); current_++) {
+      Block& block = blocks_[current_];
+      if (block.data != nullptr && block.size - block.used >= size) {
+        char* s = block.data + block.used;
+        block.used += size;
+        return s;
+      }
+    }
+
+    Block block;
+    block.size = capacity > kBlockSize ? capacity : kBlockSize;
+    block.data = new char[block.size];
+    block.used = size;
+    blocks_.push_back(block);
+    current_ = blocks_.size() - 1;
+    return block.data;
+  }
+
+  std::vector<Block> blocks_;
+  size_t current_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(StringArena);
+};
+
 
-  ~StringPtr() {
+// helper class for the Parser
+struct StringPtr {
+  StringPtr() {
     Reset();
   }
 
 
-  // If str_ does not point to a heap string yet, this function makes it do
+  // If str_ does not point into the arena yet, this function makes it do
   // so. This is called at the end of each http_parser_execute() so as not
   // to leak references. See issue #2438 and test-http-parser-bad-ref.js.
-  void Save() {
-    if (!on_heap_ && size_ > 0) {
-      char* s = new char[size_];
-      memcpy(s, str_, size_);
-      str_ = s;
-      on_heap_ = true;
+  void Save(StringArena* arena) {
+    if (!on_arena_ && size_ > 0) {
+      str_ = arena->Concat(nullptr, 0, str_, size_);
+      on_arena_ = true;
     }
   }
 
 
   void Reset() {
-    if (on_heap_) {
-      delete[] str_;
-      on_heap_ = false;
-    }
-
     str_ = nullptr;
+    on_arena_ = false;
     size_ = 0;
   }
 
 
-  void Update(const char* str, size_t size) {
+  void Update(const char* str, size_t size, StringArena* arena) {
     if (str_ == nullptr) {
       str_ = str;
-    } else if (on_heap_ || str_ + size_ != str) {
-      // Non-consecutive input, make a copy on the heap.
-      // TODO(bnoordhuis) Use slab allocation, O(n) allocs is bad.
-      char* s = new char[size_ + size];
-      memcpy(s, str_, size_);
-      memcpy(s + size_, str, size);
-
-      if (on_heap_)
-        delete[] str_;
-      else
-        on_heap_ = true;
-
-      str_ = s;
+    } else if (on_arena_ || str_ + size_ != str) {
+      // Non-consecutive input, make a copy in the arena.
+      str_ = arena->Concat(str_, size_, str, size);
+      on_arena_ = true;
     }
     size_ += size;
   }
@@ -155,17 +268,176 @@ struct StringPtr {
 
 
   const char* str_;
-  bool on_heap_;
+  bool on_arena_;
   size_t size_;
 };
 
 
+// Header names that the parser hands to JS as pre-internalized strings
+// instead of creating a new string for every occurrence, as long as they are
+// spelled in one of the two common ways.  They are also reported to JS by
+// index, see _addHeaderLines() in lib/_http_incoming.js.
+#define HTTP_KNOWN_HEADERS(V)                                                 \
+  V("accept", "Accept")                                                       \
+  V("accept-charset", "Accept-Charset")                                       \
+  V("accept-encoding", "Accept-Encoding")                                     \
+  V("accept-language", "Accept-Language")                                     \
+  V("accept-ranges", "Accept-Ranges")                                         \
+  V("access-control-allow-origin", "Access-Control-Allow-Origin")             \
+  V("age", "Age")                                                             \
+  V("authorization", "Authorization")                                         \
+  V("cache-control", "Cache-Control")                                         \
+  V("connection", "Connection")                                               \
+  V("content-disposition", "Content-Disposition")                             \
+  V("content-encoding", "Content-Encoding")                                   \
+  V("content-language", "Content-Language")                                   \
+  V("content-length", "Content-Length")                                       \
+  V("content-range", "Content-Range")                                         \
+  V("content-type", "Content-Type")                                           \
+  V("cookie", "Cookie")                                                       \
+  V("date", "Date")                                                           \
+  V("dnt", "DNT")                                                             \
+  V("etag", "ETag")                                                           \
+  V("expect", "Expect")                                                       \
+  V("expires", "Expires")                                                     \
+  V("from", "From")                                                           \
+  V("host", "Host")                                                           \
+  V("if-match", "If-Match")                                                   \
+  V("if-modified-since", "If-Modified-Since")                                 \
+  V("if-none-match", "If-None-Match")                                         \
+  V("if-unmodified-since", "If-Unmodified-Since")                             \
+  V("keep-alive", "Keep-Alive")                                               \
+  V("last-modified", "Last-Modified")                                         \
+  V("link", "Link")                                                           \
+  V("location", "Location")                                                   \
+  V("max-forwards", "Max-Forwards")                                           \
+  V("origin", "Origin")                                                       \
+  V("pragma", "Pragma")                                                       \
+  V("proxy-authorization", "Proxy-Authorization")                             \
+  V("range", "Range")                                                         \
+  V("referer", "Referer")                                                     \
+  V("retry-after", "Retry-After")                                             \
+  V("sec-websocket-accept", "Sec-WebSocket-Accept")                           \
+  V("sec-websocket-extensions", "Sec-WebSocket-Extensions")                   \
+  V("sec-websocket-key", "Sec-WebSocket-Key")                                 \
+  V("sec-websocket-protocol", "Sec-WebSocket-Protocol")                       \
+  V("sec-websocket-version", "Sec-WebSocket-Version")                         \
+  V("server", "Server")                                                       \
+  V("set-cookie", "Set-Cookie")                                               \
+  V("strict-transport-security", "Strict-Transport-Security")                 \
+  V("te", "TE")                                                               \
+  V("trailer", "Trailer")                                                     \
+  V("transfer-encoding", "Transfer-Encoding")                                 \
+  V("upgrade", "Upgrade")                                                     \
+  V("upgrade-insecure-requests", "Upgrade-Insecure-Requests")                 \
+  V("user-agent", "User-Agent")                                               \
+  V("vary", "Vary")                                                           \
+  V("via", "Via")                                                             \
+  V("www-authenticate", "WWW-Authenticate")                                   \
+  V("x-forwarded-for", "X-Forwarded-For")                                     \
+  V("x-forwarded-host", "X-Forwarded-Host")                                   \
+  V("x-forwarded-proto", "X-Forwarded-Proto")                                 \
+  V("x-powered-by", "X-Powered-By")                                           \
+  V("x-real-ip", "X-Real-IP")                                                 \
+  V("x-request-id", "X-Request-ID")                                           \
+  V("x-requested-with", "X-Requested-With")
+
+struct KnownHeader {
+  const char* lower;
+  const char* canonical;
+  size_t length;
+};
+
+const KnownHeader kKnownHeaders[] = {
+#define V(lower, canonical) { lower, canonical, sizeof(lower) - 1 },
+  HTTP_KNOWN_HEADERS(V)
+#undef V
+};
+
+// Index 0 means "not a known header", known headers are numbered from 1.
+const size_t kKnownHeaderCount = arraysize(kKnownHeaders);
+static_assert(kKnownHeaderCount < 256, "known header index must fit a byte");
+
+
+inline char ToLowerAscii(char c) {
+  return c >= 'A' && c <= 'Z' ? c | 0x20 : c;
+}
+
+
+// Perfect hash over the known header names, case-insensitively.  The seed
+// is picked on first use so that every name gets a slot of its own, which
+// means a lookup never has to compare against more than one candidate.
+class KnownHeaderTable {
+ public:
+  static const KnownHeaderTable& Get() {
+    static const KnownHeaderTable table;
+    return table;
+  }
+
+  // Returns the index of the known header |name| is a spelling of, or 0.
+  size_t Lookup(const char* name, size_t length) const {
+    if (length == 0 || length > max_length_)
+      return 0;
+    const size_t index = slots_[Slot(seed_, name, length)];
+    if (index == 0)
+      return 0;
+    const KnownHeader& header = kKnownHeaders[index - 1];
+    if (header.length != length)
+      return 0;
+    for (size_t i = 0; i < length; i++) {
+      if (ToLowerAscii(name[i]) != header.lower[i])
+        return 0;
+    }
+    return index;
+  }
+
+ private:
+  static const size_t kSlots = 1024;
+
+  KnownHeaderTable() {
+    for (size_t i = 0; i < kKnownHeaderCount; i++)
+      max_length_ = std::max(max_length_, kKnownHeaders[i].length);
+    for (seed_ = 0;; seed_++) {
+      if (TryFill())
+        return;
+    }
+  }
+
+  bool TryFill() {
+    memset(slots_, 0, sizeof(slots_));
+    for (size_t i = 0; i < kKnownHeaderCount; i++) {
+      const KnownHeader& header = kKnownHeaders[i];
+      const size_t slot = Slot(seed_, header.lower, header.length);
+      if (slots_[slot] != 0)
+        return false;
+      slots_[slot] = i + 1;
+    }
+    return true;
+  }
+
+  // FNV-1a.
+  static size_t Slot(uint32_t seed, const char* name, size_t length) {
+    uint32_t hash = 2166136261u ^ seed;
+    for (size_t i = 0; i < length; i++) {
+      hash ^= static_cast<uint8_t>(ToLowerAscii(name[i]));
+      hash *= 16777619u;
+    }
+    return hash % kSlots;
+  }
+
+  uint32_t seed_ = 0;
+  size_t max_length_ = 0;
+  uint8_t slots_[kSlots];
+};
+
+
 class Parser : public AsyncWrap {
  public:
   Parser(Environment* env, Local<Object> wrap, enum http_parser_type type)
       : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_HTTPPARSER),
         current_buffer_len_(0),
-        current_buffer_data_(nullptr) {
+        current_buffer_data_(nullptr),
+        read_allocator_(env) {
     Wrap(object(), this);
     Init(type);
   }
@@ -186,18 +458,19 @@ class Parser : public AsyncWrap {
     num_fields_ = num_values_ = 0;
     url_.Reset();
     status_message_.Reset();
+    arena_.Reset();
     return 0;
   }
 
 
   HTTP_DATA_CB(on_url) {
-    url_.Update(at, length);
+    url_.Update(at, length, &arena_);
     return 0;
   }
 
 
   HTTP_DATA_CB(on_status) {
-    status_message_.Update(at, length);
+    status_message_.Update(at, length, &arena_);
     return 0;
   }
 
@@ -218,7 +491,7 @@ class Parser : public AsyncWrap {
     CHECK_LT(num_fields_, arraysize(fields_));
     CHECK_EQ(num_fields_, num_values_ + 1);
 
-    fields_[num_fields_ - 1].Update(at, length);
+    fields_[num_fields_ - 1].Update(at, length, &arena_);
 
     return 0;
   }
@@ -234,7 +507,7 @@ class Parser : public AsyncWrap {
     CHECK_LT(num_values_, arraysize(values_));
     CHECK_EQ(num_values_, num_fields_);
 
-    values_[num_values_ - 1].Update(at, length);
+    values_[num_values_ - 1].Update(at, length, &arena_);
 
     return 0;
   }
@@ -264,6 +537,15 @@ class Parser : public AsyncWrap {
     if (!cb->IsFunction())
       return 0;
 
+    if (CanBatch()) {
+      AddToBatch();
+      return 0;
+    }
+
+    // Messages have to reach JS in order.
+    if (!DeliverBatch())
+      return -1;
+
     Local<Value> undefined = Undefined(env()->isolate());
     for (size_t i = 0; i < arraysize(argv); i++)
       argv[i] = undefined;
@@ -273,7 +555,7 @@ class Parser : public AsyncWrap {
       Flush();
     } else {
       // Fast case, pass headers and URL to JS land.
-      argv[A_HEADERS] = CreateHeaders();
+      argv[A_HEADERS] = CreateHeaders(0);
       if (parser_.type == HTTP_REQUEST)
         argv[A_URL] = url_.ToString(env());
     }
@@ -328,11 +610,16 @@ class Parser : public AsyncWrap {
 
     // We came from consumed stream
     if (current_buffer_.IsEmpty()) {
+      // Hand the read buffer itself to JS instead of a copy of it.  It comes
+      // from this parser's own slab, which keeps the bytes alive and intact
+      // for as long as the body chunks that point into them are.
+      CHECK_EQ(read_buf_.base, current_buffer_data_);
+      Local<Object> buffer =
+          read_allocator_.Shrink(read_buf_, current_buffer_len_)
+              .ToLocalChecked();
+      read_buf_ = uv_buf_init(nullptr, 0);
       // Make sure Buffer will be in parent HandleScope
-      current_buffer_ = scope.Escape(Buffer::Copy(
-          env()->isolate(),
-          current_buffer_data_,
-          current_buffer_len_).ToLocalChecked());
+      current_buffer_ = scope.Escape(buffer);
     }
 
     Local<Value> argv[3] = {
@@ -357,6 +644,14 @@ class Parser : public AsyncWrap {
   HTTP_CB(on_message_complete) {
     HandleScope scope(env()->isolate());
 
+    if (batched_message_) {
+      // Already complete as far as JS is concerned.
+      batched_message_ = false;
+      if (batch_count_ == kMaxBatchedMessages && !DeliverBatch())
+        return -1;
+      return 0;
+    }
+
     if (num_fields_)
       Flush();  // Flush trailing HTTP headers.
 
@@ -410,15 +705,15 @@ class Parser : public AsyncWrap {
 
 
   void Save() {
-    url_.Save();
-    status_message_.Save();
+    url_.Save(&arena_);
+    status_message_.Save(&arena_);
 
     for (size_t i = 0; i < num_fields_; i++) {
-      fields_[i].Save();
+      fields_[i].Save(&arena_);
     }
 
     for (size_t i = 0; i < num_values_; i++) {
-      values_[i].Save();
+      values_[i].Save(&arena_);
     }
   }
 
@@ -579,13 +874,7 @@ class Parser : public AsyncWrap {
 
   static void OnAllocImpl(size_t suggested_size, uv_buf_t* buf, void* ctx) {
     Parser* parser = static_cast<Parser*>(ctx);
-    Environment* env = parser->env();
-
-    if (env->http_parser_buffer() == nullptr)
-      env->set_http_parser_buffer(new char[kAllocBufferSize]);
-
-    buf->base = env->http_parser_buffer();
-    buf->len = kAllocBufferSize;
+    *buf = parser->read_allocator_.Allocate(kAllocBufferSize);
   }
 
 
@@ -595,6 +884,10 @@ class Parser : public AsyncWrap {
                          void* ctx) {
     Parser* parser = static_cast<Parser*>(ctx);
     HandleScope scope(parser->env()->isolate());
+    SlabAllocator* allocator = &parser->read_allocator_;
+
+    if (nread <= 0)
+      allocator->Release(*buf);
 
     if (nread < 0) {
       uv_buf_t tmp_buf;
@@ -613,27 +906,34 @@ class Parser : public AsyncWrap {
 
     ScopedRetainParser retain(parser);
 
+    // on_body() takes ownership of the read buffer if there is a body in
+    // it, otherwise it is released once the parser is done with it.
+    parser->read_buf_ = *buf;
+
     parser->current_buffer_.Clear();
     Local<Value> ret = parser->Execute(buf->base, nread);
 
     // Exception
-    if (ret.IsEmpty())
-      return;
-
-    Local<Object> obj = parser->object();
-    Local<Value> cb = obj->Get(kOnExecute);
+    if (!ret.IsEmpty()) {
+      Local<Object> obj = parser->object();
+      Local<Value> cb = obj->Get(kOnExecute);
 
-    if (!cb->IsFunction())
-      return;
+      if (cb->IsFunction()) {
+        // Hooks for GetCurrentBuffer
+        parser->current_buffer_len_ = nread;
+        parser->current_buffer_data_ = buf->base;
 
-    // Hooks for GetCurrentBuffer
-    parser->current_buffer_len_ = nread;
-    parser->current_buffer_data_ = buf->base;
+        parser->MakeCallback(cb.As<Function>(), 1, &ret);
 
-    parser->MakeCallback(cb.As<Function>(), 1, &ret);
+        parser->current_buffer_len_ = 0;
+        parser->current_buffer_data_ = nullptr;
+      }
+    }
 
-    parser->current_buffer_len_ = 0;
-    parser->current_buffer_data_ = nullptr;
+    if (parser->read_buf_.base != nullptr) {
+      allocator->Release(parser->read_buf_);
+      parser->read_buf_ = uv_buf_init(nullptr, 0);
+    }
   }
 
 
@@ -647,6 +947,12 @@ class Parser : public AsyncWrap {
     size_t nparsed =
       http_parser_execute(&parser_, &settings, data, len);
 
+    // Hand over the requests that were completed by this chunk.
+    if (!got_exception_)
+      DeliverBatch();
+    batch_.Clear();
+    batch_count_ = 0;
+
     Save();
 
     // Unassign the 'buffer_' variable
@@ -675,16 +981,60 @@ class Parser : public AsyncWrap {
     return scope.Escape(nparsed_obj);
   }
 
-  Local<Array> CreateHeaders() {
+  // Returns the header name |field| as a string, which is an internalized
+  // one if it is a known header in one of its common spellings.  Sets
+  // |*index| to the known header's index, or to 0.
+  Local<String> HeaderName(const StringPtr& field, uint8_t* index) {
+    const size_t known =
+        KnownHeaderTable::Get().Lookup(field.str_, field.size_);
+    *index = known;
+    if (known == 0)
+      return field.ToString(env());
+
+    const KnownHeader& header = kKnownHeaders[known - 1];
+    size_t slot = (known - 1) * 2;
+    if (memcmp(field.str_, header.canonical, header.length) == 0)
+      slot++;
+    else if (memcmp(field.str_, header.lower, header.length) != 0)
+      return field.ToString(env());
+
+    Isolate* isolate = env()->isolate();
+    std::vector<Eternal<String>>& strs =
+        env()->isolate_data()->http_known_header_strs;
+    if (strs.empty())
+      strs.resize(kKnownHeaderCount * 2);
+    Eternal<String>& eternal = strs[slot];
+    if (eternal.IsEmpty()) {
+      const char* name = (slot & 1) ? header.canonical : header.lower;
+      Local<String> str =
+          String::NewFromOneByte(isolate,
+                                 reinterpret_cast<const uint8_t*>(name),
+                                 v8::NewStringType::kInternalized,
+                                 header.length).ToLocalChecked();
+      eternal.Set(isolate, str);
+      return str;
+    }
+    return eternal.Get(isolate);
+  }
+
+
+  // The index of each header's name, see HeaderName(), is written to the
+  // Environment's http_parser_header_indices() buffer for JS to pick up,
+  // starting at |index_offset|.
+  Local<Array> CreateHeaders(size_t index_offset) {
     Local<Array> headers = Array::New(env()->isolate());
     Local<Function> fn = env()->push_values_to_array_function();
     Local<Value> argv[NODE_PUSH_VAL_TO_ARRAY_MAX * 2];
+    Environment::HttpHeaderIndexBuffer* indices =
+        env()->http_parser_header_indices();
     size_t i = 0;
 
     do {
       size_t j = 0;
       while (i < num_values_ && j < arraysize(argv) / 2) {
-        argv[j * 2] = fields_[i].ToString(env());
+        uint8_t index;
+        argv[j * 2] = HeaderName(fields_[i], &index);
+        indices->SetValue(index_offset + i, index);
         argv[j * 2 + 1] = values_[i].ToString(env());
         i++;
         j++;
@@ -698,10 +1048,80 @@ class Parser : public AsyncWrap {
   }
 
 
+  // Requests without a body that are not upgrades and whose headers fit into
+  // fields_ can be handed to JS in batches, through a single kOnMessages
+  // callback instead of kOnHeadersComplete and kOnMessageComplete for each
+  // of them, if JS provides that callback.  This mostly helps with clients
+  // that pipeline many small requests.
+  bool CanBatch() {
+    if (parser_.type != HTTP_REQUEST || parser_.upgrade || have_flushed_)
+      return false;
+    if ((parser_.flags & F_CHUNKED) ||
+        (parser_.content_length != 0 && parser_.content_length != ULLONG_MAX))
+      return false;
+    return object()->Get(kOnMessages)->IsFunction();
+  }
+
+
+  void AddToBatch() {
+    Isolate* isolate = env()->isolate();
+    Local<Value> argv[kBatchFieldCount] = {
+      CreateHeaders(batch_count_ * kMaxHeaderFieldsCount),
+      url_.ToString(env()),
+      Uint32::NewFromUnsigned(isolate, parser_.method),
+      Integer::New(isolate, parser_.http_major),
+      Integer::New(isolate, parser_.http_minor),
+      Boolean::New(isolate, http_should_keep_alive(&parser_))
+    };
+
+    if (batch_.IsEmpty())
+      batch_ = Array::New(isolate);
+    env()->push_values_to_array_function()->Call(
+        env()->context(), batch_, arraysize(argv), argv).ToLocalChecked();
+
+    batch_count_++;
+    batched_message_ = true;
+    num_fields_ = 0;
+    num_values_ = 0;
+  }
+
+
+  // Returns false if JS threw an exception.
+  bool DeliverBatch() {
+    if (batch_count_ == 0)
+      return true;
+
+    Local<Value> argv[1] = { batch_ };
+    batch_.Clear();
+    batch_count_ = 0;
+
+    Local<Value> cb = object()->Get(kOnMessages);
+    if (!cb->IsFunction())
+      return true;
+
+    Environment::AsyncCallbackScope callback_scope(env());
+
+    MaybeLocal<Value> r = MakeCallback(cb.As<Function>(),
+                                       arraysize(argv),
+                                       argv);
+
+    if (r.IsEmpty()) {
+      got_exception_ = true;
+      return false;
+    }
+
+    return true;
+  }
+
+
   // spill headers and request path to JS land
   void Flush() {
     HandleScope scope(env()->isolate());
 
+    // Messages have to reach JS in order.
+    if (!DeliverBatch())
+      return;
+
     Local<Object> obj = object();
     Local<Value> cb = obj->Get(kOnHeaders);
 
@@ -709,7 +1129,7 @@ class Parser : public AsyncWrap {
       return;
 
     Local<Value> argv[2] = {
-      CreateHeaders(),
+      CreateHeaders(0),
       url_.ToString(env())
     };
 
@@ -729,25 +1149,35 @@ class Parser : public AsyncWrap {
     http_parser_init(&parser_, type);
     url_.Reset();
     status_message_.Reset();
+    arena_.Reset();
     num_fields_ = 0;
     num_values_ = 0;
     have_flushed_ = false;
     got_exception_ = false;
+    batch_.Clear();
+    batch_count_ = 0;
+    batched_message_ = false;
   }
 
 
   http_parser parser_;
-  StringPtr fields_[32];  // header fields
-  StringPtr values_[32];  // header values
+  StringPtr fields_[kMaxHeaderFieldsCount];  // header fields
+  StringPtr values_[kMaxHeaderFieldsCount];  // header values
   StringPtr url_;
   StringPtr status_message_;
+  StringArena arena_;
   size_t num_fields_;
   size_t num_values_;
   bool have_flushed_;
   bool got_exception_;
+  Local<Array> batch_;
+  size_t batch_count_;
+  bool batched_message_;
   Local<Object> current_buffer_;
   size_t current_buffer_len_;
   char* current_buffer_data_;
+  uv_buf_t read_buf_ = uv_buf_init(nullptr, 0);
+  SlabAllocator read_allocator_;
   StreamResource::Callback<StreamResource::AllocCb> prev_alloc_cb_;
   StreamResource::Callback<StreamResource::ReadCb> prev_read_cb_;
   int refcount_ = 1;
@@ -794,6 +1224,10 @@ void InitHttpParser(Local<Object> target,
          Integer::NewFromUnsigned(env->isolate(), kOnMessageComplete));
   t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kOnExecute"),
          Integer::NewFromUnsigned(env->isolate(), kOnExecute));
+  t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kOnMessages"),
+         Integer::NewFromUnsigned(env->isolate(), kOnMessages));
+  t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kMaxBatchedMessages"),
+         Integer::NewFromUnsigned(env->isolate(), kMaxBatchedMessages));
 
   Local<Array> methods = Array::New(env->isolate());
 #define V(num, name, string)                                                  \
@@ -802,6 +1236,25 @@ void InitHttpParser(Local<Object> target,
 #undef V
   target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "methods"), methods);
 
+  Local<Array> known_headers = Array::New(env->isolate(), kKnownHeaderCount);
+  for (size_t i = 0; i < kKnownHeaderCount; i++) {
+    known_headers->Set(env->context(),
+                       i,
+                       OneByteString(env->isolate(),
+                                     kKnownHeaders[i].lower)).FromJust();
+  }
+  target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "knownHeaders"),
+              known_headers);
+
+  // Sized for the largest batch of headers that CreateHeaders() can deliver.
+  env->set_http_parser_header_indices(
+      std::unique_ptr<Environment::HttpHeaderIndexBuffer>(
+          new Environment::HttpHeaderIndexBuffer(
+              env->isolate(),
+              kMaxHeaderFieldsCount * kMaxBatchedMessages)));
+  target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "knownHeaderIndices"),
+              env->http_parser_header_indices()->GetJSArray());
+
   AsyncWrap::AddWrapMethods(env, t);
   env->SetProtoMethod(t, "close", Parser::Close);
   env->SetProtoMethod(t, "free", Parser::Free);
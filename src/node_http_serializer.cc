@@ -0,0 +1,113 @@
+#include "node.h"
+#include "node_buffer.h"
+#include "node_internals.h"
+#include "env-inl.h"
+#include "util-inl.h"
+#include "v8.h"
+
+#include <string.h>
+
+namespace node {
+namespace {
+
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::Local;
+using v8::Object;
+using v8::String;
+using v8::Value;
+
+const char kCRLF[] = "\r\n";
+const char kDatePrefix[] = "Date: ";
+
+
+// Writes |str| the way the 'latin1' encoding does, which is what header
+// strings are written as.
+inline size_t WriteLatin1(char* dst, Local<String> str) {
+  return str->WriteOneByte(reinterpret_cast<uint8_t*>(dst),
+                           0,
+                           str->Length(),
+                           String::NO_NULL_TERMINATION);
+}
+
+
+// serializeHead(head, template, tail, addDate) returns a Buffer that holds
+// |head|, the pre-serialized header lines |template| (a Buffer, or
+// undefined), |tail|, a Date header if |addDate| is true and the empty line
+// that terminates the header section.  The Buffer is allocated at its final
+// size and written in place, so serializing the head of a message costs one
+// malloc() and no intermediate string.
+void SerializeHead(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  CHECK(args[0]->IsString());
+  CHECK(args[2]->IsString());
+  Local<String> head = args[0].As<String>();
+  Local<String> tail = args[2].As<String>();
+
+  const char* block = nullptr;
+  size_t block_len = 0;
+  if (!args[1]->IsUndefined()) {
+    CHECK(Buffer::HasInstance(args[1]));
+    block = Buffer::Data(args[1]);
+    block_len = Buffer::Length(args[1]);
+  }
+
+  const char* date = nullptr;
+  size_t date_len = 0;
+  if (args[3]->IsTrue()) {
+    date = env->http_date_cache()->data();
+    date_len = sizeof(kDatePrefix) - 1 + HttpDateCache::kLength +
+               sizeof(kCRLF) - 1;
+  }
+
+  const size_t size = head->Length() + block_len + tail->Length() +
+                      date_len + sizeof(kCRLF) - 1;
+
+  Local<Object> obj;
+  if (!Buffer::New(env, size).ToLocal(&obj))
+    return;
+  char* const data = Buffer::Data(obj);
+  char* p = data;
+  p += WriteLatin1(p, head);
+  if (block_len > 0) {
+    memcpy(p, block, block_len);
+    p += block_len;
+  }
+  p += WriteLatin1(p, tail);
+  if (date != nullptr) {
+    memcpy(p, kDatePrefix, sizeof(kDatePrefix) - 1);
+    p += sizeof(kDatePrefix) - 1;
+    memcpy(p, date, HttpDateCache::kLength);
+    p += HttpDateCache::kLength;
+    memcpy(p, kCRLF, sizeof(kCRLF) - 1);
+    p += sizeof(kCRLF) - 1;
+  }
+  memcpy(p, kCRLF, sizeof(kCRLF) - 1);
+  p += sizeof(kCRLF) - 1;
+  CHECK_EQ(static_cast<size_t>(p - data), size);
+
+  args.GetReturnValue().Set(obj);
+}
+
+
+// Returns the cached value for the Date header, see HttpDateCache.
+void UTCDate(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  args.GetReturnValue().Set(env->http_date_cache()->GetString());
+}
+
+
+void InitHttpSerializer(Local<Object> target,
+                        Local<Value> unused,
+                        Local<Context> context,
+                        void* priv) {
+  Environment* env = Environment::GetCurrent(context);
+  env->SetMethod(target, "serializeHead", SerializeHead);
+  env->SetMethod(target, "utcDate", UTCDate);
+}
+
+}  // anonymous namespace
+}  // namespace node
+
+NODE_BUILTIN_MODULE_CONTEXT_AWARE(http_serializer, node::InitHttpSerializer)
@@ -108,6 +108,7 @@ struct sockaddr;
     V(fs_event_wrap)                                                          \
     V(http2)                                                                  \
     V(http_parser)                                                            \
+    V(http_serializer)                                                        \
     V(inspector)                                                              \
     V(js_stream)                                                              \
     V(module_wrap)                                                            \
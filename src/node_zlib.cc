@@ -24,12 +24,15 @@
 
 #include "async_wrap-inl.h"
 #include "env-inl.h"
+#include "req_wrap-inl.h"
 #include "util-inl.h"
 
 #include "v8.h"
 #include "zlib.h"
 
+#include <algorithm>
 #include <errno.h>
+#include <memory>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
@@ -43,12 +46,18 @@ using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
+using v8::Int32;
+using v8::Integer;
+using v8::Isolate;
 using v8::Local;
+using v8::Null;
 using v8::Number;
 using v8::Object;
 using v8::Persistent;
 using v8::String;
+using v8::Uint32;
 using v8::Uint32Array;
+using v8::Undefined;
 using v8::Value;
 
 namespace {
@@ -67,6 +76,82 @@ enum node_zlib_mode {
 #define GZIP_HEADER_ID1 0x1f
 #define GZIP_HEADER_ID2 0x8b
 
+inline bool IsDeflateMode(node_zlib_mode mode) {
+  return mode == DEFLATE || mode == GZIP || mode == DEFLATERAW;
+}
+
+// Returns the windowBits to pass to deflateInit2()/inflateInit2() for |mode|,
+// which also selects the zlib, gzip or raw format.
+inline int WindowBitsForMode(node_zlib_mode mode, int window_bits) {
+  switch (mode) {
+    case GZIP:
+    case GUNZIP:
+      return window_bits + 16;
+    case UNZIP:
+      return window_bits + 32;
+    case DEFLATERAW:
+    case INFLATERAW:
+      return -window_bits;
+    default:
+      return window_bits;
+  }
+}
+
+const int kDeflateContextSize = 16384;  // approximate
+const int kInflateContextSize = 10240;  // approximate
+const size_t kMinInflateOutput = 1024;
+const size_t kMaxInitialInflateOutput = 1024 * 1024;
+
+// Returns a context for |key|, preferably an idle one from the Environment's
+// pool.  Returns nullptr and sets |*err| if a new one cannot be initialized.
+z_stream* AcquireContext(Environment* env,
+                         const ZlibContextPool::Key& key,
+                         int* err) {
+  *err = Z_OK;
+  z_stream* strm = env->zlib_context_pool()->Acquire(key);
+  if (strm != nullptr)
+    return strm;
+
+  strm = new z_stream();
+  strm->zalloc = Z_NULL;
+  strm->zfree = Z_NULL;
+  strm->opaque = Z_NULL;
+  if (key.deflate) {
+    *err = deflateInit2(strm,
+                        key.level,
+                        Z_DEFLATED,
+                        key.window_bits,
+                        key.mem_level,
+                        key.strategy);
+  } else {
+    *err = inflateInit2(strm, key.window_bits);
+  }
+  if (*err != Z_OK) {
+    delete strm;
+    return nullptr;
+  }
+  env->isolate()->AdjustAmountOfExternalAllocatedMemory(
+      key.deflate ? kDeflateContextSize : kInflateContextSize);
+  return strm;
+}
+
+// Hands a context back to the pool instead of tearing it down where
+// possible, it stays accounted for as external memory while it is idle.
+void ReleaseContext(Environment* env,
+                    const ZlibContextPool::Key& key,
+                    z_stream* strm,
+                    bool reusable) {
+  const int64_t context_size =
+      key.deflate ? kDeflateContextSize : kInflateContextSize;
+  if (reusable && env->zlib_context_pool()->Release(key, strm, context_size))
+    return;
+
+  const int status = key.deflate ? deflateEnd(strm) : inflateEnd(strm);
+  CHECK(status == Z_OK || status == Z_DATA_ERROR);
+  delete strm;
+  env->isolate()->AdjustAmountOfExternalAllocatedMemory(-context_size);
+}
+
 /**
  * Deflate/Inflate
  */
@@ -83,11 +168,13 @@ class ZCtx : public AsyncWrap {
         memLevel_(0),
         mode_(mode),
         strategy_(0),
+        strm_(nullptr),
         windowBits_(0),
         write_in_progress_(false),
         pending_close_(false),
         refs_(0),
         gzip_id_bytes_read_(0),
+        reusable_(true),
         write_result_(nullptr) {
     MakeWeak<ZCtx>(this);
     Wrap(wrap, this);
@@ -109,18 +196,10 @@ class ZCtx : public AsyncWrap {
     CHECK(init_done_ && "close before init");
     CHECK_LE(mode_, UNZIP);
 
-    int status = Z_OK;
-    if (mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW) {
-      status = deflateEnd(&strm_);
-      int64_t change_in_bytes = -static_cast<int64_t>(kDeflateContextSize);
-      env()->isolate()->AdjustAmountOfExternalAllocatedMemory(change_in_bytes);
-    } else if (mode_ == INFLATE || mode_ == GUNZIP || mode_ == INFLATERAW ||
-               mode_ == UNZIP) {
-      status = inflateEnd(&strm_);
-      int64_t change_in_bytes = -static_cast<int64_t>(kInflateContextSize);
-      env()->isolate()->AdjustAmountOfExternalAllocatedMemory(change_in_bytes);
-    }
-    CHECK(status == Z_OK || status == Z_DATA_ERROR);
+    if (mode_ != NONE) {
+      ReleaseContext(env(), PoolKey(), strm_, reusable_);
+      strm_ = nullptr;
+    }
     mode_ = NONE;
 
     if (dictionary_ != nullptr) {
@@ -196,10 +275,10 @@ class ZCtx : public AsyncWrap {
     // build up the work request
     uv_work_t* work_req = &(ctx->work_req_);
 
-    ctx->strm_.avail_in = in_len;
-    ctx->strm_.next_in = in;
-    ctx->strm_.avail_out = out_len;
-    ctx->strm_.next_out = out;
+    ctx->strm_->avail_in = in_len;
+    ctx->strm_->next_in = in;
+    ctx->strm_->avail_out = out_len;
+    ctx->strm_->next_out = out;
     ctx->flush_ = flush;
 
     if (!async) {
@@ -207,8 +286,8 @@ class ZCtx : public AsyncWrap {
       env->PrintSyncTrace();
       Process(work_req);
       if (CheckError(ctx)) {
-        ctx->write_result_[0] = ctx->strm_.avail_out;
-        ctx->write_result_[1] = ctx->strm_.avail_in;
+        ctx->write_result_[0] = ctx->strm_->avail_out;
+        ctx->write_result_[1] = ctx->strm_->avail_in;
         ctx->write_in_progress_ = false;
         ctx->Unref();
       }
@@ -236,11 +315,11 @@ class ZCtx : public AsyncWrap {
       case DEFLATE:
       case GZIP:
       case DEFLATERAW:
-        ctx->err_ = deflate(&ctx->strm_, ctx->flush_);
+        ctx->err_ = deflate(ctx->strm_, ctx->flush_);
         break;
       case UNZIP:
-        if (ctx->strm_.avail_in > 0) {
-          next_expected_header_byte = ctx->strm_.next_in;
+        if (ctx->strm_->avail_in > 0) {
+          next_expected_header_byte = ctx->strm_->next_in;
         }
 
         switch (ctx->gzip_id_bytes_read_) {
@@ -253,7 +332,7 @@ class ZCtx : public AsyncWrap {
               ctx->gzip_id_bytes_read_ = 1;
               next_expected_header_byte++;
 
-              if (ctx->strm_.avail_in == 1) {
+              if (ctx->strm_->avail_in == 1) {
                 // The only available byte was already read.
                 break;
               }
@@ -286,7 +365,7 @@ class ZCtx : public AsyncWrap {
       case INFLATE:
       case GUNZIP:
       case INFLATERAW:
-        ctx->err_ = inflate(&ctx->strm_, ctx->flush_);
+        ctx->err_ = inflate(ctx->strm_, ctx->flush_);
 
         // If data was encoded with dictionary (INFLATERAW will have it set in
         // SetDictionary, don't repeat that here)
@@ -294,12 +373,12 @@ class ZCtx : public AsyncWrap {
             ctx->err_ == Z_NEED_DICT &&
             ctx->dictionary_ != nullptr) {
           // Load it
-          ctx->err_ = inflateSetDictionary(&ctx->strm_,
+          ctx->err_ = inflateSetDictionary(ctx->strm_,
                                            ctx->dictionary_,
                                            ctx->dictionary_len_);
           if (ctx->err_ == Z_OK) {
             // And try to decode again
-            ctx->err_ = inflate(&ctx->strm_, ctx->flush_);
+            ctx->err_ = inflate(ctx->strm_, ctx->flush_);
           } else if (ctx->err_ == Z_DATA_ERROR) {
             // Both inflateSetDictionary() and inflate() return Z_DATA_ERROR.
             // Make it possible for After() to tell a bad dictionary from bad
@@ -308,17 +387,17 @@ class ZCtx : public AsyncWrap {
           }
         }
 
-        while (ctx->strm_.avail_in > 0 &&
+        while (ctx->strm_->avail_in > 0 &&
                ctx->mode_ == GUNZIP &&
                ctx->err_ == Z_STREAM_END &&
-               ctx->strm_.next_in[0] != 0x00) {
+               ctx->strm_->next_in[0] != 0x00) {
           // Bytes remain in input buffer. Perhaps this is another compressed
           // member in the same archive, or just trailing garbage.
           // Trailing zero bytes are okay, though, since they are frequently
           // used for padding.
 
           Reset(ctx);
-          ctx->err_ = inflate(&ctx->strm_, ctx->flush_);
+          ctx->err_ = inflate(ctx->strm_, ctx->flush_);
         }
         break;
       default:
@@ -338,7 +417,7 @@ class ZCtx : public AsyncWrap {
     switch (ctx->err_) {
     case Z_OK:
     case Z_BUF_ERROR:
-      if (ctx->strm_.avail_out != 0 && ctx->flush_ == Z_FINISH) {
+      if (ctx->strm_->avail_out != 0 && ctx->flush_ == Z_FINISH) {
         ZCtx::Error(ctx, "unexpected end of file");
         return false;
       }
@@ -374,8 +453,8 @@ class ZCtx : public AsyncWrap {
     if (!CheckError(ctx))
       return;
 
-    ctx->write_result_[0] = ctx->strm_.avail_out;
-    ctx->write_result_[1] = ctx->strm_.avail_in;
+    ctx->write_result_[0] = ctx->strm_->avail_out;
+    ctx->write_result_[1] = ctx->strm_->avail_in;
     ctx->write_in_progress_ = false;
 
     // call the write() cb
@@ -394,8 +473,8 @@ class ZCtx : public AsyncWrap {
     // If you hit this assertion, you forgot to enter the v8::Context first.
     CHECK_EQ(env->context(), env->isolate()->GetCurrentContext());
 
-    if (ctx->strm_.msg != nullptr) {
-      message = ctx->strm_.msg;
+    if (ctx->strm_->msg != nullptr) {
+      message = ctx->strm_->msg;
     }
 
     HandleScope scope(env->isolate());
@@ -504,54 +583,16 @@ class ZCtx : public AsyncWrap {
                    Local<Function> write_js_callback, char* dictionary,
                    size_t dictionary_len) {
     ctx->level_ = level;
-    ctx->windowBits_ = windowBits;
+    ctx->windowBits_ = WindowBitsForMode(ctx->mode_, windowBits);
     ctx->memLevel_ = memLevel;
     ctx->strategy_ = strategy;
 
-    ctx->strm_.zalloc = Z_NULL;
-    ctx->strm_.zfree = Z_NULL;
-    ctx->strm_.opaque = Z_NULL;
-
     ctx->flush_ = Z_NO_FLUSH;
 
     ctx->err_ = Z_OK;
 
-    if (ctx->mode_ == GZIP || ctx->mode_ == GUNZIP) {
-      ctx->windowBits_ += 16;
-    }
-
-    if (ctx->mode_ == UNZIP) {
-      ctx->windowBits_ += 32;
-    }
-
-    if (ctx->mode_ == DEFLATERAW || ctx->mode_ == INFLATERAW) {
-      ctx->windowBits_ *= -1;
-    }
-
-    switch (ctx->mode_) {
-      case DEFLATE:
-      case GZIP:
-      case DEFLATERAW:
-        ctx->err_ = deflateInit2(&ctx->strm_,
-                                 ctx->level_,
-                                 Z_DEFLATED,
-                                 ctx->windowBits_,
-                                 ctx->memLevel_,
-                                 ctx->strategy_);
-        ctx->env()->isolate()
-            ->AdjustAmountOfExternalAllocatedMemory(kDeflateContextSize);
-        break;
-      case INFLATE:
-      case GUNZIP:
-      case INFLATERAW:
-      case UNZIP:
-        ctx->err_ = inflateInit2(&ctx->strm_, ctx->windowBits_);
-        ctx->env()->isolate()
-            ->AdjustAmountOfExternalAllocatedMemory(kInflateContextSize);
-        break;
-      default:
-        UNREACHABLE();
-    }
+    CHECK_NE(ctx->mode_, NONE);
+    ctx->strm_ = AcquireContext(ctx->env(), ctx->PoolKey(), &ctx->err_);
 
     ctx->dictionary_ = reinterpret_cast<Bytef *>(dictionary);
     ctx->dictionary_len_ = dictionary_len;
@@ -582,14 +623,14 @@ class ZCtx : public AsyncWrap {
     switch (ctx->mode_) {
       case DEFLATE:
       case DEFLATERAW:
-        ctx->err_ = deflateSetDictionary(&ctx->strm_,
+        ctx->err_ = deflateSetDictionary(ctx->strm_,
                                          ctx->dictionary_,
                                          ctx->dictionary_len_);
         break;
       case INFLATERAW:
         // The other inflate cases will have the dictionary set when inflate()
         // returns Z_NEED_DICT in Process()
-        ctx->err_ = inflateSetDictionary(&ctx->strm_,
+        ctx->err_ = inflateSetDictionary(ctx->strm_,
                                          ctx->dictionary_,
                                          ctx->dictionary_len_);
         break;
@@ -608,7 +649,9 @@ class ZCtx : public AsyncWrap {
     switch (ctx->mode_) {
       case DEFLATE:
       case DEFLATERAW:
-        ctx->err_ = deflateParams(&ctx->strm_, level, strategy);
+        ctx->err_ = deflateParams(ctx->strm_, level, strategy);
+        // The context no longer matches the parameters it was created with.
+        ctx->reusable_ = false;
         break;
       default:
         break;
@@ -626,12 +669,12 @@ class ZCtx : public AsyncWrap {
       case DEFLATE:
       case DEFLATERAW:
       case GZIP:
-        ctx->err_ = deflateReset(&ctx->strm_);
+        ctx->err_ = deflateReset(ctx->strm_);
         break;
       case INFLATE:
       case INFLATERAW:
       case GUNZIP:
-        ctx->err_ = inflateReset(&ctx->strm_);
+        ctx->err_ = inflateReset(ctx->strm_);
         break;
       default:
         break;
@@ -645,6 +688,16 @@ class ZCtx : public AsyncWrap {
   size_t self_size() const override { return sizeof(*this); }
 
  private:
+  bool IsDeflate() const {
+    return IsDeflateMode(mode_);
+  }
+
+  ZlibContextPool::Key PoolKey() const {
+    return ZlibContextPool::Key {
+      IsDeflate(), windowBits_, level_, memLevel_, strategy_
+    };
+  }
+
   void Ref() {
     if (++refs_ == 1) {
       ClearWeak();
@@ -658,9 +711,6 @@ class ZCtx : public AsyncWrap {
     }
   }
 
-  static const int kDeflateContextSize = 16384;  // approximate
-  static const int kInflateContextSize = 10240;  // approximate
-
   Bytef* dictionary_;
   size_t dictionary_len_;
   int err_;
@@ -670,18 +720,567 @@ class ZCtx : public AsyncWrap {
   int memLevel_;
   node_zlib_mode mode_;
   int strategy_;
-  z_stream strm_;
+  z_stream* strm_;
   int windowBits_;
   uv_work_t work_req_;
   bool write_in_progress_;
   bool pending_close_;
   unsigned int refs_;
   unsigned int gzip_id_bytes_read_;
+  bool reusable_;
   uint32_t* write_result_;
   Persistent<Function> write_js_callback_;
 };
 
 
+/**
+ * One block of a parallel gzip stream, see ParallelGzip in lib/zlib.js.
+ *
+ * The block is compressed into a raw deflate stream of its own, primed with
+ * the tail of the previous block's input so that back-references across the
+ * boundary are not lost, and ends on a byte boundary (Z_SYNC_FLUSH) unless it
+ * is the last one (Z_FINISH).  Those streams can simply be concatenated.
+ * The CRC32 of the input is computed on the threadpool as well.
+ */
+class DeflateBlockWrap : public ReqWrap<uv_work_t> {
+ public:
+  DeflateBlockWrap(Environment* env,
+                   Local<Object> req,
+                   const char* input,
+                   size_t input_length,
+                   const char* dictionary,
+                   size_t dictionary_length,
+                   int level,
+                   int mem_level,
+                   int strategy,
+                   bool last)
+      : ReqWrap(env, req, AsyncWrap::PROVIDER_DEFLATEBLOCKREQUEST),
+        input_(reinterpret_cast<const Bytef*>(input)),
+        input_length_(input_length),
+        dictionary_(reinterpret_cast<const Bytef*>(dictionary)),
+        dictionary_length_(dictionary_length),
+        level_(level),
+        mem_level_(mem_level),
+        strategy_(strategy),
+        last_(last) {
+    Wrap(object(), this);
+  }
+
+  ~DeflateBlockWrap() override {
+    free(output_);
+    ClearWrap(object());
+  }
+
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    CHECK(args.IsConstructCall());
+    ClearWrap(args.This());
+  }
+
+  // Arguments: input, dictionary or undefined, level, memLevel, strategy,
+  // last, req.  The input and dictionary need to be kept alive by the
+  // caller until req.oncomplete(err, output, crc) is called.
+  static void Run(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+
+    CHECK(Buffer::HasInstance(args[0]));
+    CHECK(args[1]->IsUndefined() || Buffer::HasInstance(args[1]));
+    CHECK(args[2]->IsInt32());
+    CHECK(args[3]->IsInt32());
+    CHECK(args[4]->IsInt32());
+    CHECK(args[6]->IsObject());
+
+    const char* dictionary = nullptr;
+    size_t dictionary_length = 0;
+    if (!args[1]->IsUndefined()) {
+      dictionary = Buffer::Data(args[1]);
+      dictionary_length = Buffer::Length(args[1]);
+    }
+
+    DeflateBlockWrap* req_wrap =
+        new DeflateBlockWrap(env,
+                             args[6].As<Object>(),
+                             Buffer::Data(args[0]),
+                             Buffer::Length(args[0]),
+                             dictionary,
+                             dictionary_length,
+                             args[2].As<Int32>()->Value(),
+                             args[3].As<Int32>()->Value(),
+                             args[4].As<Int32>()->Value(),
+                             args[5]->IsTrue());
+    req_wrap->Dispatched();
+    CHECK_EQ(0, uv_queue_work(env->event_loop(),
+                              req_wrap->req(),
+                              DeflateBlockWrap::Work,
+                              DeflateBlockWrap::After));
+  }
+
+  size_t self_size() const override { return sizeof(*this); }
+
+ private:
+  static void Work(uv_work_t* req) {
+    DeflateBlockWrap* req_wrap = static_cast<DeflateBlockWrap*>(req->data);
+    req_wrap->err_ = req_wrap->Deflate();
+    req_wrap->crc_ = crc32(0, req_wrap->input_, req_wrap->input_length_);
+  }
+
+  static void After(uv_work_t* req, int status) {
+    CHECK_EQ(status, 0);
+    std::unique_ptr<DeflateBlockWrap> req_wrap(
+        static_cast<DeflateBlockWrap*>(req->data));
+    Environment* env = req_wrap->env();
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+
+    if (req_wrap->err_ != Z_OK) {
+      Local<Value> argv[] = { Integer::New(env->isolate(), req_wrap->err_) };
+      req_wrap->MakeCallback(env->oncomplete_string(), arraysize(argv), argv);
+      return;
+    }
+
+    char* output = reinterpret_cast<char*>(req_wrap->output_);
+    req_wrap->output_ = nullptr;
+    Local<Value> argv[] = {
+      Null(env->isolate()),
+      Buffer::New(env, output, req_wrap->output_length_).ToLocalChecked(),
+      Integer::NewFromUnsigned(env->isolate(), req_wrap->crc_)
+    };
+    req_wrap->MakeCallback(env->oncomplete_string(), arraysize(argv), argv);
+  }
+
+  int Deflate() {
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+    int err = deflateInit2(&strm,
+                           level_,
+                           Z_DEFLATED,
+                           -Z_MAX_WINDOWBITS,
+                           mem_level_,
+                           strategy_);
+    if (err != Z_OK)
+      return err;
+
+    if (dictionary_length_ > 0) {
+      err = deflateSetDictionary(&strm, dictionary_, dictionary_length_);
+      if (err != Z_OK) {
+        deflateEnd(&strm);
+        return err;
+      }
+    }
+
+    // deflateBound() does not cover the empty stored block that
+    // Z_SYNC_FLUSH appends, hence the slack.
+    size_t capacity = deflateBound(&strm, input_length_) + 16;
+    output_ = node::UncheckedMalloc<Bytef>(capacity);
+    if (output_ == nullptr) {
+      deflateEnd(&strm);
+      return Z_MEM_ERROR;
+    }
+
+    const int flush = last_ ? Z_FINISH : Z_SYNC_FLUSH;
+    strm.next_in = const_cast<Bytef*>(input_);
+    strm.avail_in = input_length_;
+    for (;;) {
+      strm.next_out = output_ + output_length_;
+      strm.avail_out = capacity - output_length_;
+      err = deflate(&strm, flush);
+      output_length_ = capacity - strm.avail_out;
+
+      if (err == Z_STREAM_END || (flush == Z_SYNC_FLUSH && err == Z_OK &&
+                                  strm.avail_out != 0)) {
+        err = Z_OK;
+        break;
+      }
+      if (err != Z_OK && err != Z_BUF_ERROR)
+        break;
+
+      capacity *= 2;
+      Bytef* output = node::UncheckedRealloc(output_, capacity);
+      if (output == nullptr) {
+        err = Z_MEM_ERROR;
+        break;
+      }
+      output_ = output;
+    }
+
+    deflateEnd(&strm);
+    return err;
+  }
+
+  const Bytef* const input_;
+  const size_t input_length_;
+  const Bytef* const dictionary_;
+  const size_t dictionary_length_;
+  const int level_;
+  const int mem_level_;
+  const int strategy_;
+  const bool last_;
+  int err_ = Z_OK;
+  uLong crc_ = 0;
+  Bytef* output_ = nullptr;
+  size_t output_length_ = 0;
+};
+
+
+// Arguments: crc1, crc2, len2.  Returns the CRC32 of the concatenation of
+// the two inputs.
+void Crc32Combine(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsUint32());
+  CHECK(args[1]->IsUint32());
+  CHECK(args[2]->IsNumber());
+  const uLong crc = crc32_combine(args[0].As<Uint32>()->Value(),
+                                  args[1].As<Uint32>()->Value(),
+                                  args[2].As<Number>()->Value());
+  args.GetReturnValue().Set(static_cast<uint32_t>(crc));
+}
+
+
+/**
+ * Compresses or decompresses a single buffer in one go, see zlibOneShot() in
+ * lib/zlib.js.
+ *
+ * The context comes from, and goes back to, the Environment's context pool.
+ * The output is written into a single allocation that is sized with
+ * deflateBound() when compressing.  When decompressing it starts out at
+ * about the size of the input and is grown whenever zlib runs out of output
+ * space, as ZCtx does by handing out another chunk.  The allocation is
+ * shrunk to fit before it is handed to JS.  The error handling
+ * mirrors what ZCtx does for a stream that is ended with the same input.
+ */
+class ZlibOneShot {
+ public:
+  ZlibOneShot(Environment* env,
+              node_zlib_mode mode,
+              const ZlibContextPool::Key& key,
+              z_stream* strm,
+              int flush,
+              const char* input,
+              size_t input_length,
+              const char* dictionary,
+              size_t dictionary_length,
+              size_t max_output_length)
+      : env_(env),
+        mode_(mode),
+        key_(key),
+        strm_(strm),
+        flush_(flush),
+        input_(reinterpret_cast<const Bytef*>(input)),
+        input_length_(input_length),
+        dictionary_(reinterpret_cast<const Bytef*>(dictionary)),
+        dictionary_length_(dictionary_length),
+        max_output_length_(max_output_length) {}
+
+  ~ZlibOneShot() {
+    free(output_);
+    ReleaseContext(env_, key_, strm_, true);
+  }
+
+  // Runs on the threadpool for the asynchronous variant.
+  void Run() {
+    if (dictionary_ != nullptr) {
+      if (mode_ == DEFLATE || mode_ == DEFLATERAW) {
+        err_ = deflateSetDictionary(strm_, dictionary_, dictionary_length_);
+      } else if (mode_ == INFLATERAW) {
+        err_ = inflateSetDictionary(strm_, dictionary_, dictionary_length_);
+      }
+      if (err_ != Z_OK) {
+        message_ = "Failed to set dictionary";
+        return;
+      }
+    }
+
+    const bool deflating = IsDeflateMode(mode_);
+    // Like ZCtx, only look for further gzip members once the input is known
+    // to be gzip.
+    const bool gunzip =
+        mode_ == GUNZIP ||
+        (mode_ == UNZIP && input_length_ >= 2 &&
+         input_[0] == GZIP_HEADER_ID1 && input_[1] == GZIP_HEADER_ID2);
+
+    // Compressed output fits into deflateBound() unless a flush other than
+    // Z_FINISH is used.  For decompression the ratio is unknown, so start
+    // small and let Grow() double the output as often as needed.
+    size_t initial;
+    if (deflating) {
+      initial = deflateBound(strm_, input_length_);
+    } else {
+      initial = std::min(std::max(input_length_, kMinInflateOutput),
+                         kMaxInitialInflateOutput);
+    }
+
+    strm_->next_in = const_cast<Bytef*>(input_);
+    strm_->avail_in = input_length_;
+    strm_->avail_out = 0;
+    for (;;) {
+      if (strm_->avail_out == 0 && !Grow(initial)) {
+        if (too_large_)
+          return;
+        err_ = Z_MEM_ERROR;
+        break;
+      }
+
+      if (deflating) {
+        err_ = deflate(strm_, flush_);
+      } else {
+        err_ = inflate(strm_, flush_);
+        if (mode_ != INFLATERAW &&
+            err_ == Z_NEED_DICT &&
+            dictionary_ != nullptr) {
+          err_ = inflateSetDictionary(strm_, dictionary_, dictionary_length_);
+          if (err_ == Z_OK)
+            err_ = inflate(strm_, flush_);
+          else if (err_ == Z_DATA_ERROR)
+            err_ = Z_NEED_DICT;
+        }
+      }
+      output_length_ = strm_->next_out - output_;
+
+      if (gunzip &&
+          err_ == Z_STREAM_END &&
+          strm_->avail_in > 0 &&
+          strm_->next_in[0] != 0x00) {
+        // Another gzip member, or trailing garbage.
+        err_ = inflateReset(strm_);
+        if (err_ != Z_OK)
+          break;
+        continue;
+      }
+      if (err_ != Z_OK && err_ != Z_BUF_ERROR)
+        break;
+      if (strm_->avail_out != 0)
+        break;
+    }
+
+    switch (err_) {
+      case Z_OK:
+      case Z_BUF_ERROR:
+        if (strm_->avail_out != 0 && flush_ == Z_FINISH)
+          message_ = "unexpected end of file";
+        break;
+      case Z_STREAM_END:
+        break;
+      case Z_NEED_DICT:
+        message_ = dictionary_ == nullptr ? "Missing dictionary" :
+                                            "Bad dictionary";
+        break;
+      default:
+        message_ = "Zlib error";
+        break;
+    }
+    if (message_ != nullptr && strm_->msg != nullptr)
+      message_ = strm_->msg;
+    if (message_ == nullptr && output_length_ >= max_output_length_)
+      too_large_ = true;
+  }
+
+  // Fills in the arguments for the completion callback: an error message and
+  // zlib error code, or null and the output.  The output is undefined if it
+  // would have exceeded the maximum length.
+  void Finish(Local<Value> (*argv)[3]) {
+    Isolate* isolate = env_->isolate();
+    if (message_ != nullptr) {
+      (*argv)[0] = OneByteString(isolate, message_);
+      (*argv)[1] = Integer::New(isolate, err_);
+      (*argv)[2] = Undefined(isolate);
+      return;
+    }
+
+    (*argv)[0] = Null(isolate);
+    (*argv)[1] = Integer::New(isolate, err_);
+    if (too_large_) {
+      (*argv)[2] = Undefined(isolate);
+      return;
+    }
+    char* output = reinterpret_cast<char*>(
+        node::Realloc(output_, output_length_));
+    output_ = nullptr;
+    (*argv)[2] = Buffer::New(env_, output, output_length_).ToLocalChecked();
+  }
+
+ private:
+  // Allocates |initial| bytes of output the first time and doubles the
+  // allocation afterwards, without exceeding the maximum output length.  If
+  // doubling fails, growing by just |initial| bytes is tried before giving up.
+  bool Grow(size_t initial) {
+    if (output_length_ >= max_output_length_) {
+      too_large_ = true;
+      return false;
+    }
+    size_t capacity = capacity_ == 0 ? initial : capacity_ * 2;
+    capacity = std::min(std::max(capacity, output_length_ + 1),
+                        max_output_length_);
+    Bytef* output = node::UncheckedRealloc(output_, capacity);
+    if (output == nullptr && capacity > output_length_ + initial) {
+      capacity = std::min(output_length_ + initial, max_output_length_);
+      output = node::UncheckedRealloc(output_, capacity);
+    }
+    if (output == nullptr)
+      return false;
+    output_ = output;
+    capacity_ = capacity;
+    strm_->next_out = output_ + output_length_;
+    strm_->avail_out = capacity - output_length_;
+    return true;
+  }
+
+  Environment* const env_;
+  const node_zlib_mode mode_;
+  const ZlibContextPool::Key key_;
+  z_stream* const strm_;
+  const int flush_;
+  const Bytef* const input_;
+  const size_t input_length_;
+  const Bytef* const dictionary_;
+  const size_t dictionary_length_;
+  const size_t max_output_length_;
+  int err_ = Z_OK;
+  const char* message_ = nullptr;
+  bool too_large_ = false;
+  Bytef* output_ = nullptr;
+  size_t capacity_ = 0;
+  size_t output_length_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ZlibOneShot);
+};
+
+
+class ZlibOneShotWrap : public ReqWrap<uv_work_t> {
+ public:
+  ZlibOneShotWrap(Environment* env,
+                  Local<Object> req,
+                  std::unique_ptr<ZlibOneShot> job)
+      : ReqWrap(env, req, AsyncWrap::PROVIDER_ZLIB),
+        job_(std::move(job)) {
+    Wrap(object(), this);
+  }
+
+  ~ZlibOneShotWrap() override {
+    ClearWrap(object());
+  }
+
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    CHECK(args.IsConstructCall());
+    ClearWrap(args.This());
+  }
+
+  // Arguments: mode, input, windowBits, level, memLevel, strategy,
+  // dictionary or undefined, flush, maxOutputLength, req or undefined, ctx.
+  //
+  // Returns false if no context could be initialized.  With a req, the input
+  // and dictionary need to be kept alive by the caller until
+  // req.oncomplete(message, errno, output) is called.  Without one the work
+  // is done synchronously, the output is returned and errors are reported
+  // through ctx.message and ctx.errno.
+  static void Run(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+
+    CHECK(args[0]->IsInt32());
+    CHECK(Buffer::HasInstance(args[1]));
+    CHECK(args[2]->IsInt32());
+    CHECK(args[3]->IsInt32());
+    CHECK(args[4]->IsInt32());
+    CHECK(args[5]->IsInt32());
+    CHECK(args[6]->IsUndefined() || Buffer::HasInstance(args[6]));
+    CHECK(args[7]->IsInt32());
+    CHECK(args[8]->IsNumber());
+
+    const node_zlib_mode mode =
+        static_cast<node_zlib_mode>(args[0].As<Int32>()->Value());
+    CHECK(mode >= DEFLATE && mode <= UNZIP);
+    const ZlibContextPool::Key key {
+      IsDeflateMode(mode),
+      WindowBitsForMode(mode, args[2].As<Int32>()->Value()),
+      args[3].As<Int32>()->Value(),
+      args[4].As<Int32>()->Value(),
+      args[5].As<Int32>()->Value()
+    };
+
+    int err;
+    z_stream* strm = AcquireContext(env, key, &err);
+    if (strm == nullptr)
+      return args.GetReturnValue().Set(false);
+
+    const char* dictionary = nullptr;
+    size_t dictionary_length = 0;
+    if (!args[6]->IsUndefined()) {
+      dictionary = Buffer::Data(args[6]);
+      dictionary_length = Buffer::Length(args[6]);
+    }
+
+    std::unique_ptr<ZlibOneShot> job(
+        new ZlibOneShot(env,
+                        mode,
+                        key,
+                        strm,
+                        args[7].As<Int32>()->Value(),
+                        Buffer::Data(args[1]),
+                        Buffer::Length(args[1]),
+                        dictionary,
+                        dictionary_length,
+                        static_cast<size_t>(args[8].As<Number>()->Value())));
+
+    if (args[9]->IsObject()) {
+      ZlibOneShotWrap* req_wrap =
+          new ZlibOneShotWrap(env, args[9].As<Object>(), std::move(job));
+      req_wrap->Dispatched();
+      CHECK_EQ(0, uv_queue_work(env->event_loop(),
+                                req_wrap->req(),
+                                ZlibOneShotWrap::Work,
+                                ZlibOneShotWrap::After));
+      return args.GetReturnValue().Set(true);
+    }
+
+    CHECK(args[10]->IsObject());
+    env->PrintSyncTrace();
+    job->Run();
+    Local<Value> argv[3];
+    job->Finish(&argv);
+    if (!argv[0]->IsNull()) {
+      Local<Object> ctx = args[10].As<Object>();
+      ctx->Set(env->context(), env->message_string(), argv[0]).FromJust();
+      ctx->Set(env->context(), env->errno_string(), argv[1]).FromJust();
+    }
+    args.GetReturnValue().Set(argv[2]);
+  }
+
+  size_t self_size() const override { return sizeof(*this); }
+
+ private:
+  static void Work(uv_work_t* req) {
+    ZlibOneShotWrap* req_wrap = static_cast<ZlibOneShotWrap*>(req->data);
+    req_wrap->job_->Run();
+  }
+
+  static void After(uv_work_t* req, int status) {
+    CHECK_EQ(status, 0);
+    std::unique_ptr<ZlibOneShotWrap> req_wrap(
+        static_cast<ZlibOneShotWrap*>(req->data));
+    Environment* env = req_wrap->env();
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+
+    Local<Value> argv[3];
+    req_wrap->job_->Finish(&argv);
+    // Give the context back before calling into JS.
+    req_wrap->job_.reset();
+    req_wrap->MakeCallback(env->oncomplete_string(), arraysize(argv), argv);
+  }
+
+  std::unique_ptr<ZlibOneShot> job_;
+};
+
+
+// Arguments: size.  Sets the number of idle contexts that are kept around
+// for reuse and returns the previous limit.
+void SetContextPoolSize(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsUint32());
+  ZlibContextPool* pool = env->zlib_context_pool();
+  const uint32_t previous = pool->max_size();
+  pool->set_max_size(args[0].As<Uint32>()->Value());
+  args.GetReturnValue().Set(previous);
+}
+
+
 void InitZlib(Local<Object> target,
               Local<Value> unused,
               Local<Context> context,
@@ -703,6 +1302,31 @@ void InitZlib(Local<Object> target,
   z->SetClassName(zlibString);
   target->Set(zlibString, z->GetFunction());
 
+  Local<FunctionTemplate> db =
+      FunctionTemplate::New(env->isolate(), DeflateBlockWrap::New);
+  db->InstanceTemplate()->SetInternalFieldCount(1);
+  AsyncWrap::AddWrapMethods(env, db);
+  Local<String> deflateBlockString =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "DeflateBlockWrap");
+  db->SetClassName(deflateBlockString);
+  target->Set(deflateBlockString, db->GetFunction());
+  env->SetMethod(target, "deflateBlock", DeflateBlockWrap::Run);
+  env->SetMethod(target, "crc32Combine", Crc32Combine);
+
+  Local<FunctionTemplate> os =
+      FunctionTemplate::New(env->isolate(), ZlibOneShotWrap::New);
+  os->InstanceTemplate()->SetInternalFieldCount(1);
+  AsyncWrap::AddWrapMethods(env, os);
+  Local<String> oneShotString =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "ZlibOneShotWrap");
+  os->SetClassName(oneShotString);
+  target->Set(oneShotString, os->GetFunction());
+  env->SetMethod(target, "oneShot", ZlibOneShotWrap::Run);
+
+  env->SetMethod(target, "setContextPoolSize", SetContextPoolSize);
+  target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "contextPoolStats"),
+              env->zlib_context_pool()->stats_buffer.GetJSArray());
+
   target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "ZLIB_VERSION"),
               FIXED_ONE_BYTE_STRING(env->isolate(), ZLIB_VERSION));
 }
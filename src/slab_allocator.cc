@@ -0,0 +1,147 @@
+#include "slab_allocator.h"
+#include "env-inl.h"
+#include "node_internals.h"
+#include "util-inl.h"
+
+#include <stdlib.h>  // free()
+
+namespace node {
+
+using v8::ArrayBuffer;
+using v8::ArrayBufferCreationMode;
+using v8::EscapableHandleScope;
+using v8::HandleScope;
+using v8::Local;
+using v8::MaybeLocal;
+using v8::Object;
+using v8::Uint8Array;
+using v8::WeakCallbackInfo;
+using v8::WeakCallbackType;
+
+// Keep every reservation 8-byte aligned, like the pool in lib/buffer.js.
+static inline size_t RoundUp(size_t size) {
+  return (size + 7) & ~static_cast<size_t>(7);
+}
+
+
+SlabAllocator::SlabAllocator(Environment* env) : env_(env) {
+}
+
+
+SlabAllocator::~SlabAllocator() {
+  // The slab itself is owned by its ArrayBuffer, which frees it once the
+  // last Buffer pointing into it has been collected.
+  slab_.Reset();
+}
+
+
+bool SlabAllocator::InSlab(const char* data) const {
+  return slab_data_ != nullptr &&
+         data >= slab_data_ &&
+         data < slab_data_ + kSlabSize;
+}
+
+
+void SlabAllocator::Return(const uv_buf_t& buf, size_t used) {
+  CHECK_GT(outstanding_, 0);
+  outstanding_--;
+
+  // Only the most recent reservation can hand its unused tail back.
+  const size_t start = buf.base - slab_data_;
+  if (start + RoundUp(buf.len) == offset_)
+    offset_ = start + RoundUp(used);
+
+  // Nothing is reading into the slab anymore, so the Buffers that point
+  // into it are all that should keep it alive.
+  if (outstanding_ == 0)
+    slab_.SetWeak(this, WeakCallback, WeakCallbackType::kParameter);
+}
+
+
+void SlabAllocator::WeakCallback(
+    const WeakCallbackInfo<SlabAllocator>& data) {
+  SlabAllocator* allocator = data.GetParameter();
+  allocator->slab_.Reset();
+  allocator->slab_data_ = nullptr;
+  allocator->offset_ = 0;
+}
+
+
+void SlabAllocator::NewSlab() {
+  // Zeroed, so that the part of the slab that has not been read into yet
+  // does not expose whatever the memory was used for before.
+  char* data = node::UncheckedCalloc(kSlabSize);
+  if (data == nullptr)
+    return;
+
+  HandleScope handle_scope(env_->isolate());
+  Local<ArrayBuffer> ab =
+      ArrayBuffer::New(env_->isolate(),
+                       data,
+                       kSlabSize,
+                       ArrayBufferCreationMode::kInternalized);
+  // The previous slab, if any, is left to the Buffers that point into it.
+  slab_.Reset(env_->isolate(), ab);
+  slab_data_ = data;
+  offset_ = 0;
+  env_->slab_allocator_stats()[IDX_SLAB_STATS_SLABS] += 1;
+}
+
+
+uv_buf_t SlabAllocator::Allocate(size_t size) {
+  const size_t reserved = RoundUp(size);
+
+  if (size <= kMaxSlabRead) {
+    // A slab can only be dropped when nothing is reading into it anymore.
+    if ((slab_data_ == nullptr || kSlabSize - offset_ < reserved) &&
+        outstanding_ == 0) {
+      NewSlab();
+    }
+
+    if (slab_data_ != nullptr && kSlabSize - offset_ >= reserved) {
+      // Keep the slab alive while it is being read into.
+      if (outstanding_++ == 0 && slab_.IsWeak())
+        slab_.ClearWeak();
+      char* base = slab_data_ + offset_;
+      offset_ += reserved;
+      env_->slab_allocator_stats()[IDX_SLAB_STATS_HITS] += 1;
+      return uv_buf_init(base, size);
+    }
+  }
+
+  env_->slab_allocator_stats()[IDX_SLAB_STATS_MISSES] += 1;
+  return uv_buf_init(node::Malloc(size), size);
+}
+
+
+MaybeLocal<Object> SlabAllocator::Shrink(const uv_buf_t& buf, size_t nread) {
+  CHECK_LE(nread, buf.len);
+
+  if (!InSlab(buf.base)) {
+    char* base = node::Realloc(buf.base, nread);
+    return Buffer::New(env_, base, nread);
+  }
+
+  EscapableHandleScope scope(env_->isolate());
+  const size_t start = buf.base - slab_data_;
+  Local<ArrayBuffer> ab = slab_.Get(env_->isolate());
+  Local<Uint8Array> ui = Uint8Array::New(ab, start, nread);
+  Return(buf, nread);
+  env_->slab_allocator_stats()[IDX_SLAB_STATS_BYTES] += nread;
+
+  if (ui->SetPrototype(env_->context(), env_->buffer_prototype_object())
+          .FromMaybe(false)) {
+    return scope.Escape(ui);
+  }
+  return MaybeLocal<Object>();
+}
+
+
+void SlabAllocator::Release(const uv_buf_t& buf) {
+  if (InSlab(buf.base))
+    Return(buf, 0);
+  else
+    free(buf.base);
+}
+
+}  // namespace node
@@ -0,0 +1,75 @@
+#ifndef SRC_SLAB_ALLOCATOR_H_
+#define SRC_SLAB_ALLOCATOR_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "util.h"
+#include "uv.h"
+#include "v8.h"
+
+namespace node {
+
+class Environment;
+
+enum SlabAllocatorStatsIndex {
+  IDX_SLAB_STATS_SLABS,         // Number of slabs allocated.
+  IDX_SLAB_STATS_HITS,          // Reads that were carved out of a slab.
+  IDX_SLAB_STATS_MISSES,        // Reads that fell back to malloc().
+  IDX_SLAB_STATS_BYTES,         // Bytes handed out to JS from slabs.
+  IDX_SLAB_STATS_COUNT
+};
+
+// Hands out the read buffers of a single stream from ArrayBuffer slabs that
+// belong to that stream alone.  The bytes that were actually read are
+// exposed to JS as a zero-copy Buffer view into the slab and the unused tail
+// of the reservation is returned to the slab, so a steady stream of reads
+// costs neither a malloc() nor a realloc() each.
+//
+// Bytes that have been handed out are never written again: a slab that is
+// full is dropped and, like the pool in lib/buffer.js, lives on only for as
+// long as a Buffer points into it.  Because slabs are not shared and start
+// out zero-filled, a chunk's |buffer| never exposes the data of other
+// streams.  Between reads the slab is only held weakly, so an idle stream
+// whose chunks have been collected holds no memory.  Requests larger than
+// kMaxSlabRead, and requests that arrive while a full slab still has reads
+// outstanding, fall back to a plain malloc().  Counters are kept per
+// Environment, see Environment::slab_allocator_stats().
+class SlabAllocator {
+ public:
+  static const size_t kSlabSize = 128 * 1024;
+  static const size_t kMaxSlabRead = 64 * 1024;
+
+  explicit SlabAllocator(Environment* env);
+  ~SlabAllocator();
+
+  // Reserves |size| bytes, from the current slab where possible.
+  uv_buf_t Allocate(size_t size);
+
+  // Turns the first |nread| bytes of a buffer returned by Allocate() into a
+  // Buffer and gives the remainder of the reservation back.
+  v8::MaybeLocal<v8::Object> Shrink(const uv_buf_t& buf, size_t nread);
+
+  // Gives a reservation back without handing anything to JS, e.g. after
+  // a read error or an empty read.
+  void Release(const uv_buf_t& buf);
+
+ private:
+  inline bool InSlab(const char* data) const;
+  inline void Return(const uv_buf_t& buf, size_t used);
+  void NewSlab();
+  static void WeakCallback(const v8::WeakCallbackInfo<SlabAllocator>& data);
+
+  Environment* const env_;
+  v8::Global<v8::ArrayBuffer> slab_;
+  char* slab_data_ = nullptr;
+  size_t offset_ = 0;
+  size_t outstanding_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(SlabAllocator);
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_SLAB_ALLOCATOR_H_
@@ -80,6 +80,9 @@ void LibuvStreamWrap::Initialize(Local<Object> target,
   AsyncWrap::AddWrapMethods(env, ww);
   target->Set(writeWrapString, ww->GetFunction());
   env->set_write_wrap_constructor_function(ww->GetFunction());
+
+  target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "slabAllocatorStats"),
+              env->slab_allocator_stats().GetJSArray());
 }
 
 
@@ -92,7 +95,8 @@ LibuvStreamWrap::LibuvStreamWrap(Environment* env,
                  reinterpret_cast<uv_handle_t*>(stream),
                  provider),
       StreamBase(env),
-      stream_(stream) {
+      stream_(stream),
+      read_allocator_(env) {
   set_alloc_cb({ OnAllocImpl, this });
   set_read_cb({ OnReadImpl, this });
 }
@@ -170,8 +174,8 @@ void LibuvStreamWrap::OnAlloc(uv_handle_t* handle,
 
 
 void LibuvStreamWrap::OnAllocImpl(size_t size, uv_buf_t* buf, void* ctx) {
-  buf->base = node::Malloc(size);
-  buf->len = size;
+  LibuvStreamWrap* wrap = static_cast<LibuvStreamWrap*>(ctx);
+  *buf = wrap->read_allocator_.Allocate(size);
 }
 
 
@@ -205,23 +209,22 @@ void LibuvStreamWrap::OnReadImpl(ssize_t nread,
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
+  SlabAllocator* allocator = &wrap->read_allocator_;
   Local<Object> pending_obj;
 
   if (nread < 0)  {
-    if (buf->base != nullptr)
-      free(buf->base);
+    allocator->Release(*buf);
     wrap->EmitData(nread, Local<Object>(), pending_obj);
     return;
   }
 
   if (nread == 0) {
-    if (buf->base != nullptr)
-      free(buf->base);
+    allocator->Release(*buf);
     return;
   }
 
   CHECK_LE(static_cast<size_t>(nread), buf->len);
-  char* base = node::Realloc(buf->base, nread);
+  Local<Object> obj = allocator->Shrink(*buf, nread).ToLocalChecked();
 
   if (pending == UV_TCP) {
     pending_obj = AcceptHandle<TCPWrap, uv_tcp_t>(env, wrap);
@@ -233,7 +236,6 @@ void LibuvStreamWrap::OnReadImpl(ssize_t nread,
     CHECK_EQ(pending, UV_UNKNOWN_HANDLE);
   }
 
-  Local<Object> obj = Buffer::New(env, base, nread).ToLocalChecked();
   wrap->EmitData(nread, obj, pending_obj);
 }
 
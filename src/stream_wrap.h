@@ -28,6 +28,7 @@
 
 #include "env.h"
 #include "handle_wrap.h"
+#include "slab_allocator.h"
 #include "string_bytes.h"
 #include "v8.h"
 
@@ -115,6 +116,7 @@ class LibuvStreamWrap : public HandleWrap, public StreamBase {
   void AfterWrite(WriteWrap* req_wrap, int status) override;
 
   uv_stream_t* const stream_;
+  SlabAllocator read_allocator_;
 };
 
 
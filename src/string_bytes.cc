@@ -22,6 +22,7 @@
 #include "string_bytes.h"
 
 #include "base64.h"
+#include "string_bytes_simd.h"
 #include "node_internals.h"
 #include "node_buffer.h"
 
@@ -251,13 +252,21 @@ static inline unsigned unhex(uint8_t x) {
   return unhex_table[x];
 }
 
+template <typename TypeName>
+static inline size_t hex_decode_simd(char* buf,
+                                     size_t len,
+                                     const TypeName* src,
+                                     const size_t srcLen) {
+  return 0;
+}
+
 template <typename TypeName>
 static size_t hex_decode(char* buf,
                          size_t len,
                          const TypeName* src,
                          const size_t srcLen) {
-  size_t i;
-  for (i = 0; i < len && i * 2 + 1 < srcLen; ++i) {
+  size_t i = hex_decode_simd(buf, len, src, srcLen) / 2;
+  for (; i < len && i * 2 + 1 < srcLen; ++i) {
     unsigned a = unhex(src[i * 2 + 0]);
     unsigned b = unhex(src[i * 2 + 1]);
     if (!~a || !~b)
@@ -405,6 +414,12 @@ size_t StringBytes::Write(Isolate* isolate,
     case BASE64:
       if (is_extern) {
         nbytes = base64_decode(buf, buflen, data, external_nbytes);
+      } else if (str->IsOneByte()) {
+        // One-byte input can take the vectorized decoder.
+        MaybeStackBuffer<char> stack_buf(str->Length());
+        str->WriteOneByte(reinterpret_cast<uint8_t*>(*stack_buf), 0, -1,
+                          String::NO_NULL_TERMINATION);
+        nbytes = base64_decode(buf, buflen, *stack_buf, stack_buf.length());
       } else {
         String::Value value(str);
         nbytes = base64_decode(buf, buflen, *value, value.length());
@@ -417,6 +432,11 @@ size_t StringBytes::Write(Isolate* isolate,
     case HEX:
       if (is_extern) {
         nbytes = hex_decode(buf, buflen, data, external_nbytes);
+      } else if (str->IsOneByte()) {
+        MaybeStackBuffer<char> stack_buf(str->Length());
+        str->WriteOneByte(reinterpret_cast<uint8_t*>(*stack_buf), 0, -1,
+                          String::NO_NULL_TERMINATION);
+        nbytes = hex_decode(buf, buflen, *stack_buf, stack_buf.length());
       } else {
         String::Value value(str);
         nbytes = hex_decode(buf, buflen, *value, value.length());
@@ -558,6 +578,10 @@ static bool contains_non_ascii_slow(const char* buf, size_t len) {
 
 
 static bool contains_non_ascii(const char* src, size_t len) {
+  const size_t ascii = ascii_prefix_simd(src, len);
+  src += ascii;
+  len -= ascii;
+
   if (len < 16) {
     return contains_non_ascii_slow(src, len);
   }
@@ -657,7 +681,8 @@ static size_t hex_encode(const char* src, size_t slen, char* dst, size_t dlen) {
       "not enough space provided for hex encode");
 
   dlen = slen * 2;
-  for (uint32_t i = 0, k = 0; k < dlen; i += 1, k += 2) {
+  const size_t done = hex_encode_simd(src, slen, dst);
+  for (size_t i = done, k = done * 2; k < dlen; i += 1, k += 2) {
     static const char hex[] = "0123456789abcdef";
     uint8_t val = static_cast<uint8_t>(src[i]);
     dst[k + 0] = hex[val >> 4];
@@ -668,6 +693,61 @@ static size_t hex_encode(const char* src, size_t slen, char* dst, size_t dlen) {
 }
 
 
+// Returns the length of the longest prefix of |data| that is well-formed
+// UTF-8 (Unicode 10.0, table 3-7), i.e. without overlong forms, surrogates
+// or code points past U+10FFFF, so that it is exactly what V8 accepts.  The
+// vectorized validator handles what it can and the rest is checked one
+// sequence at a time.
+static size_t utf8_valid_prefix(const char* data, size_t length) {
+  const uint8_t* const src = reinterpret_cast<const uint8_t*>(data);
+  size_t i = utf8_valid_prefix_simd(data, length);
+  while (i < length) {
+    const uint8_t c = src[i];
+    if (c < 0x80) {
+      i++;
+      continue;
+    }
+
+    size_t n;
+    uint8_t lo = 0x80;
+    uint8_t hi = 0xBF;
+    if (c >= 0xC2 && c <= 0xDF) {
+      n = 1;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+      n = 2;
+      if (c == 0xE0) lo = 0xA0;
+      if (c == 0xED) hi = 0x9F;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+      n = 3;
+      if (c == 0xF0) lo = 0x90;
+      if (c == 0xF4) hi = 0x8F;
+    } else {
+      break;
+    }
+
+    if (length - i <= n)
+      break;
+    size_t k = 1;
+    for (; k <= n; k++) {
+      const uint8_t cc = src[i + k];
+      if (cc < lo || cc > hi)
+        break;
+      lo = 0x80;
+      hi = 0xBF;
+    }
+    if (k <= n)
+      break;
+    i += n + 1;
+  }
+  return i;
+}
+
+
+bool StringBytes::IsValidUtf8(const char* data, size_t length) {
+  return utf8_valid_prefix(data, length) == length;
+}
+
+
 #define CHECK_BUFLEN_IN_RANGE(len)                                    \
   do {                                                                \
     if ((len) > Buffer::kMaxLength) {                                 \
@@ -716,6 +796,9 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
       }
 
     case UTF8:
+      // ASCII is Latin-1 as well, so V8's UTF-8 decoder can be skipped.
+      if (!contains_non_ascii(buf, buflen))
+        return ExternOneByteString::NewFromCopy(isolate, buf, buflen, error);
       val = String::NewFromUtf8(isolate,
                                 buf,
                                 v8::NewStringType::kNormal,
@@ -817,4 +900,93 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
   return ret;
 }
 
+bool StringBytes::IsAscii(const char* buf, size_t buflen) {
+  return !contains_non_ascii(buf, buflen);
+}
+
+
+bool StringBytes::DecodeUtf8(const char* buf,
+                             size_t buflen,
+                             uint16_t* out,
+                             size_t* out_length) {
+  // Only well-formed UTF-8 is decoded here, so that the result is identical
+  // to what V8 produces for the same input.  Once that is established the
+  // length of each sequence follows from its lead byte.
+  if (!IsValidUtf8(buf, buflen))
+    return false;
+
+  const uint8_t* src = reinterpret_cast<const uint8_t*>(buf);
+  const uint8_t* const end = src + buflen;
+  uint16_t* dst = out;
+  while (src < end) {
+    const uint8_t c = *src;
+    if (c < 0x80) {
+      *dst++ = c;
+      src += 1;
+      continue;
+    }
+
+    size_t n;
+    uint32_t cp;
+    if (c < 0xE0) {
+      n = 1;
+      cp = c & 0x1F;
+    } else if (c < 0xF0) {
+      n = 2;
+      cp = c & 0x0F;
+    } else {
+      n = 3;
+      cp = c & 0x07;
+    }
+    for (size_t i = 1; i <= n; i++)
+      cp = (cp << 6) | (src[i] & 0x3F);
+    src += n + 1;
+
+    if (cp >= 0x10000) {
+      cp -= 0x10000;
+      *dst++ = static_cast<uint16_t>(0xD800 + (cp >> 10));
+      *dst++ = static_cast<uint16_t>(0xDC00 + (cp & 0x3FF));
+    } else {
+      *dst++ = static_cast<uint16_t>(cp);
+    }
+  }
+
+  *out_length = dst - out;
+  return true;
+}
+
+
+MaybeLocal<Value> StringBytes::EncodeOwned(Isolate* isolate,
+                                           char* buf,
+                                           size_t buflen,
+                                           Local<Value>* error) {
+  if (buflen > Buffer::kMaxLength) {
+    free(buf);
+    *error = SB_BUFFER_SIZE_EXCEEDED_ERROR;
+    return MaybeLocal<Value>();
+  }
+  if (buflen == 0) {
+    free(buf);
+    return String::Empty(isolate);
+  }
+  return ExternOneByteString::New(isolate, buf, buflen, error);
+}
+
+
+MaybeLocal<Value> StringBytes::EncodeOwned(Isolate* isolate,
+                                           uint16_t* buf,
+                                           size_t buflen,
+                                           Local<Value>* error) {
+  if (buflen > Buffer::kMaxLength) {
+    free(buf);
+    *error = SB_BUFFER_SIZE_EXCEEDED_ERROR;
+    return MaybeLocal<Value>();
+  }
+  if (buflen == 0) {
+    free(buf);
+    return String::Empty(isolate);
+  }
+  return ExternTwoByteString::New(isolate, buf, buflen, error);
+}
+
 }  // namespace node
@@ -81,6 +81,10 @@ class StringBytes {
                      v8::Local<v8::Value> val,
                      enum encoding enc);
 
+  // Whether the bytes are well-formed UTF-8, i.e. without overlong forms,
+  // surrogates or code points past U+10FFFF.
+  static bool IsValidUtf8(const char* data, size_t length);
+
   // If the string is external then assign external properties to data and len,
   // then return true. If not return false.
   static bool GetExternalParts(v8::Local<v8::Value> val,
@@ -117,6 +121,30 @@ class StringBytes {
                                           enum encoding encoding,
                                           v8::Local<v8::Value>* error);
 
+  // Like Encode() with LATIN1 and UCS2 respectively, but takes ownership of
+  // |buf|, which must have been allocated with malloc().  Large strings use
+  // |buf| as their external backing store instead of copying it.
+  static v8::MaybeLocal<v8::Value> EncodeOwned(v8::Isolate* isolate,
+                                               char* buf,
+                                               size_t buflen,
+                                               v8::Local<v8::Value>* error);
+  static v8::MaybeLocal<v8::Value> EncodeOwned(v8::Isolate* isolate,
+                                               uint16_t* buf,
+                                               size_t buflen,
+                                               v8::Local<v8::Value>* error);
+
+  // The following do not touch V8 and are therefore safe to call off the
+  // main thread.
+
+  static bool IsAscii(const char* buf, size_t buflen);
+
+  // Decodes well-formed UTF-8 into UTF-16.  |out| must have room for
+  // |buflen| code units.  Returns false if |buf| is not well-formed.
+  static bool DecodeUtf8(const char* buf,
+                         size_t buflen,
+                         uint16_t* out,
+                         size_t* out_length);
+
  private:
   static size_t WriteUCS2(char* buf,
                           size_t buflen,
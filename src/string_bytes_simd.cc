@@ -0,0 +1,752 @@
+#include "string_bytes_simd.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__) || \
+    defined(_M_X64) || defined(_M_IX86)
+#define NODE_SIMD_X86 1
+#endif
+
+#if defined(NODE_SIMD_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <immintrin.h>
+#endif
+
+// GCC and clang only emit the instructions of an extension in functions that
+// are compiled for it, MSVC emits them everywhere.
+#if defined(__GNUC__)
+#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SIMD_TARGET(isa)
+#endif
+
+namespace node {
+
+#if defined(NODE_SIMD_X86)
+
+namespace {
+
+typedef size_t (*EncodeFn)(const char* src, size_t slen, char* dst);
+typedef size_t (*DecodeFn)(char* dst, size_t dlen,
+                           const char* src, size_t slen);
+
+size_t EncodeNone(const char* src, size_t slen, char* dst) {
+  return 0;
+}
+
+size_t DecodeNone(char* dst, size_t dlen, const char* src, size_t slen) {
+  return 0;
+}
+
+
+void CpuId(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuidex(info, leaf, subleaf);
+  for (int i = 0; i < 4; i++)
+    regs[i] = static_cast<uint32_t>(info[i]);
+#else
+  __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Whether the OS saves the YMM registers on context switches.
+bool OsSupportsAvx() {
+#if defined(_MSC_VER)
+  return (_xgetbv(0) & 6) == 6;
+#else
+  uint32_t eax;
+  uint32_t edx;
+  __asm__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (eax & 6) == 6;
+#endif
+}
+
+enum SimdLevel { kNone, kSSE41, kAVX2 };
+
+SimdLevel DetectSimdLevel() {
+  uint32_t regs[4];
+  CpuId(0, 0, regs);
+  const uint32_t max_leaf = regs[0];
+  if (max_leaf < 1)
+    return kNone;
+  CpuId(1, 0, regs);
+  const bool sse41 = regs[2] & (1 << 19);
+  const bool osxsave = regs[2] & (1 << 27);
+  const bool avx = regs[2] & (1 << 28);
+  if (!sse41)
+    return kNone;
+  if (max_leaf >= 7 && osxsave && avx && OsSupportsAvx()) {
+    CpuId(7, 0, regs);
+    if (regs[1] & (1 << 5))
+      return kAVX2;
+  }
+  return kSSE41;
+}
+
+
+// Lanes of |in| that lie in [lo, hi] become 0xFF, all others 0.  Bytes
+// >= 0x80 compare as negative numbers, so they never match an ASCII range.
+SIMD_TARGET("sse4.1")
+inline __m128i InRange(__m128i in, char lo, char hi) {
+  return _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8(lo - 1)),
+                       _mm_cmplt_epi8(in, _mm_set1_epi8(hi + 1)));
+}
+
+SIMD_TARGET("avx2")
+inline __m256i InRange(__m256i in, char lo, char hi) {
+  return _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8(lo - 1)),
+                          _mm256_cmpgt_epi8(_mm256_set1_epi8(hi + 1), in));
+}
+
+SIMD_TARGET("sse4.1")
+inline void Store12(char* dst, __m128i v) {
+  _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), v);
+  const uint32_t tail = _mm_extract_epi32(v, 2);
+  memcpy(dst + 8, &tail, sizeof(tail));
+}
+
+
+//// Base 64 ////
+
+// Spreads the 12 bytes at offset 0 of each 128-bit lane over 16 bytes, one
+// 3-byte group per 32-bit word, in the order the bit fiddling below needs.
+#define BASE64_ENCODE_SHUFFLE                                                 \
+  1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10
+
+// Maps 6-bit values to characters:  The index into the table is 0 for
+// 'A'-'Z', 1 for 'a'-'z', 2-11 for '0'-'9', 12 for '+' and 13 for '/', and
+// the table holds the offset to add to the value.
+#define BASE64_ENCODE_OFFSETS                                                 \
+  65, 71, -4, -4, -4, -4, -4, -4, -4, -4, -4, -4, -19, -16, 0, 0
+
+SIMD_TARGET("sse4.1")
+size_t Base64EncodeSSE41(const char* src, size_t slen, char* dst) {
+  const __m128i shuffle = _mm_setr_epi8(BASE64_ENCODE_SHUFFLE);
+  const __m128i offsets = _mm_setr_epi8(BASE64_ENCODE_OFFSETS);
+  size_t i = 0;
+  size_t k = 0;
+  // Loads 16 bytes but only uses 12 of them.
+  while (i + 16 <= slen) {
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    in = _mm_shuffle_epi8(in, shuffle);
+    // Move the four 6-bit fields of each word into their own bytes.
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    const __m128i values = _mm_or_si128(t1, t3);
+    __m128i index = _mm_subs_epu8(values, _mm_set1_epi8(51));
+    index = _mm_sub_epi8(index,
+                         _mm_cmpgt_epi8(values, _mm_set1_epi8(25)));
+    const __m128i out =
+        _mm_add_epi8(values, _mm_shuffle_epi8(offsets, index));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k), out);
+    i += 12;
+    k += 16;
+  }
+  return i;
+}
+
+SIMD_TARGET("avx2")
+size_t Base64EncodeAVX2(const char* src, size_t slen, char* dst) {
+  const __m256i shuffle = _mm256_setr_epi8(BASE64_ENCODE_SHUFFLE,
+                                           BASE64_ENCODE_SHUFFLE);
+  const __m256i offsets = _mm256_setr_epi8(BASE64_ENCODE_OFFSETS,
+                                           BASE64_ENCODE_OFFSETS);
+  size_t i = 0;
+  size_t k = 0;
+  // Each lane gets 12 bytes; the second load reads 4 bytes past them.
+  while (i + 28 <= slen) {
+    const __m128i lo =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i hi =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 12));
+    __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    in = _mm256_shuffle_epi8(in, shuffle);
+    const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+    const __m256i t1 =
+        _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+    const __m256i t3 =
+        _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    const __m256i values = _mm256_or_si256(t1, t3);
+    __m256i index = _mm256_subs_epu8(values, _mm256_set1_epi8(51));
+    index = _mm256_sub_epi8(index,
+                            _mm256_cmpgt_epi8(values, _mm256_set1_epi8(25)));
+    const __m256i out =
+        _mm256_add_epi8(values, _mm256_shuffle_epi8(offsets, index));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k), out);
+    i += 24;
+    k += 32;
+  }
+  return i + Base64EncodeSSE41(src + i, slen - i, dst + k);
+}
+
+#undef BASE64_ENCODE_SHUFFLE
+#undef BASE64_ENCODE_OFFSETS
+
+
+// Packs four 6-bit values per 32-bit word into 3 bytes, leaving 12 bytes at
+// the start of each 128-bit lane.
+#define BASE64_DECODE_SHUFFLE                                                 \
+  2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+
+SIMD_TARGET("sse4.1")
+size_t Base64DecodeSSE41(char* dst, size_t dlen,
+                         const char* src, size_t slen) {
+  const __m128i shuffle = _mm_setr_epi8(BASE64_DECODE_SHUFFLE);
+  size_t i = 0;
+  size_t k = 0;
+  while (i + 16 <= slen && k + 12 <= dlen) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i upper = InRange(in, 'A', 'Z');
+    const __m128i lower = InRange(in, 'a', 'z');
+    const __m128i digit = InRange(in, '0', '9');
+    const __m128i plus = _mm_or_si128(_mm_cmpeq_epi8(in, _mm_set1_epi8('+')),
+                                      _mm_cmpeq_epi8(in, _mm_set1_epi8('-')));
+    const __m128i slash =
+        _mm_or_si128(_mm_cmpeq_epi8(in, _mm_set1_epi8('/')),
+                     _mm_cmpeq_epi8(in, _mm_set1_epi8('_')));
+    const __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower),
+                                       _mm_or_si128(digit,
+                                                    _mm_or_si128(plus, slash)));
+    if (_mm_movemask_epi8(valid) != 0xffff)
+      break;
+    const __m128i values = _mm_or_si128(
+        _mm_or_si128(
+            _mm_and_si128(upper, _mm_sub_epi8(in, _mm_set1_epi8(65))),
+            _mm_and_si128(lower, _mm_sub_epi8(in, _mm_set1_epi8(71)))),
+        _mm_or_si128(
+            _mm_and_si128(digit, _mm_add_epi8(in, _mm_set1_epi8(4))),
+            _mm_or_si128(_mm_and_si128(plus, _mm_set1_epi8(62)),
+                         _mm_and_si128(slash, _mm_set1_epi8(63)))));
+    const __m128i pairs =
+        _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    const __m128i words = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    Store12(dst + k, _mm_shuffle_epi8(words, shuffle));
+    i += 16;
+    k += 12;
+  }
+  return i;
+}
+
+SIMD_TARGET("avx2")
+size_t Base64DecodeAVX2(char* dst, size_t dlen,
+                        const char* src, size_t slen) {
+  const __m256i shuffle = _mm256_setr_epi8(BASE64_DECODE_SHUFFLE,
+                                           BASE64_DECODE_SHUFFLE);
+  size_t i = 0;
+  size_t k = 0;
+  while (i + 32 <= slen && k + 24 <= dlen) {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i upper = InRange(in, 'A', 'Z');
+    const __m256i lower = InRange(in, 'a', 'z');
+    const __m256i digit = InRange(in, '0', '9');
+    const __m256i plus =
+        _mm256_or_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('+')),
+                        _mm256_cmpeq_epi8(in, _mm256_set1_epi8('-')));
+    const __m256i slash =
+        _mm256_or_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('/')),
+                        _mm256_cmpeq_epi8(in, _mm256_set1_epi8('_')));
+    const __m256i valid =
+        _mm256_or_si256(_mm256_or_si256(upper, lower),
+                        _mm256_or_si256(digit, _mm256_or_si256(plus, slash)));
+    if (_mm256_movemask_epi8(valid) != -1)
+      break;
+    const __m256i values = _mm256_or_si256(
+        _mm256_or_si256(
+            _mm256_and_si256(upper, _mm256_sub_epi8(in, _mm256_set1_epi8(65))),
+            _mm256_and_si256(lower, _mm256_sub_epi8(in, _mm256_set1_epi8(71)))),
+        _mm256_or_si256(
+            _mm256_and_si256(digit, _mm256_add_epi8(in, _mm256_set1_epi8(4))),
+            _mm256_or_si256(_mm256_and_si256(plus, _mm256_set1_epi8(62)),
+                            _mm256_and_si256(slash, _mm256_set1_epi8(63)))));
+    const __m256i pairs =
+        _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+    const __m256i words =
+        _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+    const __m256i out = _mm256_shuffle_epi8(words, shuffle);
+    Store12(dst + k, _mm256_castsi256_si128(out));
+    Store12(dst + k + 12, _mm256_extracti128_si256(out, 1));
+    i += 32;
+    k += 24;
+  }
+  return i + Base64DecodeSSE41(dst + k, dlen - k, src + i, slen - i);
+}
+
+#undef BASE64_DECODE_SHUFFLE
+
+
+//// Hex ////
+
+#define HEX_DIGITS                                                            \
+  '0', '1', '2', '3', '4', '5', '6', '7',                                     \
+  '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
+
+SIMD_TARGET("sse4.1")
+size_t HexEncodeSSE41(const char* src, size_t slen, char* dst) {
+  const __m128i digits = _mm_setr_epi8(HEX_DIGITS);
+  const __m128i mask = _mm_set1_epi8(0x0f);
+  size_t i = 0;
+  while (i + 16 <= slen) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i hi =
+        _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(in, 4), mask));
+    const __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(in, mask));
+    __m128i* out = reinterpret_cast<__m128i*>(dst + i * 2);
+    _mm_storeu_si128(out, _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(out + 1, _mm_unpackhi_epi8(hi, lo));
+    i += 16;
+  }
+  return i;
+}
+
+SIMD_TARGET("avx2")
+size_t HexEncodeAVX2(const char* src, size_t slen, char* dst) {
+  const __m256i digits = _mm256_setr_epi8(HEX_DIGITS, HEX_DIGITS);
+  const __m256i mask = _mm256_set1_epi8(0x0f);
+  size_t i = 0;
+  while (i + 32 <= slen) {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i hi = _mm256_shuffle_epi8(
+        digits, _mm256_and_si256(_mm256_srli_epi16(in, 4), mask));
+    const __m256i lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(in, mask));
+    // The unpacks work within lanes, so put the lanes back in order.
+    const __m256i first = _mm256_unpacklo_epi8(hi, lo);
+    const __m256i second = _mm256_unpackhi_epi8(hi, lo);
+    __m256i* out = reinterpret_cast<__m256i*>(dst + i * 2);
+    _mm256_storeu_si256(out, _mm256_permute2x128_si256(first, second, 0x20));
+    _mm256_storeu_si256(out + 1,
+                        _mm256_permute2x128_si256(first, second, 0x31));
+    i += 32;
+  }
+  return i + HexEncodeSSE41(src + i, slen - i, dst + i * 2);
+}
+
+#undef HEX_DIGITS
+
+
+// Turns hex digits into their values.  |*valid| is cleared unless every
+// byte is a digit.
+SIMD_TARGET("sse4.1")
+inline __m128i UnhexSSE41(__m128i in, bool* valid) {
+  const __m128i digit = InRange(in, '0', '9');
+  const __m128i lower = _mm_or_si128(in, _mm_set1_epi8(0x20));
+  const __m128i alpha = InRange(lower, 'a', 'f');
+  if (_mm_movemask_epi8(_mm_or_si128(digit, alpha)) != 0xffff)
+    *valid = false;
+  return _mm_or_si128(
+      _mm_and_si128(digit, _mm_sub_epi8(in, _mm_set1_epi8('0'))),
+      _mm_and_si128(alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+}
+
+SIMD_TARGET("avx2")
+inline __m256i UnhexAVX2(__m256i in, bool* valid) {
+  const __m256i digit = InRange(in, '0', '9');
+  const __m256i lower = _mm256_or_si256(in, _mm256_set1_epi8(0x20));
+  const __m256i alpha = InRange(lower, 'a', 'f');
+  if (_mm256_movemask_epi8(_mm256_or_si256(digit, alpha)) != -1)
+    *valid = false;
+  return _mm256_or_si256(
+      _mm256_and_si256(digit, _mm256_sub_epi8(in, _mm256_set1_epi8('0'))),
+      _mm256_and_si256(alpha,
+                       _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10))));
+}
+
+SIMD_TARGET("sse4.1")
+size_t HexDecodeSSE41(char* dst, size_t dlen, const char* src, size_t slen) {
+  // Each 16-bit lane turns into (high nibble << 4) | low nibble.
+  const __m128i weights = _mm_set1_epi16(0x0110);
+  size_t k = 0;
+  while (k + 16 <= dlen && (k + 16) * 2 <= slen) {
+    const __m128i* in = reinterpret_cast<const __m128i*>(src + k * 2);
+    bool valid = true;
+    const __m128i first = UnhexSSE41(_mm_loadu_si128(in), &valid);
+    const __m128i second = UnhexSSE41(_mm_loadu_si128(in + 1), &valid);
+    if (!valid)
+      break;
+    const __m128i out = _mm_packus_epi16(_mm_maddubs_epi16(first, weights),
+                                         _mm_maddubs_epi16(second, weights));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k), out);
+    k += 16;
+  }
+  return k * 2;
+}
+
+SIMD_TARGET("avx2")
+size_t HexDecodeAVX2(char* dst, size_t dlen, const char* src, size_t slen) {
+  const __m256i weights = _mm256_set1_epi16(0x0110);
+  size_t k = 0;
+  while (k + 32 <= dlen && (k + 32) * 2 <= slen) {
+    const __m256i* in = reinterpret_cast<const __m256i*>(src + k * 2);
+    bool valid = true;
+    const __m256i first = UnhexAVX2(_mm256_loadu_si256(in), &valid);
+    const __m256i second = UnhexAVX2(_mm256_loadu_si256(in + 1), &valid);
+    if (!valid)
+      break;
+    // The pack works within lanes, so put the 64-bit halves back in order.
+    const __m256i packed =
+        _mm256_packus_epi16(_mm256_maddubs_epi16(first, weights),
+                            _mm256_maddubs_epi16(second, weights));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k),
+                        _mm256_permute4x64_epi64(packed, 0xd8));
+    k += 32;
+  }
+  return k * 2 + HexDecodeSSE41(dst + k, dlen - k, src + k * 2, slen - k * 2);
+}
+
+
+//// ASCII ////
+
+SIMD_TARGET("sse4.1")
+size_t AsciiPrefixSSE41(const char* src, size_t len) {
+  size_t i = 0;
+  while (i + 64 <= len) {
+    const __m128i* in = reinterpret_cast<const __m128i*>(src + i);
+    const __m128i any = _mm_or_si128(
+        _mm_or_si128(_mm_loadu_si128(in), _mm_loadu_si128(in + 1)),
+        _mm_or_si128(_mm_loadu_si128(in + 2), _mm_loadu_si128(in + 3)));
+    if (_mm_movemask_epi8(any) != 0)
+      break;
+    i += 64;
+  }
+  while (i + 16 <= len) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    if (_mm_movemask_epi8(in) != 0)
+      break;
+    i += 16;
+  }
+  return i;
+}
+
+SIMD_TARGET("avx2")
+size_t AsciiPrefixAVX2(const char* src, size_t len) {
+  size_t i = 0;
+  while (i + 128 <= len) {
+    const __m256i* in = reinterpret_cast<const __m256i*>(src + i);
+    const __m256i any = _mm256_or_si256(
+        _mm256_or_si256(_mm256_loadu_si256(in), _mm256_loadu_si256(in + 1)),
+        _mm256_or_si256(_mm256_loadu_si256(in + 2),
+                        _mm256_loadu_si256(in + 3)));
+    if (_mm256_movemask_epi8(any) != 0)
+      break;
+    i += 128;
+  }
+  return i + AsciiPrefixSSE41(src + i, len - i);
+}
+
+
+//// UTF-8 ////
+
+// The validation below follows "Validating UTF-8 In Less Than One Instruction
+// Per Byte" by John Keiser and Daniel Lemire.  Every pair of adjacent bytes
+// is classified through three 16-entry tables, indexed by the high and the
+// low nibble of the first byte and by the high nibble of the second.  Each
+// bit stands for one kind of error, and a bit that is set in all three
+// lookups means that the pair is invalid.  The one exception is kTwoConts,
+// which must be set exactly for the continuation bytes that are the third
+// or fourth byte of their character.
+enum : uint8_t {
+  kTooShort = 1 << 0,  // 11______ 0_______, 11______ 11______
+  kTooLong = 1 << 1,  // 0_______ 10______
+  kOverlong3 = 1 << 2,  // 11100000 100_____
+  kTooLarge = 1 << 3,  // 11110100 1001____ and larger
+  kSurrogate = 1 << 4,  // 11101101 101_____
+  kOverlong2 = 1 << 5,  // 1100000_ 10______
+  kTooLarge1000 = 1 << 6,  // 11110101 1000____ and larger
+  kOverlong4 = 1 << 6,  // 11110000 1000____
+  kTwoConts = 1 << 7,  // 10______ 10______
+  kCarry = kTooShort | kTooLong | kTwoConts
+};
+
+alignas(16) const uint8_t kUtf8Byte1High[16] = {
+  // 0_______ ________
+  kTooLong, kTooLong, kTooLong, kTooLong,
+  kTooLong, kTooLong, kTooLong, kTooLong,
+  // 10______ ________
+  kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+  // 1100____ ________
+  kTooShort | kOverlong2,
+  // 1101____ ________
+  kTooShort,
+  // 1110____ ________
+  kTooShort | kOverlong3 | kSurrogate,
+  // 1111____ ________
+  kTooShort | kTooLarge | kTooLarge1000 | kOverlong4
+};
+
+alignas(16) const uint8_t kUtf8Byte1Low[16] = {
+  // ____0000 ________
+  kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+  // ____0001 ________
+  kCarry | kOverlong2,
+  // ____001_ ________
+  kCarry,
+  kCarry,
+  // ____0100 ________
+  kCarry | kTooLarge,
+  // ____0101 ________ and up
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  // ____1101 ________
+  kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000
+};
+
+alignas(16) const uint8_t kUtf8Byte2High[16] = {
+  // ________ 0_______
+  kTooShort, kTooShort, kTooShort, kTooShort,
+  kTooShort, kTooShort, kTooShort, kTooShort,
+  // ________ 1000____
+  kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 | kOverlong4,
+  // ________ 1001____
+  kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+  // ________ 101_____
+  kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+  kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+  // ________ 11______
+  kTooShort, kTooShort, kTooShort, kTooShort
+};
+
+// Subtracting this from the last block leaves a non-zero byte if the block
+// ends in the middle of a character.
+alignas(32) const uint8_t kUtf8IncompleteMax[32] = {
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+  0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xdf, 0xbf
+};
+
+// Moves |len| back to the start of the character that it might cut off.
+size_t Utf8CharBoundary(const char* src, size_t len) {
+  size_t i = len;
+  while (i > 0 && len - i < 3 && (src[i - 1] & 0xc0) == 0x80)
+    i--;
+  if (i > 0 && (src[i - 1] & 0xc0) == 0xc0)
+    i--;
+  return i;
+}
+
+// Returns the error bits for the 16 bytes of |in|, given the 16 bytes
+// before them.
+SIMD_TARGET("sse4.1")
+inline __m128i Utf8ErrorsSSE41(__m128i in, __m128i prev) {
+  const __m128i nibble = _mm_set1_epi8(0x0f);
+  const __m128i prev1 = _mm_alignr_epi8(in, prev, 15);
+  const __m128i byte_1_high = _mm_shuffle_epi8(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(kUtf8Byte1High)),
+      _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+  const __m128i byte_1_low = _mm_shuffle_epi8(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(kUtf8Byte1Low)),
+      _mm_and_si128(prev1, nibble));
+  const __m128i byte_2_high = _mm_shuffle_epi8(
+      _mm_load_si128(reinterpret_cast<const __m128i*>(kUtf8Byte2High)),
+      _mm_and_si128(_mm_srli_epi16(in, 4), nibble));
+  const __m128i special =
+      _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+  // Only 111_____ and 1111____ end up >= 0x80, respectively.
+  const __m128i third =
+      _mm_subs_epu8(_mm_alignr_epi8(in, prev, 14), _mm_set1_epi8(0x60));
+  const __m128i fourth =
+      _mm_subs_epu8(_mm_alignr_epi8(in, prev, 13), _mm_set1_epi8(0x70));
+  const __m128i must_be_continuation =
+      _mm_and_si128(_mm_or_si128(third, fourth),
+                    _mm_set1_epi8(static_cast<char>(0x80)));
+  return _mm_xor_si128(must_be_continuation, special);
+}
+
+SIMD_TARGET("avx2")
+inline __m256i Utf8ErrorsAVX2(__m256i in, __m256i prev) {
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+  // The last bytes of |prev| in front of the first lane of |in|.
+  const __m256i shifted = _mm256_permute2x128_si256(prev, in, 0x21);
+  const __m256i prev1 = _mm256_alignr_epi8(in, shifted, 15);
+  const __m256i byte_1_high = _mm256_shuffle_epi8(
+      _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<const __m128i*>(kUtf8Byte1High))),
+      _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+  const __m256i byte_1_low = _mm256_shuffle_epi8(
+      _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<const __m128i*>(kUtf8Byte1Low))),
+      _mm256_and_si256(prev1, nibble));
+  const __m256i byte_2_high = _mm256_shuffle_epi8(
+      _mm256_broadcastsi128_si256(
+          _mm_load_si128(reinterpret_cast<const __m128i*>(kUtf8Byte2High))),
+      _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble));
+  const __m256i special = _mm256_and_si256(
+      _mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+  const __m256i third = _mm256_subs_epu8(_mm256_alignr_epi8(in, shifted, 14),
+                                         _mm256_set1_epi8(0x60));
+  const __m256i fourth = _mm256_subs_epu8(_mm256_alignr_epi8(in, shifted, 13),
+                                          _mm256_set1_epi8(0x70));
+  const __m256i must_be_continuation =
+      _mm256_and_si256(_mm256_or_si256(third, fourth),
+                       _mm256_set1_epi8(static_cast<char>(0x80)));
+  return _mm256_xor_si256(must_be_continuation, special);
+}
+
+SIMD_TARGET("sse4.1")
+size_t Utf8ValidPrefixSSE41(const char* src, size_t len) {
+  const __m128i incomplete_max = _mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(kUtf8IncompleteMax + 16));
+  __m128i prev = _mm_setzero_si128();
+  __m128i prev_incomplete = _mm_setzero_si128();
+  size_t i = 0;
+  while (i + 16 <= len) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i error;
+    if (_mm_movemask_epi8(in) == 0) {
+      // ASCII only, but the previous block must not have been cut short.
+      error = prev_incomplete;
+      prev_incomplete = _mm_setzero_si128();
+    } else {
+      error = Utf8ErrorsSSE41(in, prev);
+      prev_incomplete = _mm_subs_epu8(in, incomplete_max);
+    }
+    if (!_mm_testz_si128(error, error))
+      break;
+    prev = in;
+    i += 16;
+  }
+  return Utf8CharBoundary(src, i);
+}
+
+SIMD_TARGET("avx2")
+size_t Utf8ValidPrefixAVX2(const char* src, size_t len) {
+  const __m256i incomplete_max = _mm256_load_si256(
+      reinterpret_cast<const __m256i*>(kUtf8IncompleteMax));
+  __m256i prev = _mm256_setzero_si256();
+  __m256i prev_incomplete = _mm256_setzero_si256();
+  size_t i = 0;
+  while (i + 32 <= len) {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    __m256i error;
+    if (_mm256_movemask_epi8(in) == 0) {
+      error = prev_incomplete;
+      prev_incomplete = _mm256_setzero_si256();
+    } else {
+      error = Utf8ErrorsAVX2(in, prev);
+      prev_incomplete = _mm256_subs_epu8(in, incomplete_max);
+    }
+    if (!_mm256_testz_si256(error, error))
+      break;
+    prev = in;
+    i += 32;
+  }
+  i = Utf8CharBoundary(src, i);
+  return i + Utf8ValidPrefixSSE41(src + i, len - i);
+}
+
+
+typedef size_t (*ScanFn)(const char* src, size_t len);
+
+size_t ScanNone(const char* src, size_t len) {
+  return 0;
+}
+
+struct Kernels {
+  EncodeFn base64_encode;
+  DecodeFn base64_decode;
+  EncodeFn hex_encode;
+  DecodeFn hex_decode;
+  ScanFn ascii_prefix;
+  ScanFn utf8_valid_prefix;
+};
+
+const Kernels& GetKernels() {
+  static const Kernels kernels = []() -> Kernels {
+    switch (DetectSimdLevel()) {
+      case kAVX2:
+        return { Base64EncodeAVX2, Base64DecodeAVX2,
+                 HexEncodeAVX2, HexDecodeAVX2,
+                 AsciiPrefixAVX2, Utf8ValidPrefixAVX2 };
+      case kSSE41:
+        return { Base64EncodeSSE41, Base64DecodeSSE41,
+                 HexEncodeSSE41, HexDecodeSSE41,
+                 AsciiPrefixSSE41, Utf8ValidPrefixSSE41 };
+      default:
+        return { EncodeNone, DecodeNone, EncodeNone, DecodeNone,
+                 ScanNone, ScanNone };
+    }
+  }();
+  return kernels;
+}
+
+}  // anonymous namespace
+
+
+size_t base64_encode_simd(const char* src, size_t slen, char* dst) {
+  return GetKernels().base64_encode(src, slen, dst);
+}
+
+size_t base64_decode_simd(char* dst, size_t dlen,
+                          const char* src, size_t slen) {
+  return GetKernels().base64_decode(dst, dlen, src, slen);
+}
+
+size_t hex_encode_simd(const char* src, size_t slen, char* dst) {
+  return GetKernels().hex_encode(src, slen, dst);
+}
+
+size_t hex_decode_simd(char* dst, size_t dlen, const char* src, size_t slen) {
+  return GetKernels().hex_decode(dst, dlen, src, slen);
+}
+
+size_t ascii_prefix_simd(const char* src, size_t len) {
+  return GetKernels().ascii_prefix(src, len);
+}
+
+size_t utf8_valid_prefix_simd(const char* src, size_t len) {
+  return GetKernels().utf8_valid_prefix(src, len);
+}
+
+#else  // !NODE_SIMD_X86
+
+size_t base64_encode_simd(const char* src, size_t slen, char* dst) {
+  return 0;
+}
+
+size_t base64_decode_simd(char* dst, size_t dlen,
+                          const char* src, size_t slen) {
+  return 0;
+}
+
+size_t hex_encode_simd(const char* src, size_t slen, char* dst) {
+  return 0;
+}
+
+size_t hex_decode_simd(char* dst, size_t dlen, const char* src, size_t slen) {
+  return 0;
+}
+
+size_t ascii_prefix_simd(const char* src, size_t len) {
+  return 0;
+}
+
+size_t utf8_valid_prefix_simd(const char* src, size_t len) {
+  return 0;
+}
+
+#endif  // NODE_SIMD_X86
+
+}  // namespace node
@@ -0,0 +1,47 @@
+#ifndef SRC_STRING_BYTES_SIMD_H_
+#define SRC_STRING_BYTES_SIMD_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <stddef.h>
+
+namespace node {
+
+// Vectorized base64, hex, ASCII and UTF-8 kernels for x86, using AVX2 or
+// SSE4.1 depending on what the CPU supports.  The choice is made once, at
+// the first call.  On other CPUs and architectures they do nothing: they
+// report 0 bytes as handled.
+//
+// The base64 and hex functions convert the longest prefix of |src| that
+// they can handle in whole blocks and return the number of input bytes they
+// consumed.  The caller finishes the rest with the scalar code.  The
+// decoders stop in front of the first block that contains anything but the
+// regular or URL-safe alphabet (whitespace, padding, invalid characters),
+// and never write more than |dlen| bytes.
+
+// Consumes a multiple of 3 bytes and writes 4 characters for every 3.
+size_t base64_encode_simd(const char* src, size_t slen, char* dst);
+
+// Consumes a multiple of 4 characters and writes 3 bytes for every 4.
+size_t base64_decode_simd(char* dst, size_t dlen,
+                          const char* src, size_t slen);
+
+// Writes 2 characters for every byte consumed.
+size_t hex_encode_simd(const char* src, size_t slen, char* dst);
+
+// Consumes a multiple of 2 characters and writes 1 byte for every 2.
+size_t hex_decode_simd(char* dst, size_t dlen, const char* src, size_t slen);
+
+// Returns the length of a prefix of |src| that is all ASCII.  The byte after
+// it may be ASCII as well.
+size_t ascii_prefix_simd(const char* src, size_t len);
+
+// Returns the length of a prefix of |src| that is valid UTF-8 and ends on a
+// character boundary.  The rest of the input is not necessarily invalid.
+size_t utf8_valid_prefix_simd(const char* src, size_t len);
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_STRING_BYTES_SIMD_H_
@@ -30,6 +30,8 @@
 #include "node_internals.h"
 #include "stream_base-inl.h"
 
+#include <algorithm>
+
 namespace node {
 
 using crypto::SecureContext;
@@ -67,7 +69,8 @@ TLSWrap::TLSWrap(Environment* env,
       established_(false),
       shutdown_(false),
       cycle_depth_(0),
-      eof_(false) {
+      eof_(false),
+      read_allocator_(env) {
   node::Wrap(object(), this);
   MakeWeak(this);
 
@@ -221,8 +224,7 @@ void TLSWrap::Receive(const FunctionCallbackInfo<Value>& args) {
     wrap->stream_->EmitAlloc(len, &buf);
     size_t copy = buf.len > len ? len : buf.len;
     memcpy(buf.base, data, copy);
-    buf.len = copy;
-    wrap->stream_->EmitRead(buf.len, &buf);
+    wrap->stream_->EmitRead(copy, &buf);
 
     data += copy;
     len -= copy;
@@ -357,6 +359,9 @@ void TLSWrap::EncOutAfterWrite(WriteWrap* req_wrap, int status) {
   // Try writing more data
   write_size_ = 0;
   EncOut();
+
+  if (ssl_ != nullptr && write_size_ == 0)
+    crypto::NodeBIO::FromBIO(enc_out_)->TryShrink();
 }
 
 
@@ -417,34 +422,31 @@ void TLSWrap::ClearOut() {
 
   crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
 
-  char out[kClearOutChunkSize];
+  // Decrypt straight into the buffer that is handed to the reader instead
+  // of going through an intermediate copy.  Like libuv does when read()
+  // returns EAGAIN, an unused buffer is given back with an empty read.
   int read;
   for (;;) {
-    read = SSL_read(ssl_, out, sizeof(out));
-
-    if (read <= 0)
-      break;
-
-    char* current = out;
-    while (read > 0) {
-      int avail = read;
-
-      uv_buf_t buf;
-      EmitAlloc(avail, &buf);
-      if (static_cast<int>(buf.len) < avail)
-        avail = buf.len;
-      memcpy(buf.base, current, avail);
-      EmitRead(avail, &buf);
-
-      // Caveat emptor: OnRead() calls into JS land which can result in
-      // the SSL context object being destroyed.  We have to carefully
-      // check that ssl_ != nullptr afterwards.
+    uv_buf_t buf;
+    EmitAlloc(kClearOutChunkSize, &buf);
+    const size_t size =
+        std::min(buf.len, static_cast<size_t>(kClearOutChunkSize));
+    read = SSL_read(ssl_, buf.base, static_cast<int>(size));
+
+    if (read <= 0) {
+      EmitRead(0, &buf);
       if (ssl_ == nullptr)
         return;
-
-      read -= avail;
-      current += avail;
+      break;
     }
+
+    EmitRead(read, &buf);
+
+    // Caveat emptor: OnRead() calls into JS land which can result in
+    // the SSL context object being destroyed.  We have to carefully
+    // check that ssl_ != nullptr afterwards.
+    if (ssl_ == nullptr)
+      return;
   }
 
   int flags = SSL_get_shutdown(ssl_);
@@ -682,8 +684,8 @@ void TLSWrap::OnDestructImpl(void* ctx) {
 
 
 void TLSWrap::OnAllocSelf(size_t suggested_size, uv_buf_t* buf, void* ctx) {
-  buf->base = node::Malloc(suggested_size);
-  buf->len = suggested_size;
+  TLSWrap* wrap = static_cast<TLSWrap*>(ctx);
+  *buf = wrap->read_allocator_.Allocate(suggested_size);
 }
 
 
@@ -692,9 +694,17 @@ void TLSWrap::OnReadSelf(ssize_t nread,
                          uv_handle_type pending,
                          void* ctx) {
   TLSWrap* wrap = static_cast<TLSWrap*>(ctx);
+  SlabAllocator* allocator = &wrap->read_allocator_;
   Local<Object> buf_obj;
-  if (buf != nullptr)
-    buf_obj = Buffer::New(wrap->env(), buf->base, buf->len).ToLocalChecked();
+  if (nread <= 0) {
+    if (buf != nullptr)
+      allocator->Release(*buf);
+    if (nread == 0)
+      return;
+  } else {
+    CHECK_LE(static_cast<size_t>(nread), buf->len);
+    buf_obj = allocator->Shrink(*buf, nread).ToLocalChecked();
+  }
   wrap->EmitData(nread, buf_obj, Local<Object>());
 }
 
@@ -737,6 +747,11 @@ void TLSWrap::DoRead(ssize_t nread,
 
   // Cycle OpenSSL's state
   Cycle();
+
+  // Caveat emptor: Cycle() can call into JS land, which may destroy the SSL
+  // context object along with its BIOs.
+  if (ssl_ != nullptr)
+    enc_in->TryShrink();
 }
 
 
@@ -817,6 +832,21 @@ void TLSWrap::DestroySSL(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Returns the number of bytes held by the connection's BIOs.
+void TLSWrap::GetBIOMemoryUsage(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+  if (wrap->ssl_ == nullptr)
+    return args.GetReturnValue().Set(0);
+
+  const size_t allocated =
+      crypto::NodeBIO::FromBIO(wrap->enc_in_)->Allocated() +
+      crypto::NodeBIO::FromBIO(wrap->enc_out_)->Allocated();
+  args.GetReturnValue().Set(static_cast<double>(allocated));
+}
+
+
 void TLSWrap::EnableCertCb(const FunctionCallbackInfo<Value>& args) {
   TLSWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
@@ -960,6 +990,7 @@ void TLSWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "enableSessionCallbacks", EnableSessionCallbacks);
   env->SetProtoMethod(t, "destroySSL", DestroySSL);
   env->SetProtoMethod(t, "enableCertCb", EnableCertCb);
+  env->SetProtoMethod(t, "getBIOMemoryUsage", GetBIOMemoryUsage);
 
   StreamBase::AddMethods<TLSWrap>(env, t, StreamBase::kFlagHasWritev);
   SSLWrap<TLSWrap>::AddMethods(env, t);
@@ -29,6 +29,7 @@
 
 #include "async_wrap.h"
 #include "env.h"
+#include "slab_allocator.h"
 #include "stream_wrap.h"
 #include "util.h"
 #include "v8.h"
@@ -146,6 +147,8 @@ class TLSWrap : public AsyncWrap,
   static void EnableCertCb(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void DestroySSL(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetBIOMemoryUsage(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
 
 #ifdef SSL_CTRL_SET_TLSEXT_SERVERNAME_CB
   static void GetServername(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -171,6 +174,9 @@ class TLSWrap : public AsyncWrap,
   // after the `UV_EOF` on socket.
   bool eof_;
 
+  // Cleartext is decrypted straight into buffers from here.
+  SlabAllocator read_allocator_;
+
  private:
   static void GetWriteQueueSize(
       const v8::FunctionCallbackInfo<v8::Value>& info);
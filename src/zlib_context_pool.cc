@@ -0,0 +1,91 @@
+#include "zlib_context_pool.h"
+#include "env-inl.h"
+#include "util-inl.h"
+
+#include "zlib.h"
+
+namespace node {
+
+static inline bool KeysEqual(const ZlibContextPool::Key& a,
+                             const ZlibContextPool::Key& b) {
+  if (a.deflate != b.deflate || a.window_bits != b.window_bits)
+    return false;
+  if (!a.deflate)
+    return true;
+  return a.level == b.level &&
+         a.mem_level == b.mem_level &&
+         a.strategy == b.strategy;
+}
+
+
+ZlibContextPool::ZlibContextPool(Environment* env)
+    : stats_buffer(env->isolate(), IDX_ZLIB_POOL_STATS_COUNT),
+      env_(env) {
+}
+
+
+ZlibContextPool::~ZlibContextPool() {
+  for (const Entry& entry : idle_)
+    Destroy(entry);
+}
+
+
+void ZlibContextPool::Destroy(const Entry& entry) {
+  if (entry.key.deflate)
+    deflateEnd(entry.strm);
+  else
+    inflateEnd(entry.strm);
+  delete entry.strm;
+}
+
+
+z_stream* ZlibContextPool::Acquire(const Key& key) {
+  // Prefer the most recently released context, its memory is more likely
+  // to still be cached.
+  for (size_t i = idle_.size(); i > 0; i--) {
+    if (!KeysEqual(idle_[i - 1].key, key))
+      continue;
+    z_stream* strm = idle_[i - 1].strm;
+    idle_.erase(idle_.begin() + (i - 1));
+    stats_buffer[IDX_ZLIB_POOL_STATS_IDLE] = idle_.size();
+    stats_buffer[IDX_ZLIB_POOL_STATS_HITS] += 1;
+    return strm;
+  }
+  stats_buffer[IDX_ZLIB_POOL_STATS_MISSES] += 1;
+  return nullptr;
+}
+
+
+bool ZlibContextPool::Release(const Key& key,
+                              z_stream* strm,
+                              int64_t external_size) {
+  if (idle_.size() >= max_size_)
+    return false;
+
+  const int err = key.deflate ? deflateReset(strm) : inflateReset(strm);
+  if (err != Z_OK)
+    return false;
+  strm->msg = nullptr;
+
+  idle_.push_back(Entry { key, strm, external_size });
+  stats_buffer[IDX_ZLIB_POOL_STATS_IDLE] = idle_.size();
+  return true;
+}
+
+
+void ZlibContextPool::set_max_size(size_t max_size) {
+  max_size_ = max_size;
+  if (idle_.size() <= max_size_)
+    return;
+
+  int64_t freed = 0;
+  for (size_t i = max_size_; i < idle_.size(); i++) {
+    freed += idle_[i].external_size;
+    Destroy(idle_[i]);
+  }
+  idle_.resize(max_size_);
+  stats_buffer[IDX_ZLIB_POOL_STATS_IDLE] = idle_.size();
+  env_->isolate()->AdjustAmountOfExternalAllocatedMemory(-freed);
+}
+
+}  // namespace node
@@ -0,0 +1,81 @@
+#ifndef SRC_ZLIB_CONTEXT_POOL_H_
+#define SRC_ZLIB_CONTEXT_POOL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "aliased_buffer.h"
+#include "v8.h"
+
+#include <vector>
+
+struct z_stream_s;
+
+namespace node {
+
+class Environment;
+
+enum ZlibContextPoolStatsIndex {
+  IDX_ZLIB_POOL_STATS_IDLE,     // Contexts currently held by the pool.
+  IDX_ZLIB_POOL_STATS_HITS,     // Streams that reused a pooled context.
+  IDX_ZLIB_POOL_STATS_MISSES,   // Streams that had to allocate a new one.
+  IDX_ZLIB_POOL_STATS_COUNT
+};
+
+// Keeps a bounded number of idle, already initialized zlib contexts around
+// so that streams which are created and closed in quick succession, like
+// the per-response compression of an HTTP server, reuse them after a
+// deflateReset()/inflateReset() instead of paying for deflateInit2() and
+// deflateEnd() (and the matching external memory updates) every time.
+//
+// A context can only be handed to a stream with exactly the parameters it
+// was created with.  The contexts are heap allocated because zlib's
+// internal state points back at the z_stream that owns it.
+class ZlibContextPool {
+ public:
+  static const size_t kDefaultMaxSize = 8;
+
+  struct Key {
+    bool deflate;
+    int window_bits;   // As passed to deflateInit2()/inflateInit2().
+    int level;         // The remaining fields are only used for deflate.
+    int mem_level;
+    int strategy;
+  };
+
+  explicit ZlibContextPool(Environment* env);
+  ~ZlibContextPool();
+
+  // Returns a reset context matching |key|, or nullptr if there is none.
+  z_stream_s* Acquire(const Key& key);
+
+  // Takes ownership of |strm| if there is room left, and resets it.  Returns
+  // false if the caller still has to end and free it.  |external_size| is
+  // the amount of memory that was reported to V8 for the context.
+  bool Release(const Key& key, z_stream_s* strm, int64_t external_size);
+
+  size_t max_size() const { return max_size_; }
+  void set_max_size(size_t max_size);
+
+  AliasedBuffer<double, v8::Float64Array> stats_buffer;
+
+ private:
+  struct Entry {
+    Key key;
+    z_stream_s* strm;
+    int64_t external_size;
+  };
+
+  static void Destroy(const Entry& entry);
+
+  Environment* const env_;
+  std::vector<Entry> idle_;
+  size_t max_size_ = kDefaultMaxSize;
+
+  DISALLOW_COPY_AND_ASSIGN(ZlibContextPool);
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_ZLIB_CONTEXT_POOL_H_
@@ -0,0 +1,45 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const tick = require('./tick');
+const initHooks = require('./init-hooks');
+const { checkInvocations } = require('./hook-checks');
+const crypto = require('crypto');
+
+
+const hooks = initHooks();
+
+hooks.enable();
+
+const cipher = crypto.createCipheriv('aes-128-cbc', Buffer.alloc(16),
+                                     Buffer.alloc(16),
+                                     { threadpoolThreshold: 0 });
+cipher.write(Buffer.alloc(32), common.mustCall(onwrite));
+cipher.resume();
+
+function onwrite() {
+  const as = hooks.activitiesOfTypes('CIPHERREQUEST');
+  const a = as[0];
+  checkInvocations(a, { init: 1, before: 1 }, 'while in onwrite callback');
+  tick(2);
+}
+
+process.on('exit', onexit);
+function onexit() {
+  hooks.disable();
+  hooks.sanityCheck('CIPHERREQUEST');
+
+  const as = hooks.activitiesOfTypes('CIPHERREQUEST');
+  assert.strictEqual(as.length, 1);
+
+  const a = as[0];
+  assert.strictEqual(a.type, 'CIPHERREQUEST');
+  assert.strictEqual(typeof a.uid, 'number');
+  assert.strictEqual(a.triggerAsyncId, 1);
+  checkInvocations(a, { init: 1, before: 1, after: 1, destroy: 1 },
+                   'when process exits');
+}
@@ -0,0 +1,41 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const tick = require('./tick');
+const initHooks = require('./init-hooks');
+const { checkInvocations } = require('./hook-checks');
+const crypto = require('crypto');
+
+
+const hooks = initHooks();
+
+hooks.enable();
+
+crypto.hashBatch('sha256', ['a', 'b'], common.mustCall(onhashbatch));
+
+function onhashbatch() {
+  const as = hooks.activitiesOfTypes('HASHREQUEST');
+  const a = as[0];
+  checkInvocations(a, { init: 1, before: 1 }, 'while in onhashbatch callback');
+  tick(2);
+}
+
+process.on('exit', onexit);
+function onexit() {
+  hooks.disable();
+  hooks.sanityCheck('HASHREQUEST');
+
+  const as = hooks.activitiesOfTypes('HASHREQUEST');
+  assert.strictEqual(as.length, 1);
+
+  const a = as[0];
+  assert.strictEqual(a.type, 'HASHREQUEST');
+  assert.strictEqual(typeof a.uid, 'number');
+  assert.strictEqual(a.triggerAsyncId, 1);
+  checkInvocations(a, { init: 1, before: 1, after: 1, destroy: 1 },
+                   'when process exits');
+}
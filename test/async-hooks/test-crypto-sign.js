@@ -0,0 +1,63 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const tick = require('./tick');
+const initHooks = require('./init-hooks');
+const { checkInvocations } = require('./hook-checks');
+const crypto = require('crypto');
+const fixtures = require('../common/fixtures');
+
+const privateKey = crypto.createPrivateKey(
+  fixtures.readKey('rsa_private_1024.pem'));
+const publicKey = crypto.createPublicKey(
+  fixtures.readKey('rsa_public_1024.pem'));
+
+const hooks = initHooks();
+
+hooks.enable();
+
+crypto.sign('sha256', 'a', privateKey, common.mustCall(onsign));
+
+function onsign(err, signature) {
+  assert.ifError(err);
+  const as = hooks.activitiesOfTypes('SIGNREQUEST');
+  const a = as[0];
+  checkInvocations(a, { init: 1, before: 1 }, 'while in onsign callback');
+  crypto.verifyBatch('sha256', publicKey, ['a', 'b'], [signature, signature],
+                     common.mustCall(onverify));
+  tick(2);
+}
+
+function onverify(err, results) {
+  assert.ifError(err);
+  assert.deepStrictEqual(results, [true, false]);
+  const as = hooks.activitiesOfTypes('VERIFYREQUEST');
+  assert.strictEqual(as.length, 1);
+  checkInvocations(as[0], { init: 1, before: 1 },
+                   'while in onverify callback');
+  tick(2);
+}
+
+process.on('exit', onexit);
+function onexit() {
+  hooks.disable();
+  hooks.sanityCheck('SIGNREQUEST');
+  hooks.sanityCheck('VERIFYREQUEST');
+
+  const as = hooks.activitiesOfTypes(['SIGNREQUEST', 'VERIFYREQUEST']);
+  assert.strictEqual(as.length, 2);
+  assert.strictEqual(as[0].type, 'SIGNREQUEST');
+  assert.strictEqual(as[1].type, 'VERIFYREQUEST');
+
+  for (const a of as) {
+    assert.strictEqual(typeof a.uid, 'number');
+    checkInvocations(a, { init: 1, before: 1, after: 1, destroy: 1 },
+                     'when process exits');
+  }
+  assert.strictEqual(as[0].triggerAsyncId, 1);
+  assert.strictEqual(as[1].triggerAsyncId, as[0].uid);
+}
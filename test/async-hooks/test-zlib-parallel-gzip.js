@@ -0,0 +1,33 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const initHooks = require('./init-hooks');
+const { checkInvocations } = require('./hook-checks');
+const zlib = require('zlib');
+
+const hooks = initHooks();
+
+hooks.enable();
+
+// A single block, so exactly one request is made.
+const gz = zlib.createGzip({ parallel: 2 });
+gz.resume();
+gz.on('end', common.mustCall());
+gz.end('hello parallel world');
+
+process.on('exit', onexit);
+function onexit() {
+  hooks.disable();
+  hooks.sanityCheck('DEFLATEBLOCKREQUEST');
+
+  const as = hooks.activitiesOfTypes('DEFLATEBLOCKREQUEST');
+  assert.strictEqual(as.length, 1);
+
+  const a = as[0];
+  assert.strictEqual(a.type, 'DEFLATEBLOCKREQUEST');
+  assert.strictEqual(typeof a.uid, 'number');
+  assert.strictEqual(typeof a.triggerAsyncId, 'number');
+  checkInvocations(a, { init: 1, before: 1, after: 1, destroy: 1 },
+                   'when process exits');
+}
@@ -15,6 +15,7 @@ runBenchmark('crypto',
                'n=1',
                'algo=sha256',
                'api=stream',
+               'batch=1',
                'keylen=1024',
                'len=1',
                'out=buffer',
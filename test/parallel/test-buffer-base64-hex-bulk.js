@@ -0,0 +1,86 @@
+'use strict';
+
+// Long base64 and hex input is converted in blocks by vectorized code, with
+// the scalar code handling the rest. Check the results against a plain JS
+// implementation for lengths around the block sizes, with both base64
+// alphabets, and with characters that make the block code stop early.
+require('../common');
+const assert = require('assert');
+
+const alphabet =
+  'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/';
+
+function toBase64(buf) {
+  let out = '';
+  for (let i = 0; i < buf.length; i += 3) {
+    const n = buf[i] << 16 | buf[i + 1] << 8 | buf[i + 2];
+    out += alphabet[n >> 18 & 63] + alphabet[n >> 12 & 63];
+    out += i + 1 < buf.length ? alphabet[n >> 6 & 63] : '=';
+    out += i + 2 < buf.length ? alphabet[n & 63] : '=';
+  }
+  return out;
+}
+
+function toHex(buf) {
+  let out = '';
+  for (const byte of buf)
+    out += (byte < 16 ? '0' : '') + byte.toString(16);
+  return out;
+}
+
+let seed = 1;
+function random() {
+  seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+  return seed >> 8;
+}
+
+for (let length = 0; length < 200; length++) {
+  const buf = Buffer.alloc(length);
+  for (let i = 0; i < length; i++)
+    buf[i] = random() & 0xff;
+
+  const base64 = toBase64(buf);
+  assert.strictEqual(buf.toString('base64'), base64);
+  assert.deepStrictEqual(Buffer.from(base64, 'base64'), buf);
+
+  const urlSafe = base64.replace(/\+/g, '-').replace(/\//g, '_')
+                        .replace(/=+$/, '');
+  assert.deepStrictEqual(Buffer.from(urlSafe, 'base64'), buf);
+
+  // Whitespace and other characters outside of the alphabet are skipped.
+  const position = random() % (base64.length + 1);
+  for (const junk of ['\n', ' ', '*', 'é', '☃']) {
+    const dirty = base64.slice(0, position) + junk + base64.slice(position);
+    assert.deepStrictEqual(Buffer.from(dirty, 'base64'), buf);
+  }
+
+  // Decoding stops at padding in the middle of the input.
+  const stop = Math.floor(position / 4) * 4;
+  const padded = base64.slice(0, stop) + '====' + base64.slice(stop);
+  assert.deepStrictEqual(Buffer.from(padded, 'base64'),
+                         buf.slice(0, stop / 4 * 3));
+
+  const hex = toHex(buf);
+  assert.strictEqual(buf.toString('hex'), hex);
+  assert.deepStrictEqual(Buffer.from(hex, 'hex'), buf);
+  assert.deepStrictEqual(Buffer.from(hex.toUpperCase(), 'hex'), buf);
+
+  // Hex decoding stops at the first pair that is not valid.
+  for (const junk of length > 0 ? ['g', 'G', ':', '@', '`', '/', 'é'] : []) {
+    const i = random() % hex.length;
+    const invalid = hex.slice(0, i) + junk + hex.slice(i + 1);
+    assert.deepStrictEqual(Buffer.from(invalid, 'hex'),
+                           buf.slice(0, Math.floor(i / 2)));
+  }
+
+  // Writing into a smaller buffer does not touch the bytes after it.
+  const target = Buffer.alloc(length + 8, 0xaa);
+  const half = length >> 1;
+  assert.strictEqual(target.write(base64, 0, half, 'base64'), half);
+  assert.deepStrictEqual(target.slice(0, half), buf.slice(0, half));
+  assert.ok(target.slice(half).every((byte) => byte === 0xaa));
+  target.fill(0xaa);
+  assert.strictEqual(target.write(hex, 0, half, 'hex'), half);
+  assert.deepStrictEqual(target.slice(0, half), buf.slice(0, half));
+  assert.ok(target.slice(half).every((byte) => byte === 0xaa));
+}
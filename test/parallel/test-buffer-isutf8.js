@@ -0,0 +1,76 @@
+/*global SharedArrayBuffer*/
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { isUtf8 } = require('buffer');
+
+const valid = [
+  '',
+  'hello world',
+  'x'.repeat(1000),
+  'Ünïcödé',
+  '€'.repeat(100),
+  '\u{1F600}'.repeat(50),
+  '\u{10FFFF}',
+  '\u{FFFF}\u0080߿ࠀ퟿'
+];
+
+for (const str of valid) {
+  const buf = Buffer.from(str);
+  assert.strictEqual(isUtf8(buf), true, str);
+  // Also at any offset into a larger block of ASCII.
+  for (let i = 0; i < 40; i++) {
+    const padded = Buffer.concat([Buffer.alloc(i, 'a'), buf,
+                                  Buffer.alloc(40 - i, 'b')]);
+    assert.strictEqual(isUtf8(padded), true, str);
+  }
+}
+
+const invalid = [
+  [0x80],  // Continuation byte without a lead byte.
+  [0xbf],
+  [0xc2],  // Truncated sequences.
+  [0xe2, 0x82],
+  [0xf0, 0x9f, 0x98],
+  [0xc0, 0x80],  // Overlong forms.
+  [0xc1, 0xbf],
+  [0xe0, 0x9f, 0xbf],
+  [0xf0, 0x8f, 0xbf, 0xbf],
+  [0xed, 0xa0, 0x80],  // Surrogates.
+  [0xed, 0xbf, 0xbf],
+  [0xf4, 0x90, 0x80, 0x80],  // Past U+10FFFF.
+  [0xf5, 0x80, 0x80, 0x80],
+  [0xff],
+  [0xe2, 0x41, 0xac],  // ASCII in the middle of a sequence.
+  [0xe2, 0x82, 0xac, 0xac]  // One continuation byte too many.
+];
+
+for (const bytes of invalid) {
+  assert.strictEqual(isUtf8(Buffer.from(bytes)), false, bytes);
+  for (let i = 0; i < 70; i += 3) {
+    const padded = Buffer.concat([Buffer.alloc(i, 'a'), Buffer.from(bytes),
+                                  Buffer.alloc(70 - i, 'b')]);
+    assert.strictEqual(isUtf8(padded), false, bytes);
+    // The invalid bytes are the last ones.
+    const end = Buffer.concat([Buffer.from('€'.repeat(i)), Buffer.from(bytes)]);
+    assert.strictEqual(isUtf8(end), false, bytes);
+  }
+}
+
+// Other kinds of input, respecting offset and length of views.
+const bytes = Buffer.from('a€b');
+const ab = new ArrayBuffer(bytes.length);
+new Uint8Array(ab).set(bytes);
+assert.strictEqual(isUtf8(ab), true);
+assert.strictEqual(isUtf8(new Uint8Array(ab, 0, 2)), false);
+assert.strictEqual(isUtf8(new DataView(ab, 1, 3)), true);
+assert.strictEqual(isUtf8(new Uint16Array(4)), true);
+assert.strictEqual(isUtf8(new SharedArrayBuffer(8)), true);
+
+for (const input of [undefined, null, 'string', 1, {}, []]) {
+  common.expectsError(() => isUtf8(input), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError
+  });
+}
@@ -35,3 +35,15 @@ for (let i = 1; i < 10; i++) {
   assert.ok(!Buffer.isEncoding(encoding));
   assert.throws(() => Buffer.from('foo').toString(encoding), error);
 }
+
+// utf8 input that is all ASCII, long enough to become an external string,
+// and with a non-ASCII character at or around the end of a scanned block
+{
+  const ascii = 'x'.repeat(1024 * 1024);
+  assert.strictEqual(Buffer.from(ascii).toString(), ascii);
+  for (let i = 0; i < 70; i++) {
+    const str = `${'a'.repeat(i)}é${'b'.repeat(70 - i)}`;
+    assert.strictEqual(Buffer.from(str).toString(), str);
+    assert.strictEqual(Buffer.from(str).toString('utf8', 0, i), 'a'.repeat(i));
+  }
+}
@@ -0,0 +1,152 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+function reference(algorithm, data, encoding) {
+  return crypto.createHash(algorithm).update(data).digest(encoding);
+}
+
+const inputs = [
+  '',
+  'abc',
+  'Ünïcödé ☃',
+  'lone \ud83d surrogate',
+  Buffer.alloc(0),
+  Buffer.from('hello world'),
+  Buffer.alloc(100000, 'x'),
+  new Uint16Array([1, 2, 3, 4]),
+  new DataView(new ArrayBuffer(17))
+];
+
+// crypto.hash() returns the same digests as createHash().
+for (const algorithm of ['md5', 'sha1', 'sha256', 'sha512']) {
+  for (const data of inputs) {
+    assert.strictEqual(crypto.hash(algorithm, data),
+                       reference(algorithm, data, 'hex'));
+    for (const encoding of ['hex', 'base64', 'latin1']) {
+      assert.strictEqual(crypto.hash(algorithm, data, encoding),
+                         reference(algorithm, data, encoding));
+    }
+    const buf = crypto.hash(algorithm, data, 'buffer');
+    assert.ok(Buffer.isBuffer(buf));
+    assert.deepStrictEqual(buf, reference(algorithm, data, 'buffer'));
+  }
+}
+
+// The batch variant packs the digests back to back.
+function checkBatch(algorithm, batch, digests) {
+  assert.ok(Buffer.isBuffer(digests));
+  const size = reference(algorithm, '').length;
+  assert.strictEqual(digests.length, batch.length * size);
+  batch.forEach((data, i) => {
+    assert.deepStrictEqual(digests.slice(i * size, (i + 1) * size),
+                           reference(algorithm, data),
+                           `${algorithm} input ${i}`);
+  });
+}
+
+for (const algorithm of ['md5', 'sha256']) {
+  checkBatch(algorithm, inputs, crypto.hashBatch(algorithm, inputs));
+  checkBatch(algorithm, [], crypto.hashBatch(algorithm, []));
+  crypto.hashBatch(algorithm, inputs, common.mustCall((err, digests) => {
+    assert.ifError(err);
+    checkBatch(algorithm, inputs, digests);
+  }));
+}
+
+// Large batches are split up between several threads.
+{
+  const many = [];
+  for (let i = 0; i < 20000; i++)
+    many.push(i % 3 === 0 ? `key-${i}` : Buffer.alloc(i % 97, i));
+  const expected = crypto.hashBatch('sha1', many);
+  checkBatch('sha1', many, expected);
+  crypto.hashBatch('sha1', many, common.mustCall((err, digests) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(digests, expected);
+  }));
+  crypto.hashBatch('sha1', [], common.mustCall((err, digests) => {
+    assert.ifError(err);
+    assert.strictEqual(digests.length, 0);
+  }));
+}
+
+// Invalid arguments.
+common.expectsError(
+  () => crypto.hash('sha256', 'x', 'ucs2'),
+  {
+    code: 'ERR_CRYPTO_HASH_DIGEST_NO_UTF16',
+    type: Error
+  });
+
+common.expectsError(
+  () => crypto.hash('not-a-digest', 'x'),
+  {
+    code: 'ERR_CRYPTO_INVALID_DIGEST',
+    type: TypeError,
+    message: 'Invalid digest: not-a-digest'
+  });
+
+common.expectsError(
+  () => crypto.hashBatch('not-a-digest', ['x']),
+  {
+    code: 'ERR_CRYPTO_INVALID_DIGEST',
+    type: TypeError,
+    message: 'Invalid digest: not-a-digest'
+  });
+
+for (const algorithm of [undefined, 1, null]) {
+  common.expectsError(
+    () => crypto.hash(algorithm, 'x'),
+    {
+      code: 'ERR_INVALID_ARG_TYPE',
+      type: TypeError,
+      message: 'The "algorithm" argument must be of type string'
+    });
+  common.expectsError(
+    () => crypto.hashBatch(algorithm, ['x']),
+    {
+      code: 'ERR_INVALID_ARG_TYPE',
+      type: TypeError,
+      message: 'The "algorithm" argument must be of type string'
+    });
+}
+
+for (const data of [undefined, 1, {}, []]) {
+  common.expectsError(
+    () => crypto.hash('sha256', data),
+    {
+      code: 'ERR_INVALID_ARG_TYPE',
+      type: TypeError,
+      message: 'The "data" argument must be one of type string, ' +
+               'TypedArray, or DataView'
+    });
+}
+
+common.expectsError(
+  () => crypto.hashBatch('sha256', 'x'),
+  {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError,
+    message: 'The "inputs" argument must be of type Array'
+  });
+
+common.expectsError(
+  () => crypto.hashBatch('sha256', ['x', 1]),
+  {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError,
+    message: 'The "inputs[1]" argument must be one of type string, ' +
+             'TypedArray, or DataView'
+  });
+
+common.expectsError(
+  () => crypto.hashBatch('sha256', ['x'], 'not a function'),
+  {
+    code: 'ERR_INVALID_CALLBACK',
+    type: TypeError
+  });
@@ -0,0 +1,258 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+const fixtures = require('../common/fixtures');
+
+const privatePem = fixtures.readKey('rsa_private_1024.pem');
+const publicPem = fixtures.readKey('rsa_public_1024.pem');
+const dsaPrivatePem = fixtures.readKey('dsa_private_1025.pem');
+const dsaPublicPem = fixtures.readKey('dsa_public_1025.pem');
+const certPem = fixtures.readSync('test_cert.pem', 'ascii');
+const certKeyPem = fixtures.readSync('test_key.pem', 'ascii');
+
+const privateKey = crypto.createPrivateKey(privatePem);
+const publicKey = crypto.createPublicKey(publicPem);
+
+const messages = ['', 'abc', 'Ünïcödé ☃', Buffer.alloc(100000, 'x'),
+                  new Uint8Array([1, 2, 3]), new DataView(new ArrayBuffer(5))];
+
+function reference(algorithm, data, key) {
+  return crypto.createSign(algorithm).update(data).sign(key);
+}
+
+// Key objects.
+{
+  assert.ok(privateKey instanceof crypto.KeyObject);
+  assert.ok(publicKey instanceof crypto.KeyObject);
+  assert.strictEqual(privateKey.type, 'private');
+  assert.strictEqual(publicKey.type, 'public');
+  assert.strictEqual(crypto.createPublicKey(certPem).type, 'public');
+  assert.strictEqual(
+    crypto.createPrivateKey(Buffer.from(privatePem)).type, 'private');
+}
+
+// RSA PKCS#1 v1.5 signatures are deterministic, so they can be compared with
+// those of a Sign object.
+for (const algorithm of ['sha1', 'sha256', 'RSA-SHA512']) {
+  for (const data of messages) {
+    const expected = reference(algorithm, data, privatePem);
+    assert.deepStrictEqual(crypto.sign(algorithm, data, privateKey), expected);
+    assert.deepStrictEqual(crypto.sign(algorithm, data, privatePem), expected);
+    assert.deepStrictEqual(reference(algorithm, data, privateKey), expected);
+
+    assert.strictEqual(
+      crypto.verify(algorithm, data, publicKey, expected), true);
+    assert.strictEqual(
+      crypto.verify(algorithm, data, publicPem, expected), true);
+    assert.strictEqual(
+      crypto.verify(algorithm, data, privateKey, expected), true);
+    assert.strictEqual(
+      crypto.createVerify(algorithm).update(data).verify(publicKey, expected),
+      true);
+    assert.strictEqual(
+      crypto.verify(algorithm, 'other data', publicKey, expected), false);
+
+    crypto.sign(algorithm, data, privateKey, common.mustCall((err, sig) => {
+      assert.ifError(err);
+      assert.deepStrictEqual(sig, expected);
+    }));
+    crypto.verify(algorithm, data, publicKey, expected,
+                  common.mustCall((err, result) => {
+                    assert.ifError(err);
+                    assert.strictEqual(result, true);
+                  }));
+  }
+}
+
+// RSA-PSS, DSA and certificates.
+{
+  const options = {
+    key: privateKey,
+    padding: crypto.constants.RSA_PKCS1_PSS_PADDING,
+    saltLength: 20
+  };
+  const sig = crypto.sign('sha256', 'pss', options);
+  assert.strictEqual(crypto.verify('sha256', 'pss', {
+    key: publicPem,
+    padding: crypto.constants.RSA_PKCS1_PSS_PADDING,
+    saltLength: 20
+  }, sig), true);
+  assert.strictEqual(crypto.verify('sha256', 'pss', publicKey, sig), false);
+  crypto.sign('sha256', 'pss', options, common.mustCall((err, sig) => {
+    assert.ifError(err);
+    assert.strictEqual(
+      crypto.createVerify('sha256').update('pss').verify({
+        key: publicKey,
+        padding: crypto.constants.RSA_PKCS1_PSS_PADDING,
+        saltLength: 20
+      }, sig),
+      true);
+  }));
+
+  const dsaKey = crypto.createPrivateKey(dsaPrivatePem);
+  const dsaSig = crypto.sign('dss1', 'dsa', dsaKey);
+  assert.strictEqual(
+    crypto.verify('dss1', 'dsa', crypto.createPublicKey(dsaPublicPem), dsaSig),
+    true);
+  assert.strictEqual(
+    crypto.createVerify('dss1').update('dsa').verify(dsaPublicPem, dsaSig),
+    true);
+
+  const certSig = crypto.sign('sha256', 'cert', certKeyPem);
+  assert.strictEqual(crypto.verify('sha256', 'cert', certPem, certSig), true);
+}
+
+// Batches.
+{
+  const data = [];
+  const signatures = [];
+  for (let i = 0; i < 50; i++) {
+    data.push(i % 2 ? `message ${i}` : Buffer.from(`message ${i}`));
+    signatures.push(crypto.sign('sha256', `message ${i}`, privateKey));
+  }
+  // Break a few of them.
+  signatures[3] = signatures[4];
+  signatures[10] = Buffer.alloc(0);
+  signatures[17] = Buffer.from(signatures[17]);
+  signatures[17][0] ^= 1;
+  const expected = data.map((_, i) => i !== 3 && i !== 10 && i !== 17);
+
+  assert.deepStrictEqual(
+    crypto.verifyBatch('sha256', publicKey, data, signatures), expected);
+  assert.deepStrictEqual(crypto.verifyBatch('sha256', publicKey, [], []), []);
+  crypto.verifyBatch('sha256', publicKey, data, signatures,
+                     common.mustCall((err, results) => {
+                       assert.ifError(err);
+                       assert.deepStrictEqual(results, expected);
+                     }));
+  crypto.verifyBatch('sha256', publicPem, data.slice(0, 3),
+                     signatures.slice(0, 3),
+                     common.mustCall((err, results) => {
+                       assert.ifError(err);
+                       assert.deepStrictEqual(results, [true, true, true]);
+                     }));
+  crypto.verifyBatch('sha256', publicKey, [], [],
+                     common.mustCall((err, results) => {
+                       assert.ifError(err);
+                       assert.deepStrictEqual(results, []);
+                     }));
+
+  // The arrays can be emptied while the signatures are being verified.
+  const dataCopy = data.slice();
+  const signaturesCopy = signatures.slice();
+  crypto.verifyBatch('sha256', publicKey, dataCopy, signaturesCopy,
+                     common.mustCall((err, results) => {
+                       assert.ifError(err);
+                       assert.deepStrictEqual(results, expected);
+                     }));
+  dataCopy.length = 0;
+  signaturesCopy.fill(null);
+}
+
+// Invalid arguments.
+common.expectsError(
+  () => crypto.sign('sha256', 'x', publicKey),
+  {
+    code: 'ERR_CRYPTO_INVALID_KEY_OBJECT_TYPE',
+    type: TypeError,
+    message: 'Invalid key object type public, expected private.'
+  });
+
+common.expectsError(
+  () => crypto.createSign('sha256').update('x').sign(publicKey),
+  {
+    code: 'ERR_CRYPTO_INVALID_KEY_OBJECT_TYPE',
+    type: TypeError
+  });
+
+common.expectsError(
+  () => crypto.sign('not-a-digest', 'x', privateKey),
+  {
+    code: 'ERR_CRYPTO_INVALID_DIGEST',
+    type: TypeError,
+    message: 'Invalid digest: not-a-digest'
+  });
+
+common.expectsError(
+  () => crypto.verify('not-a-digest', 'x', publicKey, Buffer.alloc(1)),
+  {
+    code: 'ERR_CRYPTO_INVALID_DIGEST',
+    type: TypeError,
+    message: 'Invalid digest: not-a-digest'
+  });
+
+for (const key of [undefined, null, '']) {
+  common.expectsError(
+    () => crypto.sign('sha256', 'x', key),
+    {
+      code: 'ERR_CRYPTO_SIGN_KEY_REQUIRED',
+      type: Error
+    });
+}
+
+common.expectsError(
+  () => crypto.sign('sha256', 1, privateKey),
+  {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError,
+    message: 'The "data" argument must be one of type string, Buffer, ' +
+             'TypedArray, or DataView'
+  });
+
+common.expectsError(
+  () => crypto.verify('sha256', 'x', publicKey, 'signature'),
+  {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError,
+    message: 'The "signature" argument must be one of type Buffer, ' +
+             'TypedArray, or DataView'
+  });
+
+common.expectsError(
+  () => crypto.verifyBatch('sha256', publicKey, ['x'], []),
+  {
+    code: 'ERR_INVALID_ARRAY_LENGTH',
+    type: TypeError,
+    message: 'The array "signatures" (length 0) must be of length 1.'
+  });
+
+common.expectsError(
+  () => crypto.verifyBatch('sha256', publicKey, ['x', {}],
+                           [Buffer.alloc(1), Buffer.alloc(1)]),
+  {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError,
+    message: 'The "data[1]" argument must be one of type string, Buffer, ' +
+             'TypedArray, or DataView'
+  });
+
+common.expectsError(
+  () => crypto.sign('sha256', 'x', privateKey, 'not a function'),
+  {
+    code: 'ERR_INVALID_CALLBACK',
+    type: TypeError
+  });
+
+common.expectsError(
+  () => crypto.sign('sha256', 'x', { key: privateKey, padding: 'x' }),
+  {
+    code: 'ERR_INVALID_OPT_VALUE',
+    type: TypeError
+  });
+
+// The keys are parsed by OpenSSL, which reports the errors.
+assert.throws(() => crypto.createPrivateKey('not a key'), /^Error: error:/);
+assert.throws(() => crypto.createPublicKey('not a key'), /^Error: error:/);
+assert.throws(() => crypto.createPrivateKey(publicPem), /^Error: error:/);
+
+common.expectsError(
+  () => crypto.createPrivateKey({ key: privatePem, passphrase: 1 }),
+  {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError,
+    message: 'The "passphrase" argument must be of type string'
+  });
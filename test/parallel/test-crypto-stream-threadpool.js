@@ -0,0 +1,183 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Large chunks written to cipher and hash streams are processed on the
+// threadpool. The output has to be the same as with update(), and in order.
+
+const assert = require('assert');
+const crypto = require('crypto');
+
+const key = Buffer.alloc(32, 'k');
+const iv = Buffer.alloc(12, 'i');
+
+const chunks = [];
+for (const size of [100, 70000, 3, 1024 * 1024, 0, 65536, 65535, 200000]) {
+  const chunk = Buffer.alloc(size);
+  for (let i = 0; i < size; i++)
+    chunk[i] = (i * 31 + size) & 0xff;
+  chunks.push(chunk);
+}
+const plaintext = Buffer.concat(chunks);
+
+function collect(stream, callback) {
+  const out = [];
+  stream.on('data', (chunk) => out.push(chunk));
+  stream.on('end', common.mustCall(() => callback(Buffer.concat(out))));
+}
+
+function writeAll(stream) {
+  for (const chunk of chunks)
+    stream.write(chunk);
+  stream.end();
+}
+
+for (const threshold of [undefined, 0, 1024, Infinity]) {
+  const options = { threadpoolThreshold: threshold };
+
+  const hash = crypto.createHash('sha256', options);
+  collect(hash, (digest) => {
+    assert.deepStrictEqual(
+      digest, crypto.createHash('sha256').update(plaintext).digest());
+  });
+  writeAll(hash);
+
+  const cipher = crypto.createCipheriv('aes-256-gcm', key, iv, options);
+  collect(cipher, (ciphertext) => {
+    const expected = crypto.createCipheriv('aes-256-gcm', key, iv);
+    const encrypted = [expected.update(plaintext), expected.final()];
+    assert.deepStrictEqual(ciphertext, Buffer.concat(encrypted));
+    assert.deepStrictEqual(cipher.getAuthTag(), expected.getAuthTag());
+
+    const decipher = crypto.createDecipheriv('aes-256-gcm', key, iv, options);
+    decipher.setAuthTag(cipher.getAuthTag());
+    collect(decipher, (decrypted) => {
+      assert.deepStrictEqual(decrypted, plaintext);
+    });
+    decipher.write(ciphertext.slice(0, 100000));
+    decipher.end(ciphertext.slice(100000));
+  });
+  writeAll(cipher);
+}
+
+// Block ciphers hold back partial blocks across chunks.
+{
+  const cbcKey = Buffer.alloc(16, 'c');
+  const cbcIv = Buffer.alloc(16, 'v');
+  const cipher = crypto.createCipheriv('aes-128-cbc', cbcKey, cbcIv,
+                                       { threadpoolThreshold: 0 });
+  collect(cipher, (ciphertext) => {
+    const decipher = crypto.createDecipheriv('aes-128-cbc', cbcKey, cbcIv);
+    assert.deepStrictEqual(
+      Buffer.concat([decipher.update(ciphertext), decipher.final()]),
+      plaintext);
+  });
+  writeAll(cipher);
+}
+
+// Strings are processed synchronously, whatever their size.
+{
+  const hash = crypto.createHash('md5', { threadpoolThreshold: 0 });
+  hash.end('x'.repeat(100000), 'latin1');
+  assert.strictEqual(hash.read().toString('hex'),
+                     crypto.createHash('md5').update('x'.repeat(100000))
+                       .digest('hex'));
+}
+
+// The context cannot be used directly while a chunk is being processed.
+{
+  const cipher = crypto.createCipheriv('aes-256-gcm', key, iv,
+                                       { threadpoolThreshold: 16 });
+  cipher.write(Buffer.alloc(16));
+  for (const method of ['update', 'final', 'getAuthTag', 'setAutoPadding']) {
+    common.expectsError(
+      () => cipher[method](Buffer.alloc(1)),
+      {
+        code: 'ERR_CRYPTO_INVALID_STATE',
+        type: Error,
+        message: `Invalid state for operation ${method}`
+      });
+  }
+  common.expectsError(
+    () => cipher.setAAD(Buffer.alloc(1)),
+    {
+      code: 'ERR_CRYPTO_INVALID_STATE',
+      type: Error
+    });
+  cipher.resume();
+  cipher.end(common.mustCall());
+
+  const hash = crypto.createHash('sha1', { threadpoolThreshold: 16 });
+  hash.write(Buffer.alloc(16));
+  for (const method of ['update', 'digest']) {
+    common.expectsError(
+      () => hash[method]('x'),
+      {
+        code: 'ERR_CRYPTO_INVALID_STATE',
+        type: Error,
+        message: `Invalid state for operation ${method}`
+      });
+  }
+  hash.resume();
+  hash.end(common.mustCall());
+}
+
+// Without a threshold, everything is processed synchronously, so the results
+// of large writes are available right away.
+{
+  const big = Buffer.alloc(1024 * 1024, 'b');
+  const expectedDigest = crypto.createHash('sha256').update(big).digest();
+
+  const hash = crypto.createHash('sha256');
+  hash.write(big);
+  assert.deepStrictEqual(hash.digest(), expectedDigest);
+
+  const ended = crypto.createHash('sha256');
+  ended.end(big);
+  assert.deepStrictEqual(ended.read(), expectedDigest);
+
+  const expected = crypto.createCipheriv('aes-256-gcm', key, iv);
+  const ciphertext =
+    Buffer.concat([expected.update(big), expected.final()]);
+
+  const cipher = crypto.createCipheriv('aes-256-gcm', key, iv);
+  cipher.write(big);
+  const out = [cipher.read(), cipher.final()];
+  assert.deepStrictEqual(Buffer.concat(out), ciphertext);
+  assert.deepStrictEqual(cipher.getAuthTag(), expected.getAuthTag());
+
+  const decipher = crypto.createDecipheriv('aes-256-gcm', key, iv);
+  decipher.setAuthTag(expected.getAuthTag());
+  decipher.write(ciphertext);
+  assert.deepStrictEqual(
+    Buffer.concat([decipher.read(), decipher.final()]), big);
+}
+
+// Invalid thresholds.
+for (const create of [
+  (options) => crypto.createHash('sha256', options),
+  (options) => crypto.createCipheriv('aes-256-gcm', key, iv, options),
+  (options) => crypto.createDecipheriv('aes-256-gcm', key, iv, options)
+]) {
+  for (const threshold of ['1', null, true]) {
+    common.expectsError(
+      () => create({ threadpoolThreshold: threshold }),
+      {
+        code: 'ERR_INVALID_OPT_VALUE',
+        type: TypeError,
+        message: `The value "${threshold}" is invalid for option ` +
+                 '"threadpoolThreshold"'
+      });
+  }
+  for (const threshold of [-1, NaN]) {
+    common.expectsError(
+      () => create({ threadpoolThreshold: threshold }),
+      {
+        code: 'ERR_INVALID_OPT_VALUE',
+        type: RangeError,
+        message: `The value "${threshold}" is invalid for option ` +
+                 '"threadpoolThreshold"'
+      });
+  }
+}
@@ -0,0 +1,70 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fixtures = require('../common/fixtures');
+const fs = require('fs');
+
+// The batch binding runs a list of fs operations as a single (threadpool)
+// request and reports a result per operation instead of throwing.
+const binding = process.binding('fs');
+const { FSReqWrap, FS_BATCH_OPEN, FS_BATCH_STAT, FS_BATCH_FSTAT,
+        FS_BATCH_READ_ALL, FS_BATCH_CLOSE } = binding;
+const { UV_ENOENT, UV_EBADF } = process.binding('uv');
+const kResultFields = 15;
+
+const file = fixtures.path('a.js');
+const missing = fixtures.path('does-not-exist.js');
+const contents = fs.readFileSync(file);
+
+{
+  const ops = new Int32Array([
+    FS_BATCH_STAT, 0, 0, 0,
+    FS_BATCH_STAT, 1, 0, 0,
+    FS_BATCH_FSTAT, 0, 0, 0
+  ]);
+  const [results, data] = binding.batch(ops, [file, missing]);
+  assert.strictEqual(results.length, 3 * kResultFields);
+  assert.strictEqual(results[0], 0);
+  assert.strictEqual(results[1 + 8], fs.statSync(file).size);
+  assert.strictEqual(results[kResultFields], UV_ENOENT);
+  assert.strictEqual(results[2 * kResultFields], UV_EBADF);
+  assert.strictEqual(data.length, 0);
+}
+
+{
+  const ops = new Int32Array([
+    FS_BATCH_OPEN, 0, fs.constants.O_RDONLY, 0,
+    FS_BATCH_FSTAT, 0, 0, 0,
+    FS_BATCH_READ_ALL, 0, 0, 0,
+    FS_BATCH_CLOSE, 0, 0, 0
+  ]);
+  const req = new FSReqWrap();
+  req.oncomplete = common.mustCall((err, results, data) => {
+    assert.strictEqual(err, null);
+    assert.ok(results[0] >= 0);
+    assert.strictEqual(results[kResultFields], 0);
+    assert.strictEqual(results[2 * kResultFields], contents.length);
+    assert.strictEqual(results[2 * kResultFields + 1], 0);
+    assert.strictEqual(results[3 * kResultFields], 0);
+    assert.deepStrictEqual(data, contents);
+  });
+  binding.batch(ops, [file], req);
+}
+
+// Files are opened and closed one after the other.  Opening a second file
+// while the first one is still open would leak its descriptor.
+{
+  const ops = new Int32Array([
+    FS_BATCH_OPEN, 0, fs.constants.O_RDONLY, 0,
+    FS_BATCH_READ_ALL, 0, 0, 0,
+    FS_BATCH_CLOSE, 0, 0, 0,
+    FS_BATCH_OPEN, 0, fs.constants.O_RDONLY, 0,
+    FS_BATCH_READ_ALL, 0, 0, 0,
+    FS_BATCH_CLOSE, 0, 0, 0
+  ]);
+  const [results, data] = binding.batch(ops, [file]);
+  assert.ok(results[0] >= 0);
+  assert.ok(results[3 * kResultFields] >= 0);
+  assert.strictEqual(results[4 * kResultFields + 1], contents.length);
+  assert.deepStrictEqual(data, Buffer.concat([contents, contents]));
+}
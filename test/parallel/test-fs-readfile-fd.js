@@ -1,5 +1,5 @@
 'use strict';
-require('../common');
+const common = require('../common');
 
 // Test fs.readFile using a file descriptor.
 
@@ -30,6 +30,17 @@ tempFdSync(function(fd) {
   assert.strictEqual('', fs.readFileSync(fd, 'utf8'));
 });
 
+// File descriptors must fit into an int32.
+[2 ** 31, 2 ** 32 - 1].forEach((fd) => {
+  const err = {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError,
+    message: 'The "fd" argument must be of type integer'
+  };
+  common.expectsError(() => fs.readFile(fd, common.mustNotCall()), err);
+  common.expectsError(() => fs.readFileSync(fd), err);
+});
+
 function tempFd(callback) {
   fs.open(fn, 'r', function(err, fd) {
     assert.ifError(err);
@@ -0,0 +1,51 @@
+'use strict';
+const common = require('../common');
+
+// fs.readFile() and fs.readFileSync() decode UTF-8 off the main thread where
+// possible.  Make sure every path produces the same string as Buffer#toString.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+
+common.refreshTmpDir();
+
+const cases = {
+  ascii: Buffer.from('hello world\n'.repeat(1000)),
+  latin1: Buffer.from('café naïve ÿ\n'.repeat(1000)),
+  multibyte: Buffer.from('é中😀 '.repeat(1000)),
+  // Read in several steps.
+  large: Buffer.from('é中😀 '.repeat(200 * 1024)),
+  invalid: Buffer.from([0x61, 0xc3, 0x28, 0xed, 0xa0, 0x80, 0xf0, 0x9f, 0x62]),
+  empty: Buffer.alloc(0)
+};
+
+for (const name of Object.keys(cases)) {
+  const file = path.join(common.tmpDir, `${name}.txt`);
+  const expected = cases[name];
+  fs.writeFileSync(file, expected);
+
+  assert.strictEqual(fs.readFileSync(file, 'utf8'), expected.toString());
+  assert.strictEqual(fs.readFileSync(file, 'UTF-8'), expected.toString());
+  assert.strictEqual(fs.readFileSync(file, 'latin1'),
+                     expected.toString('latin1'));
+  assert.deepStrictEqual(fs.readFileSync(file), expected);
+
+  const fd = fs.openSync(file, 'r');
+  assert.strictEqual(fs.readFileSync(fd, 'utf8'), expected.toString());
+  fs.closeSync(fd);
+
+  fs.readFile(file, 'utf8', common.mustCall((err, data) => {
+    assert.ifError(err);
+    assert.strictEqual(data, expected.toString());
+  }));
+  fs.readFile(file, { encoding: 'hex' }, common.mustCall((err, data) => {
+    assert.ifError(err);
+    assert.strictEqual(data, expected.toString('hex'));
+  }));
+}
+
+common.expectsError(
+  () => fs.readFileSync(path.join(common.tmpDir, 'missing.txt'), 'utf8'),
+  { code: 'ENOENT' }
+);
@@ -0,0 +1,43 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+
+// The Date header value is formatted natively, once a second, and the same
+// string is handed out until the second is over.
+const { utcDate } = process.binding('http_serializer');
+
+function near(value) {
+  const date = Date.parse(value);
+  assert.strictEqual(new Date(date).toUTCString(), value);
+  assert.ok(Math.abs(Date.now() - date) < 5000, value);
+}
+
+const first = utcDate();
+near(first);
+const second = utcDate();
+assert.ok(first === second || Date.parse(second) > Date.parse(first));
+
+// Both the string and the template paths of the serializer send it.
+const template = http.createHeaderTemplate({ 'Content-Type': 'text/plain' });
+
+const server = http.createServer(common.mustCall((req, res) => {
+  if (req.url === '/template')
+    res.writeHead(200, template);
+  res.end('ok');
+}, 2));
+
+server.listen(0, common.mustCall(() => {
+  let pending = 2;
+  for (const path of ['/', '/template']) {
+    http.get({
+      port: server.address().port,
+      path
+    }, common.mustCall((res) => {
+      near(res.headers.date);
+      res.resume();
+      if (--pending === 0)
+        server.close();
+    }));
+  }
+}));
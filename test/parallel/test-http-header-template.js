@@ -0,0 +1,112 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+
+// Response headers from a template are validated and serialized once, and
+// combined with the headers that Node.js adds for every response.
+const template = http.createHeaderTemplate({
+  'Content-Type': 'text/plain',
+  'X-Template': 'yes'
+});
+assert.ok(Object.isFrozen(template));
+
+const closing = http.createHeaderTemplate([
+  ['Connection', 'close'],
+  ['Set-Cookie', 'a=1'],
+  ['Set-Cookie', 'b=2']
+]);
+
+common.expectsError(() => http.createHeaderTemplate('x'), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  type: TypeError
+});
+common.expectsError(() => http.createHeaderTemplate({ 'X-Bad': 'a\u0000' }), {
+  code: 'ERR_INVALID_CHAR',
+  type: TypeError
+});
+common.expectsError(() => http.createHeaderTemplate({ 'X Bad': 'a' }), {
+  code: 'ERR_INVALID_HTTP_TOKEN',
+  type: TypeError
+});
+
+const server = http.createServer(common.mustCall((req, res) => {
+  switch (req.url) {
+    case '/plain':
+      res.writeHead(200, template);
+      assert.ok(res.headersSent);
+      res.end('hello');
+      break;
+    case '/set-header':
+      res.setHeader('X-Extra', 'extra');
+      res.writeHead(201, 'Made', template);
+      res.write(Buffer.from('buffer '));
+      res.end('body');
+      break;
+    case '/close':
+      res.writeHead(200, closing);
+      res.end();
+      break;
+    case '/override':
+      res.setHeader('content-type', 'application/json');
+      res.setHeader('Set-Cookie', ['c=3', 'd=4']);
+      res.writeHead(200, template);
+      res.end('{}');
+      break;
+  }
+}, 4));
+
+const agent = new http.Agent({ keepAlive: true });
+
+function get(path, cb) {
+  http.get({ port: server.address().port, path, agent },
+           common.mustCall((res) => {
+             let body = '';
+             res.setEncoding('utf8');
+             res.on('data', (chunk) => body += chunk);
+             res.on('end', common.mustCall(() => cb(res, body)));
+           }));
+}
+
+server.listen(0, common.mustCall(() => {
+  get('/plain', (res, body) => {
+    assert.strictEqual(res.statusCode, 200);
+    assert.strictEqual(res.headers['content-type'], 'text/plain');
+    assert.strictEqual(res.headers['x-template'], 'yes');
+    assert.strictEqual(res.headers['transfer-encoding'], 'chunked');
+    assert.strictEqual(res.headers.connection, 'keep-alive');
+    assert.ok(res.headers.date);
+    assert.strictEqual(body, 'hello');
+
+    get('/set-header', (res, body) => {
+      assert.strictEqual(res.statusCode, 201);
+      assert.strictEqual(res.statusMessage, 'Made');
+      assert.strictEqual(res.headers['x-template'], 'yes');
+      assert.strictEqual(res.headers['x-extra'], 'extra');
+      assert.strictEqual(res.headers['transfer-encoding'], 'chunked');
+      assert.strictEqual(body, 'buffer body');
+
+      get('/close', (res, body) => {
+        assert.strictEqual(res.headers.connection, 'close');
+        assert.deepStrictEqual(res.headers['set-cookie'], ['a=1', 'b=2']);
+        assert.strictEqual(body, '');
+
+        // setHeader() replaces the template's header instead of sending
+        // both.
+        get('/override', (res, body) => {
+          const names = res.rawHeaders.filter((_, i) => i % 2 === 0)
+            .map((name) => name.toLowerCase());
+          assert.strictEqual(
+            names.filter((name) => name === 'content-type').length, 1);
+          assert.strictEqual(res.headers['content-type'], 'application/json');
+          assert.strictEqual(res.headers['x-template'], 'yes');
+          assert.deepStrictEqual(res.headers['set-cookie'], ['c=3', 'd=4']);
+          assert.strictEqual(res.headers['transfer-encoding'], 'chunked');
+          assert.strictEqual(body, '{}');
+          agent.destroy();
+          server.close();
+        });
+      });
+    });
+  });
+}));
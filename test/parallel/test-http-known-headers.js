@@ -0,0 +1,79 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+// The parser reports an index for header names it knows about, which
+// IncomingMessage uses instead of matching the name again.  Both paths have
+// to produce the same headers.
+const { knownHeaders } = process.binding('http_parser');
+assert.ok(knownHeaders.length > 0);
+for (const name of knownHeaders)
+  assert.strictEqual(name, name.toLowerCase());
+assert.ok(knownHeaders.includes('content-type'));
+assert.ok(knownHeaders.includes('set-cookie'));
+
+const extra = [];
+for (let i = 0; i < 40; i++)
+  extra.push(`X-Extra-${i}: ${i}`);
+
+const requests = [
+  [
+    'Host: localhost',
+    'CoNtEnT-TyPe: text/plain',
+    'Accept: a',
+    'accept: b',
+    'Cookie: x=1',
+    'Cookie: y=2',
+    'Set-Cookie: a=1',
+    'set-cookie: b=2',
+    'User-Agent: one',
+    'User-Agent: two',
+    'X-Custom: 1',
+    'x-custom: 2'
+  ],
+  // More headers than the parser hands over in one go.
+  ['Host: localhost', 'Content-Type: text/plain', ...extra, 'Accept: a']
+];
+
+function check(req, lines) {
+  const raw = [];
+  for (const line of lines) {
+    const [name, value] = line.split(': ');
+    raw.push(name, value);
+  }
+  assert.deepStrictEqual(req.rawHeaders, raw);
+
+  if (lines.length > 20) {
+    assert.strictEqual(req.headers['content-type'], 'text/plain');
+    assert.strictEqual(req.headers['x-extra-39'], '39');
+    assert.strictEqual(req.headers.accept, 'a');
+    return;
+  }
+  assert.deepStrictEqual(req.headers, {
+    'host': 'localhost',
+    'content-type': 'text/plain',
+    'accept': 'a, b',
+    'cookie': 'x=1; y=2',
+    'set-cookie': ['a=1', 'b=2'],
+    'user-agent': 'one',
+    'x-custom': '1, 2'
+  });
+}
+
+let index = 0;
+const server = http.createServer(common.mustCall((req, res) => {
+  check(req, requests[index++]);
+  res.end();
+}, requests.length));
+
+server.listen(0, common.mustCall(() => {
+  const socket = net.connect(server.address().port, common.mustCall(() => {
+    for (const lines of requests)
+      socket.write(`GET / HTTP/1.1\r\n${lines.join('\r\n')}\r\n\r\n`);
+    socket.end();
+  }));
+  socket.resume();
+  socket.on('end', common.mustCall(() => server.close()));
+}));
@@ -0,0 +1,84 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+
+// Header strings that span execute() calls are copied into storage that is
+// reused from one message to the next.  Feed pipelined requests to the
+// parser byte by byte and check that no string is mixed up with another.
+const { HTTPParser } = process.binding('http_parser');
+const kOnHeaders = HTTPParser.kOnHeaders | 0;
+const kOnHeadersComplete = HTTPParser.kOnHeadersComplete | 0;
+const kOnMessageComplete = HTTPParser.kOnMessageComplete | 0;
+const CRLF = '\r\n';
+
+function makeRequest(id, count) {
+  const headers = [];
+  for (let i = 0; i < count; i++)
+    headers.push(`X-Header-${id}-${i}`, `value ${id} ${i}`);
+  headers.push('Cookie', `${id}=${'c'.repeat(5000)}`);
+  const url = `/${id}/${'u'.repeat(100)}`;
+  let request = `GET ${url} HTTP/1.1${CRLF}`;
+  for (let i = 0; i < headers.length; i += 2)
+    request += `${headers[i]}: ${headers[i + 1]}${CRLF}`;
+  return { url, headers, raw: request + CRLF };
+}
+
+// Both fewer and more headers than the parser buffers before handing them
+// to JS.
+const requests = [
+  makeRequest('a', 4),
+  makeRequest('b', 40),
+  makeRequest('c', 4),
+  makeRequest('d', 40)
+];
+
+const parser = new HTTPParser(HTTPParser.REQUEST);
+let index = 0;
+let headers = [];
+let url = '';
+
+parser[kOnHeaders] = common.mustCall((h, u) => {
+  headers = headers.concat(h);
+  url += u;
+}, 4);
+
+parser[kOnHeadersComplete] = common.mustCall((versionMajor, versionMinor,
+                                              h, method, u) => {
+  const expected = requests[index++];
+  assert.deepStrictEqual(headers.concat(h || []), expected.headers);
+  assert.strictEqual(url + (u || ''), expected.url);
+  headers = [];
+  url = '';
+}, requests.length);
+
+parser[kOnMessageComplete] = common.mustCall(requests.length);
+
+const data = Buffer.from(requests.map((r) => r.raw).join(''));
+for (let i = 0; i < data.length; i++) {
+  // Each byte in its own buffer, which is overwritten after execute().
+  const chunk = Buffer.from([data[i]]);
+  assert.strictEqual(parser.execute(chunk, 0, 1), 1);
+  chunk.fill(0);
+}
+
+// A long header that arrives a byte at a time is grown in place rather than
+// copied into a new block for every byte, which would take quadratic time
+// and memory.
+{
+  const value = 'v'.repeat(64 * 1024);
+  const raw =
+    Buffer.from(`GET / HTTP/1.1${CRLF}X-Long: ${value}${CRLF}${CRLF}`);
+  const parser = new HTTPParser(HTTPParser.REQUEST);
+  parser[kOnHeadersComplete] = common.mustCall((versionMajor, versionMinor,
+                                                headers) => {
+    assert.deepStrictEqual(headers, ['X-Long', value]);
+  });
+  parser[kOnMessageComplete] = common.mustCall();
+
+  const rss = process.memoryUsage().rss;
+  for (let i = 0; i < raw.length; i++) {
+    const chunk = Buffer.from([raw[i]]);
+    assert.strictEqual(parser.execute(chunk, 0, 1), 1);
+  }
+  assert.ok(process.memoryUsage().rss - rss < 64 * 1024 * 1024);
+}
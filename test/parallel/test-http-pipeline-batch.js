@@ -0,0 +1,129 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+// Pipelined requests without a body are handed to JS in batches through
+// kOnMessages, other messages through the regular callbacks.  Either way
+// they have to arrive in order.
+const { HTTPParser } = process.binding('http_parser');
+const kOnHeaders = HTTPParser.kOnHeaders | 0;
+const kOnHeadersComplete = HTTPParser.kOnHeadersComplete | 0;
+const kOnBody = HTTPParser.kOnBody | 0;
+const kOnMessageComplete = HTTPParser.kOnMessageComplete | 0;
+const kOnMessages = HTTPParser.kOnMessages | 0;
+const kMaxBatchedMessages = HTTPParser.kMaxBatchedMessages | 0;
+
+function get(url) {
+  return `GET ${url} HTTP/1.1\r\nHost: localhost\r\n\r\n`;
+}
+
+function post(url, body) {
+  return `POST ${url} HTTP/1.1\r\nContent-Length: ${body.length}\r\n\r\n` +
+         body;
+}
+
+{
+  const count = kMaxBatchedMessages + 4;
+  let data = '';
+  for (let i = 0; i < count; i++)
+    data += get(`/${i}`);
+  data += post('/post', 'body') + get('/last');
+
+  const events = [];
+  const parser = new HTTPParser(HTTPParser.REQUEST);
+  parser[kOnHeaders] = common.mustNotCall();
+  parser[kOnHeadersComplete] = (major, minor, headers, method, url) => {
+    events.push(`headers ${url}`);
+  };
+  parser[kOnBody] = (b, start, len) => {
+    events.push(`body ${b.toString('latin1', start, start + len)}`);
+  };
+  parser[kOnMessageComplete] = () => events.push('complete');
+  parser[kOnMessages] = (messages) => {
+    assert.strictEqual(messages.length % 6, 0);
+    for (let i = 0; i < messages.length; i += 6) {
+      assert.deepStrictEqual(messages[i], ['Host', 'localhost']);
+      assert.strictEqual(messages[i + 2], 1);  // GET
+      assert.strictEqual(messages[i + 3], 1);
+      assert.strictEqual(messages[i + 4], 1);
+      assert.strictEqual(messages[i + 5], true);
+    }
+    const urls = [];
+    for (let i = 1; i < messages.length; i += 6)
+      urls.push(messages[i]);
+    events.push(`batch ${urls.join(' ')}`);
+  };
+
+  const buf = Buffer.from(data);
+  assert.strictEqual(parser.execute(buf, 0, buf.length), buf.length);
+
+  const first = [];
+  const second = [];
+  for (let i = 0; i < kMaxBatchedMessages; i++)
+    first.push(`/${i}`);
+  for (let i = kMaxBatchedMessages; i < count; i++)
+    second.push(`/${i}`);
+  assert.deepStrictEqual(events, [
+    `batch ${first.join(' ')}`,
+    `batch ${second.join(' ')}`,
+    'headers /post',
+    'body body',
+    'complete',
+    'batch /last'
+  ]);
+}
+
+{
+  // The same through the HTTP server, which also needs the right headers
+  // for every request.
+  const extra = [];
+  for (let i = 0; i < 40; i++)
+    extra.push(`X-Extra-${i}: ${i}\r\n`);
+
+  const expected = [];
+  let data = '';
+  for (let i = 0; i < 40; i++) {
+    expected.push(['GET', `/${i}`, `${i}`]);
+    data += `GET /${i} HTTP/1.1\r\nContent-Type: ${i}\r\n\r\n`;
+  }
+  expected.push(['POST', '/post', 'post']);
+  data += 'POST /post HTTP/1.1\r\nContent-Type: post\r\n' +
+          'Content-Length: 4\r\n\r\nbody';
+  expected.push(['GET', '/many', 'many']);
+  data += `GET /many HTTP/1.1\r\nContent-Type: many\r\n${extra.join('')}\r\n`;
+  expected.push(['GET', '/last', 'last']);
+  data += 'GET /last HTTP/1.1\r\nContent-Type: last\r\n' +
+          'Connection: close\r\n\r\n';
+
+  let index = 0;
+  const server = http.createServer(common.mustCall((req, res) => {
+    const [method, url, type] = expected[index++];
+    assert.strictEqual(req.method, method);
+    assert.strictEqual(req.url, url);
+    assert.strictEqual(req.headers['content-type'], type);
+    if (url === '/many')
+      assert.strictEqual(req.headers['x-extra-39'], '39');
+    let body = '';
+    req.setEncoding('latin1');
+    req.on('data', (chunk) => body += chunk);
+    req.on('end', common.mustCall(() => {
+      assert.strictEqual(body, method === 'POST' ? 'body' : '');
+      res.end(url);
+    }));
+  }, expected.length));
+
+  server.listen(0, common.mustCall(() => {
+    const socket = net.connect(server.address().port);
+    let response = '';
+    socket.setEncoding('latin1');
+    socket.on('data', (chunk) => response += chunk);
+    socket.on('end', common.mustCall(() => {
+      assert.strictEqual(response.split('HTTP/1.1 200 OK').length - 1,
+                         expected.length);
+      server.close();
+    }));
+    socket.end(data);
+  }));
+}
@@ -0,0 +1,65 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+
+// While the HTTP parser consumes the socket, request bodies are handed to
+// JS as views into the read buffers, which come from the parser's own slabs,
+// instead of copies.  Chunks must stay intact while later reads go into the
+// same slabs.
+const { slabAllocatorStats } = process.binding('stream_wrap');
+const kBytes = 3;
+
+const bodies = [0, 1, 2].map((i) => {
+  const body = Buffer.allocUnsafe(256 * 1024);
+  for (let j = 0; j < body.length; j++)
+    body[j] = (j * 7 + i) & 0xff;
+  return body;
+});
+
+const received = [];
+const server = http.createServer(common.mustCall((req, res) => {
+  const chunks = [];
+  req.on('data', (chunk) => chunks.push(chunk));
+  req.on('end', common.mustCall(() => {
+    received.push(chunks);
+    res.end();
+  }));
+}, bodies.length));
+
+server.listen(0, common.mustCall(() => {
+  const agent = new http.Agent({ keepAlive: true, maxSockets: 1 });
+  const bytesBefore = slabAllocatorStats[kBytes];
+  let pending = bodies.length;
+
+  for (const body of bodies) {
+    const req = http.request({
+      port: server.address().port,
+      method: 'POST',
+      agent
+    }, common.mustCall((res) => {
+      res.resume();
+      res.on('end', common.mustCall(() => {
+        if (--pending > 0)
+          return;
+        // Only compare once all bodies are in, after the slabs have been
+        // read into again.
+        for (let i = 0; i < bodies.length; i++) {
+          assert.deepStrictEqual(Buffer.concat(received[i]), bodies[i]);
+          // Chunks of consecutive reads share a slab instead of each being
+          // a copy of its read.
+          const slabs = new Set(received[i].map((chunk) => chunk.buffer));
+          assert.ok(slabs.size < received[i].length);
+        }
+        assert.ok(slabAllocatorStats[kBytes] - bytesBefore >=
+                  bodies.length * bodies[0].length);
+        agent.destroy();
+        server.close();
+      }));
+    }));
+    // Write the body in pieces so that it spans several reads.
+    for (let i = 0; i < body.length; i += 16 * 1024)
+      req.write(body.slice(i, i + 16 * 1024));
+    req.end();
+  }
+}));
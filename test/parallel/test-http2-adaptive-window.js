@@ -0,0 +1,58 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const h2 = require('http2');
+
+// With maxAdaptiveWindowSize set, the receiving side grows its flow control
+// windows while a large body is coming in, and the data still arrives intact.
+const body = Buffer.alloc(8 * 1024 * 1024);
+for (let i = 0; i < body.length; i++)
+  body[i] = i & 0xff;
+const maxAdaptiveWindowSize = 4 * 1024 * 1024;
+
+// Values outside of what a flow control window can be are rejected.
+for (const value of [0, 65534, 2 ** 31, -1, '70000']) {
+  const error = {
+    code: 'ERR_HTTP2_INVALID_SETTING_VALUE',
+    type: RangeError,
+    message: `Invalid value for setting "maxAdaptiveWindowSize": ${value}`
+  };
+  common.expectsError(
+    () => h2.createServer({ maxAdaptiveWindowSize: value }), error);
+  common.expectsError(
+    () => h2.connect('http://localhost:80',
+                     { maxAdaptiveWindowSize: value }), error);
+}
+
+const server = h2.createServer();
+server.on('stream', common.mustCall((stream) => {
+  stream.respond();
+  stream.end(body);
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = h2.connect(`http://localhost:${server.address().port}`,
+                            { maxAdaptiveWindowSize });
+  const req = client.request();
+  const chunks = [];
+  let largest = 0;
+  req.on('data', (chunk) => {
+    chunks.push(chunk);
+    largest = Math.max(largest, client.state.localWindowSize);
+  });
+  req.on('end', common.mustCall(() => {
+    assert.ok(Buffer.concat(chunks).equals(body));
+    assert.ok(largest > 65535, `window size ${largest}`);
+    assert.ok(largest <= maxAdaptiveWindowSize, `window size ${largest}`);
+
+    const { memoryUsage } = client.state;
+    assert.strictEqual(typeof memoryUsage, 'number');
+    assert.ok(memoryUsage > 0);
+
+    client.close();
+    server.close();
+  }));
+}));
@@ -0,0 +1,70 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const h2 = require('http2');
+const { PerformanceObserver } = require('perf_hooks');
+
+// Frames that are produced in the same tick are packed into shared blocks
+// and written to the socket together, while large DATA payloads are written
+// from the stream's own buffers. Both kinds have to arrive intact and in
+// order, with and without padding.
+const sizes = [0, 10, 1024, 1025, 8000];
+const count = sizes.length * 4;
+
+function body(size, i) {
+  return Buffer.alloc(size, String.fromCharCode(97 + i % 26));
+}
+
+let serverSessions = 0;
+const obs = new PerformanceObserver((items) => {
+  for (const entry of items.getEntries()) {
+    if (entry.name !== 'Http2Session' || entry.type !== 'server')
+      continue;
+    // All responses are started in the same tick, so they share writes.
+    assert.ok(entry.writeCount > 0);
+    assert.ok(entry.writeCount < count, `${entry.writeCount} writes`);
+    serverSessions++;
+  }
+});
+obs.observe({ entryTypes: ['http2'] });
+
+function test(options, callback) {
+  const server = h2.createServer(options);
+  server.on('stream', common.mustCall((stream, headers) => {
+    const i = +headers[':path'].slice(1);
+    stream.respond();
+    stream.end(body(sizes[i % sizes.length], i));
+  }, count));
+
+  server.listen(0, common.mustCall(() => {
+    const client = h2.connect(`http://localhost:${server.address().port}`,
+                              options);
+    let pending = count;
+    for (let i = 0; i < count; i++) {
+      const req = client.request({ ':path': `/${i}` });
+      const chunks = [];
+      req.on('data', (chunk) => chunks.push(chunk));
+      req.on('end', common.mustCall(() => {
+        assert.ok(Buffer.concat(chunks).equals(
+          body(sizes[i % sizes.length], i)));
+        if (--pending === 0) {
+          client.close();
+          server.close(callback);
+        }
+      }));
+      req.end();
+    }
+  }));
+}
+
+process.on('exit', () => {
+  assert.strictEqual(serverSessions, 2);
+});
+
+test({}, common.mustCall(() => {
+  test({ paddingStrategy: h2.constants.PADDING_STRATEGY_MAX },
+       common.mustCall());
+}));
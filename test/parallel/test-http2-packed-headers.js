@@ -0,0 +1,79 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const h2 = require('http2');
+
+// Header values that are not in the HPACK static table are delivered as
+// slices of one packed string. Static and packed values have to come out
+// the same way in both the header object and the raw headers.
+const long = 'x'.repeat(70);
+const request = [
+  ':method', 'GET',
+  ':path', '/packed?a=1',
+  ':scheme', 'http',
+  'accept-encoding', 'gzip, deflate',
+  'x-empty', '',
+  'x-custom', 'one',
+  'x-custom', 'two',
+  'cookie', 'a=1',
+  'cookie', 'b=2',
+  `x-${long}`, long,
+  'x-latin1', 'café',
+  'x-big', 'y'.repeat(20000)
+];
+
+const server = h2.createServer();
+server.on('stream', common.mustCall((stream, headers, flags, rawHeaders) => {
+  // Every value is a string again, and every sent pair is present.
+  const pairs = [];
+  for (let i = 0; i < rawHeaders.length; i += 2) {
+    assert.strictEqual(typeof rawHeaders[i + 1], 'string');
+    pairs.push(`${rawHeaders[i]}: ${rawHeaders[i + 1]}`);
+  }
+  for (let i = 0; i < request.length; i += 2)
+    assert.ok(pairs.includes(`${request[i]}: ${request[i + 1]}`), request[i]);
+
+  assert.strictEqual(headers[':path'], '/packed?a=1');
+  assert.strictEqual(headers[':method'], 'GET');
+  assert.strictEqual(headers['accept-encoding'], 'gzip, deflate');
+  assert.strictEqual(headers['x-empty'], '');
+  assert.strictEqual(headers['x-custom'], 'one, two');
+  assert.strictEqual(headers.cookie, 'a=1; b=2');
+  assert.strictEqual(headers[`x-${long}`], long);
+  assert.strictEqual(headers['x-latin1'], 'café');
+  assert.strictEqual(headers['x-big'], 'y'.repeat(20000));
+
+  stream.respond({
+    ':status': 201,
+    'set-cookie': ['c=3', 'd=4'],
+    'content-type': 'text/plain'
+  });
+  stream.end();
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = h2.connect(`http://localhost:${server.address().port}`);
+  const headers = {};
+  for (let i = 0; i < request.length; i += 2) {
+    const name = request[i];
+    if (headers[name] === undefined)
+      headers[name] = request[i + 1];
+    else
+      headers[name] = [].concat(headers[name], request[i + 1]);
+  }
+  const req = client.request(headers);
+  req.on('response', common.mustCall((headers) => {
+    assert.strictEqual(headers[':status'], 201);
+    assert.deepStrictEqual(headers['set-cookie'], ['c=3', 'd=4']);
+    assert.strictEqual(headers['content-type'], 'text/plain');
+  }));
+  req.resume();
+  req.on('end', common.mustCall(() => {
+    client.close();
+    server.close();
+  }));
+  req.end();
+}));
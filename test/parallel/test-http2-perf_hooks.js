@@ -19,6 +19,8 @@ const obs = new PerformanceObserver((items) => {
       assert.strictEqual(typeof entry.streamAverageDuration, 'number');
       assert.strictEqual(typeof entry.streamCount, 'number');
       assert.strictEqual(typeof entry.framesReceived, 'number');
+      assert.strictEqual(typeof entry.writeCount, 'number');
+      assert.ok(entry.writeCount > 0);
       switch (entry.type) {
         case 'server':
           assert.strictEqual(entry.streamCount, 1);
@@ -0,0 +1,62 @@
+'use strict';
+
+// respondWithFD() reads the file ahead asynchronously, in chunks that are
+// sent without copying them. Check that larger files arrive intact, also
+// when the peer's flow control window is smaller than a chunk and when only
+// a range of the file is sent.
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const http2 = require('http2');
+
+common.refreshTmpDir();
+const fname = path.join(common.tmpDir, 'respond-file-fd-large');
+const data = Buffer.alloc(1024 * 1024 + 123);
+for (let i = 0; i < data.length; i++)
+  data[i] = (i * 7 + (i >> 13)) & 0xff;
+fs.writeFileSync(fname, data);
+const fd = fs.openSync(fname, 'r');
+
+const ranges = [
+  [0, -1],
+  [7, data.length - 100],
+  [16384, 16384],
+  [data.length - 10, 5]
+];
+
+const server = http2.createServer();
+server.on('stream', common.mustCall((stream, headers) => {
+  const [offset, length] = ranges[+headers[':path'].slice(1)];
+  stream.respondWithFD(fd, {}, { offset, length });
+}, ranges.length * 2));
+server.on('close', common.mustCall(() => fs.closeSync(fd)));
+
+function run(settings, callback) {
+  const client = http2.connect(`http://localhost:${server.address().port}`,
+                               { settings });
+  let pending = ranges.length;
+  ranges.forEach(([offset, length], i) => {
+    const req = client.request({ ':path': `/${i}` });
+    const chunks = [];
+    req.on('data', (chunk) => chunks.push(chunk));
+    req.on('end', common.mustCall(() => {
+      const end = length < 0 ? data.length : offset + length;
+      assert.ok(Buffer.concat(chunks).equals(data.slice(offset, end)));
+      if (--pending === 0) {
+        client.close();
+        callback();
+      }
+    }));
+    req.end();
+  });
+}
+
+server.listen(0, common.mustCall(() => {
+  run({}, common.mustCall(() => {
+    run({ initialWindowSize: 1000 }, common.mustCall(() => server.close()));
+  }));
+}));
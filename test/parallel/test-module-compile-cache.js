@@ -0,0 +1,55 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { execFileSync, spawnSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const fixtures = require('../common/fixtures');
+
+// NODE_COMPILE_CACHE stores the code cache of CommonJS modules on disk and
+// feeds it back to V8 on the next run.
+
+common.refreshTmpDir();
+// Missing parent directories are created as well.
+const cacheDir = path.join(common.tmpDir, 'compile-cache', 'nested');
+const env = Object.assign({}, process.env, { NODE_COMPILE_CACHE: cacheDir });
+const code = `require(${JSON.stringify(fixtures.path('a.js'))});
+              console.log(JSON.stringify(
+                require('internal/compile_cache').stats));`;
+
+function run(...flags) {
+  const out = execFileSync(process.execPath,
+                           ['--expose-internals', ...flags, '-e', code],
+                           { env });
+  return JSON.parse(out);
+}
+
+const first = run();
+assert.strictEqual(first.hits, 0);
+assert.ok(first.misses > 0);
+assert.ok(fs.readdirSync(cacheDir).length > 0);
+
+const second = run();
+assert.strictEqual(second.misses, 0);
+assert.strictEqual(second.rejects, 0);
+assert.strictEqual(second.hits, first.misses);
+
+// A different set of V8 flags produces a different version tag, so none of
+// the entries are used.
+assert.strictEqual(run('--no-lazy').hits, 0);
+
+// A directory that cannot be created disables the cache with a warning.
+{
+  const file = path.join(common.tmpDir, 'not-a-directory');
+  fs.writeFileSync(file, '');
+  const badEnv = Object.assign({}, process.env, {
+    NODE_COMPILE_CACHE: path.join(file, 'cache')
+  });
+  const child = spawnSync(process.execPath,
+                          ['--expose-internals', '-e', code],
+                          { env: badEnv });
+  assert.strictEqual(child.status, 0);
+  assert.ok(/Warning: Cannot create the compile cache directory/
+    .test(child.stderr), child.stderr);
+  assert.strictEqual(JSON.parse(child.stdout).hits, 0);
+}
@@ -0,0 +1,56 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { execFileSync } = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const Module = require('module');
+
+if (process.argv[2] === 'child') {
+  // In a frozen module tree, failed lookups are remembered until the cache
+  // is invalidated.
+  const dir = path.join(common.tmpDir, 'frozen');
+  fs.mkdirSync(dir);
+  const file = path.join(dir, 'dep');
+  setImmediate(common.mustCall(() => {
+    assert.throws(() => require(file), /Cannot find module/);
+    fs.writeFileSync(`${file}.js`, 'module.exports = 42;');
+    setImmediate(common.mustCall(() => {
+      assert.throws(() => require(file), /Cannot find module/);
+      Module.invalidateResolutionCache(`${file}.js`);
+      assert.strictEqual(require(file), 42);
+    }));
+  }));
+
+  const pkg = path.join(dir, 'pkg');
+  fs.mkdirSync(pkg);
+  assert.throws(() => require(pkg), /Cannot find module/);
+  fs.writeFileSync(path.join(pkg, 'package.json'), '{"main":"main.js"}');
+  fs.writeFileSync(path.join(pkg, 'main.js'), 'module.exports = 1;');
+  assert.throws(() => require(pkg), /Cannot find module/);
+  Module.invalidateResolutionCache(pkg);
+  assert.strictEqual(require(pkg), 1);
+
+  Module.invalidateResolutionCache();
+  common.expectsError(
+    () => Module.invalidateResolutionCache(1),
+    { code: 'ERR_INVALID_ARG_TYPE', type: TypeError });
+  return;
+}
+
+common.refreshTmpDir();
+
+// Otherwise, they are only cached while a top-level require() is running,
+// which includes the execution of this file.
+const dir = path.join(common.tmpDir, 'live');
+fs.mkdirSync(dir);
+const file = path.join(dir, 'dep');
+assert.throws(() => require(file), /Cannot find module/);
+fs.writeFileSync(`${file}.js`, 'module.exports = 42;');
+setImmediate(common.mustCall(() => {
+  assert.strictEqual(require(file), 42);
+}));
+
+const env = Object.assign({}, process.env, { NODE_FROZEN_MODULE_TREE: '1' });
+execFileSync(process.execPath, [__filename, 'child'],
+             { env, stdio: 'inherit' });
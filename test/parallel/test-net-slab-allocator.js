@@ -0,0 +1,59 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+
+// Reads from plain sockets are carved out of slabs that belong to the socket
+// and handed to JS as views into them instead of one malloc() per read.  The
+// ArrayBuffer behind a chunk holds nothing but data of the same socket, and
+// chunks that are kept around stay intact while later reads go into the same
+// slab.
+const { slabAllocatorStats } = process.binding('stream_wrap');
+const kHits = 1;
+const kBytes = 3;
+
+const hitsBefore = slabAllocatorStats[kHits];
+const bytesBefore = slabAllocatorStats[kBytes];
+const length = 256 * 1024;
+const fills = ['a', 'b'];
+
+const server = net.createServer(common.mustCall((socket) => {
+  socket.once('data', common.mustCall((fill) => {
+    const payload = Buffer.alloc(length, fill.toString());
+    for (let i = 0; i < length; i += 4096)
+      socket.write(payload.slice(i, i + 4096));
+    socket.end();
+  }));
+}, fills.length));
+
+server.listen(0, common.mustCall(() => {
+  let pending = fills.length;
+  for (const fill of fills) {
+    const client = net.connect(server.address().port, () => client.write(fill));
+    const chunks = [];
+    client.on('data', (chunk) => {
+      assert.ok(chunk instanceof Buffer);
+      chunks.push(chunk);
+    });
+    client.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(Buffer.concat(chunks),
+                             Buffer.alloc(length, fill));
+
+      // The rest of each slab is either this socket's data or zeroes.
+      const other = fills.find((f) => f !== fill).charCodeAt(0);
+      for (const chunk of chunks)
+        assert.ok(!new Uint8Array(chunk.buffer).includes(other));
+
+      // Consecutive reads share a slab rather than being copied.
+      const slabs = new Set(chunks.map((chunk) => chunk.buffer));
+      assert.ok(slabs.size < chunks.length);
+
+      if (--pending === 0) {
+        assert.ok(slabAllocatorStats[kHits] > hitsBefore);
+        assert.ok(slabAllocatorStats[kBytes] - bytesBefore >=
+                  length * fills.length);
+        server.close();
+      }
+    }));
+  }
+}));
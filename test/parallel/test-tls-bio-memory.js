@@ -0,0 +1,48 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const fixtures = require('../common/fixtures');
+const tls = require('tls');
+
+// NodeBIO buffers are recycled between connections, and a connection that
+// has nothing buffered gives its buffers back.
+
+const payload = Buffer.alloc(256 * 1024, 'x');
+const options = {
+  key: fixtures.readKey('agent1-key.pem'),
+  cert: fixtures.readKey('agent1-cert.pem')
+};
+
+const server = tls.createServer(options, common.mustCall((socket) => {
+  socket.write(payload);
+  socket.on('end', common.mustCall(() => socket.end()));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = tls.connect({
+    port: server.address().port,
+    rejectUnauthorized: false
+  });
+  let received = 0;
+  client.on('data', (chunk) => {
+    received += chunk.length;
+    if (received < payload.length)
+      return;
+    assert.strictEqual(received, payload.length);
+
+    setImmediate(common.mustCall(() => {
+      assert.strictEqual(client._handle.getBIOMemoryUsage(), 0);
+
+      const usage = tls.getBufferMemoryUsage();
+      assert.deepStrictEqual(Object.keys(usage), ['allocated', 'pooled']);
+      assert.ok(Number.isInteger(usage.allocated) && usage.allocated >= 0);
+      assert.ok(usage.pooled > 0);
+
+      client.end();
+      client.on('close', common.mustCall(() => server.close()));
+    }));
+  });
+}));
@@ -0,0 +1,55 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const fixtures = require('../common/fixtures');
+const tls = require('tls');
+
+// Plaintext is decrypted straight into buffers carved out of the
+// connection's slabs rather than copied from a scratch buffer, so the chunks
+// of consecutive records share a slab.  The slabs hold nothing but the
+// plaintext of their own connection, and chunks that are kept around stay
+// intact while later records are decrypted into the same slab.
+const length = 256 * 1024;
+const fills = ['a', 'b'];
+const options = {
+  key: fixtures.readKey('agent1-key.pem'),
+  cert: fixtures.readKey('agent1-cert.pem')
+};
+
+const server = tls.createServer(options, common.mustCall((socket) => {
+  socket.once('data', common.mustCall((fill) => {
+    socket.end(Buffer.alloc(length, fill.toString()));
+  }));
+}, fills.length));
+
+server.listen(0, common.mustCall(() => {
+  let pending = fills.length;
+  for (const fill of fills) {
+    const client = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false
+    }, () => client.write(fill));
+    const chunks = [];
+    client.on('data', (chunk) => {
+      assert.ok(chunk instanceof Buffer);
+      chunks.push(chunk);
+    });
+    client.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(Buffer.concat(chunks),
+                             Buffer.alloc(length, fill));
+
+      const slabs = new Set(chunks.map((chunk) => chunk.buffer));
+      assert.ok(slabs.size < chunks.length);
+
+      const other = fills.find((f) => f !== fill).charCodeAt(0);
+      for (const slab of slabs)
+        assert.ok(!new Uint8Array(slab).includes(other));
+
+      if (--pending === 0)
+        server.close();
+    }));
+  }
+}));
@@ -0,0 +1,83 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+// Closed streams hand their zlib context to a per-Environment pool, from
+// which streams with the same parameters pick it up after a reset.
+const { contextPoolStats } = process.binding('zlib');
+const kIdle = 0;
+const kHits = 1;
+
+const input = Buffer.from('hello pooled zlib world '.repeat(100));
+
+assert.strictEqual(zlib.setContextPoolSize(4), 8);
+
+{
+  const first = zlib.deflateSync(input);
+  const hits = contextPoolStats[kHits];
+  // A reused context has to produce exactly the same output.
+  for (let i = 0; i < 3; i++)
+    assert.deepStrictEqual(zlib.deflateSync(input), first);
+  assert.strictEqual(contextPoolStats[kHits] - hits, 3);
+}
+
+{
+  // Decompression contexts are reused as well, including gunzip contexts
+  // that have been reset for multi-member input.
+  const gzipped = zlib.gzipSync(input);
+  const twice = Buffer.concat([gzipped, gzipped]);
+  for (let i = 0; i < 3; i++) {
+    assert.deepStrictEqual(zlib.gunzipSync(gzipped), input);
+    assert.deepStrictEqual(zlib.gunzipSync(twice),
+                           Buffer.concat([input, input]));
+    assert.deepStrictEqual(zlib.unzipSync(gzipped), input);
+  }
+}
+
+{
+  // Different parameters never share a context.
+  const fast = zlib.deflateSync(input, { level: 1 });
+  const best = zlib.deflateSync(input, { level: 9 });
+  assert.deepStrictEqual(zlib.inflateSync(fast), input);
+  assert.deepStrictEqual(zlib.inflateSync(best), input);
+  assert.deepStrictEqual(zlib.deflateSync(input, { level: 1 }), fast);
+}
+
+{
+  // Dictionaries are applied again after a reset.
+  const dictionary = Buffer.from('hello pooled zlib world');
+  const deflated = zlib.deflateSync(input, { dictionary });
+  assert.deepStrictEqual(zlib.deflateSync(input, { dictionary }), deflated);
+  assert.deepStrictEqual(zlib.inflateSync(deflated, { dictionary }), input);
+  assert.throws(() => zlib.inflateSync(deflated), /Missing dictionary/);
+}
+
+zlib.gzip(input, common.mustCall((err, gzipped) => {
+  assert.ifError(err);
+  zlib.gunzip(gzipped, common.mustCall((err, result) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(result, input);
+
+    assert.ok(contextPoolStats[kIdle] <= 4);
+    assert.strictEqual(zlib.setContextPoolSize(0), 4);
+    assert.strictEqual(contextPoolStats[kIdle], 0);
+    const hits = contextPoolStats[kHits];
+    zlib.deflateSync(input);
+    zlib.deflateSync(input);
+    assert.strictEqual(contextPoolStats[kHits], hits);
+    assert.strictEqual(contextPoolStats[kIdle], 0);
+  }));
+}));
+
+common.expectsError(() => zlib.setContextPoolSize('1'), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  type: TypeError
+});
+
+[-1, 1.5, NaN, 2 ** 32].forEach((size) => {
+  common.expectsError(() => zlib.setContextPoolSize(size), {
+    code: 'ERR_OUT_OF_RANGE',
+    type: RangeError
+  });
+});
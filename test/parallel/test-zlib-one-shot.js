@@ -0,0 +1,104 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+// The convenience methods compress and decompress with a single native call
+// into a single output allocation unless the engine is asked for with the
+// `info` option, which goes through a stream.  Both need to agree.
+const inputs = [
+  Buffer.alloc(0),
+  Buffer.from('hello one-shot world'),
+  // Highly compressible, so decompression has to grow its output.
+  Buffer.alloc(1024 * 1024, 'abc'),
+  Buffer.from(Array.from({ length: 64 * 1024 }, (_, i) => (i * 7919) & 0xff))
+];
+
+const methods = [
+  ['deflate', 'inflate'],
+  ['deflateRaw', 'inflateRaw'],
+  ['gzip', 'gunzip'],
+  ['gzip', 'unzip'],
+  ['deflate', 'unzip']
+];
+
+for (const input of inputs) {
+  for (const [compress, decompress] of methods) {
+    for (const opts of [{}, { level: 1, memLevel: 9, windowBits: 10 }]) {
+      const compressed = zlib[`${compress}Sync`](input, opts);
+      assert.strictEqual(compressed.buffer.byteLength, compressed.length);
+      assert.deepStrictEqual(
+        compressed,
+        zlib[`${compress}Sync`](input, Object.assign({ info: true }, opts))
+          .buffer);
+
+      const decompressed = zlib[`${decompress}Sync`](compressed, opts);
+      assert.strictEqual(decompressed.buffer.byteLength, decompressed.length);
+      assert.deepStrictEqual(decompressed, input);
+
+      zlib[compress](input, opts, common.mustCall((err, result) => {
+        assert.ifError(err);
+        assert.deepStrictEqual(result, compressed);
+        zlib[decompress](result, opts, common.mustCall((err, result) => {
+          assert.ifError(err);
+          assert.deepStrictEqual(result, input);
+        }));
+      }));
+    }
+  }
+}
+
+{
+  const dictionary = Buffer.from('hello world');
+  const input = Buffer.from('hello world, hello one-shot world');
+  for (const [compress, decompress] of [['deflate', 'inflate'],
+                                        ['deflateRaw', 'inflateRaw']]) {
+    const compressed = zlib[`${compress}Sync`](input, { dictionary });
+    assert.deepStrictEqual(
+      zlib[`${decompress}Sync`](compressed, { dictionary }), input);
+    zlib[decompress](compressed, { dictionary }, common.mustCall((err, res) => {
+      assert.ifError(err);
+      assert.deepStrictEqual(res, input);
+    }));
+  }
+
+  const compressed = zlib.deflateSync(input, { dictionary });
+  common.expectsError(() => zlib.inflateSync(compressed), {
+    code: 'Z_NEED_DICT',
+    type: Error,
+    message: 'Missing dictionary'
+  });
+  zlib.inflate(compressed, common.mustCall((err, result) => {
+    common.expectsError({
+      code: 'Z_NEED_DICT',
+      type: Error,
+      message: 'Missing dictionary'
+    })(err);
+    assert.strictEqual(result, undefined);
+  }));
+}
+
+// Option validation is shared with the streams.
+common.expectsError(() => zlib.deflateSync('abc', { level: 42 }), {
+  code: 'ERR_INVALID_OPT_VALUE',
+  type: RangeError
+});
+common.expectsError(() => zlib.gzip('abc', { windowBits: 0 }, () => {}), {
+  code: 'ERR_INVALID_OPT_VALUE',
+  type: RangeError
+});
+
+// Decompression starts from a small output estimate and keeps growing it,
+// however far the data expands.
+{
+  const input = Buffer.alloc(16 * 1024 * 1024, 'a');
+  for (const [compress, decompress] of methods) {
+    const compressed = zlib[`${compress}Sync`](input);
+    assert.ok(input.length / compressed.length > 4);
+    assert.deepStrictEqual(zlib[`${decompress}Sync`](compressed), input);
+    zlib[decompress](compressed, common.mustCall((err, result) => {
+      assert.ifError(err);
+      assert.deepStrictEqual(result, input);
+    }));
+  }
+}
@@ -0,0 +1,136 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+// createGzip({ parallel }) compresses blocks concurrently on the threadpool
+// and stitches them into a single gzip member.
+
+function random(length) {
+  const buf = Buffer.allocUnsafe(length);
+  for (let i = 0; i < length; i++)
+    buf[i] = Math.random() * 16 | 0;
+  return buf;
+}
+
+function gzip(input, options, chunkSize) {
+  const gz = zlib.createGzip(options);
+  const chunks = [];
+  gz.on('data', (chunk) => chunks.push(chunk));
+  gz.on('end', common.mustCall(() => {
+    const output = Buffer.concat(chunks);
+    assert.deepStrictEqual(zlib.gunzipSync(output), input);
+    assert.strictEqual(gz.bytesRead, input.length);
+  }));
+  for (let offset = 0; offset < input.length; offset += chunkSize)
+    gz.write(input.slice(offset, offset + chunkSize));
+  gz.end();
+}
+
+// Repetitive data, so that back-references across block boundaries, which
+// rely on the dictionary, actually occur.
+const text = Buffer.from('All work and no play makes Jack a dull boy. '
+  .repeat(30000));
+const mixed = Buffer.concat([random(300 * 1024), text, random(1000)]);
+
+gzip(text, { parallel: 4 }, 64 * 1024);
+gzip(mixed, { parallel: 2, level: 9 }, 1000 * 1000);
+gzip(mixed, { parallel: 3, strategy: zlib.constants.Z_HUFFMAN_ONLY }, 333);
+gzip(Buffer.alloc(0), { parallel: 2 }, 1);
+gzip(Buffer.from('short'), { parallel: 8 }, 1);
+
+assert.ok(zlib.createGzip({ parallel: 1 }) instanceof zlib.Gzip);
+assert.ok(!(zlib.createGzip({ parallel: 2 }) instanceof zlib.Gzip));
+
+for (const parallel of [0, -1, 1.5, '2', Infinity]) {
+  common.expectsError(() => zlib.createGzip({ parallel }), {
+    code: 'ERR_INVALID_OPT_VALUE',
+    type: RangeError
+  });
+}
+
+// The caller may reuse a chunk as soon as its write callback has been called,
+// even though the blocks are compressed later on.
+{
+  const gz = zlib.createGzip({ parallel: 2 });
+  const chunks = [];
+  gz.on('data', (chunk) => chunks.push(chunk));
+  gz.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(zlib.gunzipSync(Buffer.concat(chunks)), text);
+  }));
+  const buffer = Buffer.allocUnsafe(100 * 1000);
+  let offset = 0;
+  (function write() {
+    if (offset >= text.length)
+      return gz.end();
+    const length = text.copy(buffer, 0, offset);
+    offset += length;
+    gz.write(buffer.slice(0, length), () => {
+      buffer.fill(0);
+      write();
+    });
+  })();
+}
+
+// Calls |hook| instead of the binding for the blocks of |gz|.
+function hookDeflateBlock(gz, hook) {
+  const binding = process.binding('zlib');
+  const deflateBlock = binding.deflateBlock;
+  binding.deflateBlock = function(input, dictionary, level, memLevel,
+                                  strategy, last, req) {
+    if (req.stream !== gz)
+      return deflateBlock.apply(this, arguments);
+    return hook(deflateBlock, arguments, req);
+  };
+}
+
+// A large chunk is not compressed in more than `parallel` blocks at a time.
+{
+  const gz = zlib.createGzip({ parallel: 3 });
+  let inFlight = 0;
+  let maxInFlight = 0;
+  hookDeflateBlock(gz, (deflateBlock, args, req) => {
+    const oncomplete = req.oncomplete;
+    req.oncomplete = function() {
+      inFlight--;
+      return oncomplete.apply(this, arguments);
+    };
+    maxInFlight = Math.max(maxInFlight, ++inFlight);
+    return deflateBlock.apply(null, args);
+  });
+
+  const chunks = [];
+  gz.on('data', (chunk) => chunks.push(chunk));
+  gz.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(zlib.gunzipSync(Buffer.concat(chunks)), mixed);
+    assert.strictEqual(maxInFlight, 3);
+  }));
+  gz.end(mixed);
+}
+
+// A block that fails to compress fails the write or end() waiting for it.
+function failBlocks(gz) {
+  hookDeflateBlock(gz, (deflateBlock, args, req) => {
+    process.nextTick(() => req.oncomplete(zlib.constants.Z_MEM_ERROR));
+  });
+}
+
+{
+  const gz = zlib.createGzip({ parallel: 2 });
+  failBlocks(gz);
+  gz.on('error', common.mustCall((err) => {
+    assert.strictEqual(err.code, 'Z_MEM_ERROR');
+  }));
+  gz.write(mixed, common.mustCall((err) => {
+    assert.strictEqual(err.code, 'Z_MEM_ERROR');
+  }));
+}
+
+{
+  const gz = zlib.createGzip({ parallel: 2 });
+  failBlocks(gz);
+  gz.on('error', common.mustCall((err) => {
+    assert.strictEqual(err.code, 'Z_MEM_ERROR');
+  }));
+  gz.end(Buffer.from('short'));
+}
@@ -97,8 +97,9 @@ if (common.hasCrypto) { // eslint-disable-line crypto-check
 if (common.hasCrypto) { // eslint-disable-line crypto-check
   const crypto = require('crypto');
 
-  // The handle for PBKDF2 and RandomBytes isn't returned by the function call,
-  // so need to check it from the callback.
+  // The handles for PBKDF2, RandomBytes, HashBatch, the stream updates and
+  // the one-shot signatures aren't returned by the function call, so need to
+  // check them from the callback.
 
   const mc = common.mustCall(function pb() {
     testInitialized(this, 'PBKDF2');
@@ -108,6 +109,31 @@ if (common.hasCrypto) { // eslint-disable-line crypto-check
   crypto.randomBytes(1, common.mustCall(function rb() {
     testInitialized(this, 'RandomBytes');
   }));
+
+  crypto.hashBatch('sha256', ['a'], common.mustCall(function hb() {
+    testInitialized(this, 'HashBatch');
+  }));
+
+  const cipher = crypto.createCipheriv('aes-128-cbc', Buffer.alloc(16),
+                                       Buffer.alloc(16));
+  cipher._handle.updateAsync(Buffer.alloc(16), common.mustCall(function cu() {
+    testInitialized(this, 'CipherUpdate');
+  }));
+
+  const hash = crypto.createHash('sha256');
+  hash._handle.updateAsync(Buffer.alloc(16), common.mustCall(function hu() {
+    testInitialized(this, 'HashUpdate');
+  }));
+
+  const privateKey = crypto.createPrivateKey(
+    fixtures.readKey('rsa_private_1024.pem'));
+  crypto.sign('sha256', 'a', privateKey, common.mustCall(function si(err, s) {
+    testInitialized(this, 'SignRequest');
+    crypto.verifyBatch('sha256', privateKey, ['a'], [s],
+                       common.mustCall(function ve() {
+                         testInitialized(this, 'VerifyRequest');
+                       }));
+  }));
 }
 
 
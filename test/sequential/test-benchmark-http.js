@@ -15,8 +15,10 @@ runBenchmark('http',
              [
                'benchmarker=test-double',
                'c=1',
+               'chunk=256',
                'chunkedEnc=true',
                'chunks=0',
+               'cookie=0',
                'dur=0.1',
                'key=""',
                'len=1',